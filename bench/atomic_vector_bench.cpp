@@ -0,0 +1,51 @@
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "hornetlib/data/utxo/atomic_vector.h"
+
+namespace {
+
+using hornet::data::utxo::AtomicVector;
+
+constexpr int kElements = 16;
+constexpr int kWriteInterval = 4'096;  // Reader iterations between publishes on thread 0.
+
+// Baseline: the previous snapshot mechanism, an atomic load of a shared_ptr.
+void BM_SharedPtrSnapshot(benchmark::State& state) {
+  using Container = std::vector<std::shared_ptr<const int>>;
+  static std::shared_ptr<const Container> ptr;
+  if (state.thread_index() == 0) {
+    auto init = std::make_shared<Container>();
+    for (int i = 0; i < kElements; ++i) init->push_back(std::make_shared<const int>(i));
+    std::atomic_store(&ptr, std::shared_ptr<const Container>(std::move(init)));
+  }
+  int64_t iteration = 0;
+  for (auto _ : state) {
+    const auto snapshot = std::atomic_load_explicit(&ptr, std::memory_order_acquire);
+    benchmark::DoNotOptimize(snapshot->back());
+    if (state.thread_index() == 0 && ++iteration % kWriteInterval == 0)
+      std::atomic_store(&ptr, std::shared_ptr<const Container>(std::make_shared<Container>(*snapshot)));
+  }
+}
+BENCHMARK(BM_SharedPtrSnapshot)->ThreadRange(1, 32)->UseRealTime();
+
+// Epoch-protected snapshots of an AtomicVector under the same read/write mix.
+void BM_AtomicVectorSnapshot(benchmark::State& state) {
+  static AtomicVector<int> vec;
+  if (state.thread_index() == 0 && vec.Empty())
+    for (int i = 0; i < kElements; ++i) vec.EmplaceBack(i);
+  int64_t iteration = 0;
+  for (auto _ : state) {
+    const auto snapshot = vec.Snapshot();
+    benchmark::DoNotOptimize(snapshot->back());
+    if (state.thread_index() == 0 && ++iteration % kWriteInterval == 0)
+      vec.Edit()->push_back(snapshot->front());
+  }
+  if (state.thread_index() == 0) vec.EraseBack(vec.Size() - kElements);
+}
+BENCHMARK(BM_AtomicVectorSnapshot)->ThreadRange(1, 32)->UseRealTime();
+
+}  // namespace
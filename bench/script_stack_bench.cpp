@@ -0,0 +1,106 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "hornetlib/crypto/hash.h"
+#include "hornetlib/protocol/script/lang/op.h"
+#include "hornetlib/protocol/script/processor.h"
+#include "hornetlib/protocol/script/verify.h"
+#include "hornetlib/protocol/script/writer.h"
+#include "hornetlib/protocol/transaction.h"
+
+// Counts heap allocations made by the whole benchmark binary.
+namespace {
+std::atomic<int64_t> allocation_count = 0;
+}  // namespace
+
+void* operator new(std::size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+namespace {
+
+using namespace hornet;
+using namespace hornet::protocol;
+using namespace hornet::protocol::script;
+
+// Accepts every signature, so that only the cost of the interpreter is measured.
+class AcceptingChecker : public runtime::SignatureChecker {
+ public:
+  bool CheckEcdsa(const runtime::Environment&, lang::Bytes, lang::Bytes, lang::Bytes) const override {
+    return true;
+  }
+  bool CheckSchnorr(const runtime::Environment&, lang::Bytes, lang::Bytes,
+                    std::optional<lang::Bytes>) const override {
+    return true;
+  }
+};
+
+// A P2PKH spend: a 72-byte signature and a 33-byte public key.
+struct Spend {
+  Spend() {
+    const std::vector<uint8_t> signature(72, 0x30), public_key(33, 0x02);
+    sig_script = Writer{}.PushData(signature).PushData(public_key).Release();
+    pubkey_script = Writer{}
+                        .Then(lang::Op::Duplicate)
+                        .Then(lang::Op::Hash160)
+                        .PushData(crypto::Hash160(public_key))
+                        .Then(lang::Op::EqualVerify)
+                        .Then(lang::Op::CheckSig)
+                        .Release();
+    tx.ResizeInputs(1);
+    tx.SetSignatureScript(0, sig_script);
+  }
+
+  std::vector<uint8_t> sig_script;
+  std::vector<uint8_t> pubkey_script;
+  Transaction tx;
+};
+
+void ReportAllocations(benchmark::State& state, int64_t allocations) {
+  state.counters["allocs_per_input"] = double(allocations) / state.iterations();
+}
+
+// Runs the signature script of a P2PKH spend in a fresh Processor per input.
+void BM_ProcessorPerInput(benchmark::State& state) {
+  const Spend spend;
+  const int64_t before = allocation_count.load();
+  for (auto _ : state) {
+    Processor processor{spend.sig_script, false};
+    benchmark::DoNotOptimize(processor.Run());
+  }
+  ReportAllocations(state, allocation_count.load() - before);
+}
+BENCHMARK(BM_ProcessorPerInput);
+
+// Verifies a P2PKH spend through the interpreter, with P2SH and segwit rules active.
+void BM_VerifyScriptPerInput(benchmark::State& state) {
+  const Spend spend;
+  const AcceptingChecker checker;
+  runtime::Environment env;
+  env.checker = &checker;
+  const WitnessView witness{spend.tx, 0};
+  const int64_t before = allocation_count.load();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        VerifyScript(spend.sig_script, spend.pubkey_script, witness, kVerifyP2SH | kVerifyWitness, env));
+  ReportAllocations(state, allocation_count.load() - before);
+}
+BENCHMARK(BM_VerifyScriptPerInput);
+
+}  // namespace
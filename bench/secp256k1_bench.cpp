@@ -0,0 +1,52 @@
+#include <array>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "hornetlib/crypto/secp256k1/ecdsa.h"
+#include "hornetlib/crypto/secp256k1/schnorr.h"
+#include "hornetlib/util/hex.h"
+
+namespace {
+
+using namespace hornet;
+using namespace hornet::crypto::secp256k1;
+
+constexpr auto kEcdsaPublicKey =
+    "022EDB326D11431A69E1CFE4437B3F0ACC0F383B0AE8C0FE9A749DE07A442EA49F"_bytes;
+constexpr auto kEcdsaDigest = "6E340B9CFFB37A989CA544E6BB780A2C78901D3FB33738768511A30617AFA01D"_bytes;
+constexpr auto kEcdsaSignature =
+    "3045022100E4896BBB94A5DF1E333636F72792945F2847DCA1E679AB5987126D4F0D94FC56"
+    "022023A3E4496E333B19CAF879CFA886E9D6F3F653948ED29DB747A6F53439F1AD07"_bytes;
+
+// BIP340 test vector 0.
+constexpr auto kSchnorrPublicKey = "F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9"_bytes;
+constexpr auto kSchnorrMessage = "0000000000000000000000000000000000000000000000000000000000000000"_bytes;
+constexpr auto kSchnorrSignature =
+    "E907831F80848D1069A5371B402410364BDF1C5F8307B0084C55F1CE2DCA8215"
+    "25F66A4A85EA8B71E482A74F382D2CE5EBEEE8FDB2172F477DF4900D310536C0"_bytes;
+
+void BM_EcdsaVerify(benchmark::State& state) {
+  for (auto _ : state)
+    benchmark::DoNotOptimize(VerifyEcdsa(kEcdsaPublicKey, kEcdsaDigest, kEcdsaSignature));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EcdsaVerify);
+
+void BM_SchnorrVerify(benchmark::State& state) {
+  for (auto _ : state)
+    benchmark::DoNotOptimize(VerifySchnorr(kSchnorrPublicKey, kSchnorrMessage, kSchnorrSignature));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SchnorrVerify);
+
+// Batch verification of a block's worth of key-path signatures; items are signatures.
+void BM_SchnorrBatchVerify(benchmark::State& state) {
+  SchnorrBatch batch;
+  for (int i = 0; i < state.range(0); ++i) batch.Add(kSchnorrPublicKey, kSchnorrMessage, kSchnorrSignature);
+  for (auto _ : state) benchmark::DoNotOptimize(batch.Verify());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SchnorrBatchVerify)->RangeMultiplier(4)->Range(4, 1024)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,37 @@
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "hornetlib/crypto/sha256_batch.h"
+
+namespace {
+
+using namespace hornet::crypto;
+
+constexpr int kMessages = 4096;
+
+// Hashes a layer of 64-byte Merkle node pairs in place with the given kernel.
+void BM_DoubleHash64(benchmark::State& state) {
+  const auto kernel = static_cast<SHA256::BatchKernel>(state.range(0));
+  if (!SHA256::IsSupported(kernel)) {
+    state.SkipWithError("Kernel not supported by this CPU.");
+    return;
+  }
+  std::vector<uint8_t> buffer(kMessages * 64);
+  for (size_t i = 0; i < buffer.size(); ++i) buffer[i] = uint8_t(i);
+  for (auto _ : state) {
+    SHA256::DoubleHash64(buffer.data(), 64, kMessages, buffer.data(), 32, kernel);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kMessages);
+  state.SetBytesProcessed(state.iterations() * kMessages * 64);
+}
+BENCHMARK(BM_DoubleHash64)
+    ->ArgName("kernel")
+    ->Arg(int(SHA256::BatchKernel::Scalar))
+    ->Arg(int(SHA256::BatchKernel::Sse41))
+    ->Arg(int(SHA256::BatchKernel::Avx2))
+    ->Arg(int(SHA256::BatchKernel::Avx512));
+
+}  // namespace
@@ -0,0 +1,34 @@
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "hornetlib/crypto/sha256.h"
+
+namespace {
+
+using namespace hornet::crypto;
+
+// Hashes a message of state.range(1) bytes with the kernel given by state.range(0).
+void BM_Sha256(benchmark::State& state) {
+  const auto kernel = static_cast<SHA256::Kernel>(state.range(0));
+  if (!SHA256::IsSupported(kernel)) {
+    state.SkipWithError("Kernel not supported by this CPU.");
+    return;
+  }
+  std::vector<uint8_t> message(state.range(1));
+  for (size_t i = 0; i < message.size(); ++i) message[i] = uint8_t(i);
+  SHA256::Context context{kernel};
+  for (auto _ : state) {
+    context.Init();
+    benchmark::DoNotOptimize(context.Update(message).Final());
+  }
+  state.SetBytesProcessed(state.iterations() * message.size());
+}
+// Block header, and typical transaction and message sizes.
+BENCHMARK(BM_Sha256)
+    ->ArgNames({"kernel", "bytes"})
+    ->ArgsProduct({{int(SHA256::Kernel::Scalar), int(SHA256::Kernel::ShaNi), int(SHA256::Kernel::ArmV8)},
+                   {80, 250, 4096}});
+
+}  // namespace
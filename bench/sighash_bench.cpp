@@ -0,0 +1,71 @@
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "hornetlib/protocol/script/sighash.h"
+#include "hornetlib/protocol/transaction.h"
+
+namespace {
+
+using namespace hornet;
+using namespace hornet::protocol;
+using namespace hornet::protocol::script;
+
+constexpr int kInputs = 2000;
+
+// A synthetic transaction spending kInputs Taproot outputs into two outputs.
+struct Fixture {
+  Fixture() {
+    tx.SetVersion(2);
+    tx.ResizeInputs(kInputs);
+    tx.ResizeOutputs(2);
+    tx.ResizeWitnesses(kInputs);
+    for (int i = 0; i < kInputs; ++i) {
+      tx.Input(i).previous_output.hash.fill(static_cast<uint8_t>(i));
+      tx.Input(i).previous_output.index = i;
+      tx.Input(i).sequence = 0xfffffffd;
+      tx.ResizeComponents(i, 1);
+      tx.SetWitnessScript(i, 0, std::vector<uint8_t>(64, 0x5A));
+    }
+    pk_script.assign(34, 0xAA);
+    pk_script[0] = 0x51;
+    pk_script[1] = 0x20;
+    for (int i = 0; i < 2; ++i) {
+      tx.Output(i).value = 1000 * (i + 1);
+      tx.SetPkScript(i, pk_script);
+    }
+    spent.assign(kInputs, {10'000, pk_script});
+  }
+
+  Transaction tx;
+  std::vector<uint8_t> pk_script;
+  std::vector<SpentOutput> spent;
+};
+
+// Computes the sighash of every input from data precomputed once for the transaction.
+void BM_TaprootSighashPrecomputed(benchmark::State& state) {
+  const Fixture fixture;
+  for (auto _ : state) {
+    const PrecomputedTransactionData precomputed{fixture.tx, fixture.spent};
+    for (int i = 0; i < kInputs; ++i)
+      benchmark::DoNotOptimize(TaprootSighash(fixture.tx, precomputed, i, fixture.spent[i], sighash::kDefault));
+  }
+  state.SetItemsProcessed(state.iterations() * kInputs);
+}
+BENCHMARK(BM_TaprootSighashPrecomputed)->Unit(benchmark::kMillisecond);
+
+// The quadratic baseline, which rehashes the shared transaction data for every input.
+void BM_TaprootSighashPerInput(benchmark::State& state) {
+  const Fixture fixture;
+  for (auto _ : state) {
+    for (int i = 0; i < kInputs; ++i) {
+      const PrecomputedTransactionData precomputed{fixture.tx, fixture.spent};
+      benchmark::DoNotOptimize(TaprootSighash(fixture.tx, precomputed, i, fixture.spent[i], sighash::kDefault));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kInputs);
+}
+BENCHMARK(BM_TaprootSighashPerInput)->Unit(benchmark::kMillisecond);
+
+}  // namespace
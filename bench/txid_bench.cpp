@@ -0,0 +1,67 @@
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "hornetlib/protocol/block.h"
+#include "hornetlib/protocol/transaction.h"
+
+namespace {
+
+using namespace hornet;
+using namespace hornet::protocol;
+
+constexpr int kTransactions = 2000;
+
+// A block of two-input, two-output segwit transactions.
+Block MakeBlock() {
+  Block block;
+  for (int i = 0; i < kTransactions; ++i) {
+    Transaction tx;
+    tx.SetVersion(2);
+    tx.ResizeInputs(2);
+    tx.ResizeOutputs(2);
+    tx.ResizeWitnesses(2);
+    for (int j = 0; j < 2; ++j) {
+      tx.Input(j).previous_output = {Hash{uint8_t(i), uint8_t(j)}, uint32_t(j)};
+      tx.Input(j).sequence = 0xfffffffd;
+      tx.Output(j).value = 1000 * (i + j);
+      tx.SetPkScript(j, std::vector<uint8_t>(22, 0x14));
+      tx.ResizeComponents(j, 2);
+      tx.SetWitnessScript(j, 0, std::vector<uint8_t>(72, 0x30));
+      tx.SetWitnessScript(j, 1, std::vector<uint8_t>(33, 0x02));
+    }
+    block.AddTransaction(tx);
+  }
+  return block;
+}
+
+// Computes each txid and wtxid on demand, one transaction at a time.
+void BM_LazyTxids(benchmark::State& state) {
+  const Block original = MakeBlock();
+  for (auto _ : state) {
+    state.PauseTiming();
+    Block block = original;
+    state.ResumeTiming();
+    for (const auto tx : std::as_const(block).Transactions()) {
+      benchmark::DoNotOptimize(tx.GetHash());
+      benchmark::DoNotOptimize(tx.GetWitnessHash());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kTransactions);
+}
+BENCHMARK(BM_LazyTxids);
+
+// Computes every txid and wtxid in one block-level pass.
+void BM_ComputeHashes(benchmark::State& state) {
+  Block block = MakeBlock();
+  for (auto _ : state) {
+    block.ComputeHashes();
+    benchmark::DoNotOptimize(std::as_const(block).Transaction(0).GetHash());
+  }
+  state.SetItemsProcessed(state.iterations() * kTransactions);
+}
+BENCHMARK(BM_ComputeHashes);
+
+}  // namespace
@@ -35,7 +35,9 @@ class HeaderAncestryView {
   // May return fewer than `count` items if not all exist.
   virtual std::vector<uint32_t> LastNTimestamps(int count) const = 0;
 
-  uint32_t MedianTimePast() const {
+  // Returns the median of the last kBlocksForMedianTime ancestor timestamps. Implementations that
+  // track the timestamps incrementally may override this to avoid walking the ancestors.
+  virtual uint32_t MedianTimePast() const {
     auto timestamps = LastNTimestamps(constants::kBlocksForMedianTime);
     Assert(!timestamps.empty());  // Impossible: would imply trying to validate the genesis.
     std::sort(timestamps.begin(), timestamps.end());
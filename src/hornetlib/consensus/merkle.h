@@ -11,6 +11,7 @@
 #include "hornetlib/protocol/hash.h"
 #include "hornetlib/protocol/transaction.h"
 #include "hornetlib/protocol/txid.h"
+#include "hornetlib/util/parallel_chunks.h"
 #include "hornetlib/util/throw.h"
 
 namespace hornet::consensus {
@@ -55,12 +56,16 @@ class MerkleReducer {
   std::vector<protocol::Hash> nodes_;
 };
 
-// Computes the Merkle root of a set of leaves, given a function to obtain each leaf by index.
+// Computes the Merkle root of a set of leaves, given a function to obtain each leaf by index. Large
+// sets are computed across threads, so leaf_func must be safe to call concurrently for distinct leaves.
 template <typename Func>
 inline MerkleRoot ComputeMerkleRoot(int count, Func leaf_func) {
+  constexpr int kMinChunk = 512;  // Leaves per chunk, amortizing the dispatch cost.
   MerkleReducer builder(count);
-  for (int i = 0; i < count; ++i)
-    builder[i] = leaf_func(i);
+  util::ParallelChunks(count, kMinChunk, [&](int, int begin, int end) {
+    for (int i = begin; i < end; ++i)
+      builder[i] = leaf_func(i);
+  });
   return builder.Compute();
 }
 
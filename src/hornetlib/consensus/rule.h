@@ -1,11 +1,14 @@
 #pragma once
 
+#include <atomic>
 #include <iterator>
 #include <optional>
+#include <vector>
 
 #include "hornetlib/consensus/bips.h"
 #include "hornetlib/consensus/types.h"
 #include "hornetlib/util/assert.h"
+#include "hornetlib/util/parallel_chunks.h"
 
 namespace hornet::consensus {
 
@@ -47,4 +50,27 @@ Result ValidateRules(const std::array<Rule, N>& ruleset, int height, Args&&... a
   return rv;
 }
 
+// Validates items [0, count) with fn(index), splitting large counts across threads. As with a serial
+// AndThen chain, the result is that of the lowest-indexed failing item. Items above a known failure
+// are skipped, so fn must be free of side effects.
+template <typename Fn>
+Result ValidateEach(int count, Fn&& fn, int min_chunk = 256,
+                    int max_chunks = util::GetHardwareConcurrency()) {
+  std::vector<Result> results(util::GetChunkCount(count, min_chunk, max_chunks));
+  std::atomic<int> first_failure = count;
+  util::ParallelChunks(count, min_chunk, [&](int chunk, int begin, int end) {
+    for (int i = begin; i < end && i < first_failure; ++i) {
+      if (Result result = fn(i); !result) {
+        results[chunk] = result;
+        for (int known = first_failure; i < known && !first_failure.compare_exchange_weak(known, i);) {}
+        return;
+      }
+    }
+  }, max_chunks);
+  // Chunks are ordered, and each stops at its own first failure.
+  for (const Result& result : results)
+    if (!result) return result;
+  return {};
+}
+
 }  // namespace hornet::consensus
@@ -6,6 +6,7 @@
 #include "hornetlib/consensus/utxo.h"
 #include "hornetlib/protocol/block.h"
 #include "hornetlib/protocol/block_header.h"
+#include "hornetlib/protocol/hash.h"
 
 namespace hornet::consensus::rules {
 
@@ -25,6 +26,13 @@ struct HeaderValidationContext {
   const int height;
 };
 
+// The context for header rules that need no ancestry, given the hashes computed ahead of time.
+struct HeaderStructureContext {
+  const protocol::BlockHeader& header;
+  const protocol::Hash& hash;         // The hash of the header.
+  const protocol::Hash& parent_hash;  // The hash of the header's parent.
+};
+
 inline HeaderValidationContext MakeHeaderContext(const BlockValidationContext& rhs) {
   return {rhs.block.Header(), rhs.parent, rhs.view, rhs.current_time, rhs.view.Length()};
 }
@@ -29,6 +29,31 @@ namespace hornet::consensus::rules {
   return ValidateRules(ruleset, 0, context);
 }
 
+// Performs the header rules that need no ancestry, aligned with Core's CheckBlockHeader. Together
+// with ValidateHeaderContextual, this is equivalent to ValidateHeader.
+[[nodiscard]] inline Result ValidateHeaderStructure(const HeaderStructureContext& context) {
+  // clang-format off
+  static const std::array ruleset = {
+    Rule{ValidateLinkedHash},       // A header MUST reference the hash of its valid parent.
+    Rule{ValidateHashProofOfWork}   // A header MUST satisfy the chain's target proof-of-work.
+  };
+  // clang-format on
+  return ValidateRules(ruleset, 0, context);
+}
+
+// Performs the header rules that depend on ancestry, aligned with Core's ContextualCheckBlockHeader.
+[[nodiscard]] inline Result ValidateHeaderContextual(const HeaderValidationContext& context) {
+  // clang-format off
+  static const auto ruleset = std::make_tuple(
+    Rule{ValidateDifficultyAdjustment}, // A header's proof-of-work target MUST satisfy the difficulty adjustment formula.
+    Rule{ValidateMedianTimePast},       // A header timestamp MUST be strictly greater than the median of its 11 ancestors' timestamps.
+    Rule{ValidateTimestampCurrent},     // A header timestamp MUST be less than or equal to network-adjusted time plus 2 hours.
+    Rule{ValidateVersion}               // A header version number MUST meet deployment requirements depending on activated BIPs.
+  );
+  // clang-format on
+  return ValidateRules(ruleset, 0, context);
+}
+
 // Performs transaction validation, aligned with Core's CheckTransaction function.
 [[nodiscard]] inline Result ValidateTransaction(const protocol::TransactionConstView transaction) {
   // clang-format off
@@ -9,6 +9,7 @@
 #include <numeric>
 #include <ranges>
 #include <span>
+#include <vector>
 
 #include "hornetlib/consensus/merkle.h"
 #include "hornetlib/consensus/rule.h"
@@ -21,6 +22,7 @@
 #include "hornetlib/protocol/transaction.h"
 #include "hornetlib/util/iterator_range.h"
 #include "hornetlib/util/log.h"
+#include "hornetlib/util/parallel_chunks.h"
 
 namespace hornet::consensus::rules {
 
@@ -89,18 +91,21 @@ inline int GetLegacySigOpCount(const protocol::TransactionConstView& tx) {
 
 // All transactions in a block MUST be valid according to transaction-level consensus rules.
 [[nodiscard]] inline Result ValidateTransactions(const protocol::Block& block) {
-  for (const auto& tx : block.Transactions()) {
-    if (const auto result = ValidateTransaction(tx); !result)
-      return result;
-  }
-  return {};
+  return ValidateEach(block.GetTransactionCount(), [&](int i) {
+    return ValidateTransaction(block.Transaction(i));
+  });
 }
 
 // The total number of signature operations in a block MUST NOT exceed the consensus maximum.
 [[nodiscard]] inline Result ValidateSignatureOps(const protocol::Block& block) {
-  /* mutable */ int sig_ops = 0;
-  for (const auto& tx : block.Transactions())
-    sig_ops += detail::GetLegacySigOpCount(tx);
+  constexpr int kMinChunk = 256;
+  const int count = block.GetTransactionCount();
+  std::vector<int> partials(util::GetChunkCount(count, kMinChunk));
+  util::ParallelChunks(count, kMinChunk, [&](int chunk, int begin, int end) {
+    for (int i = begin; i < end; ++i)
+      partials[chunk] += detail::GetLegacySigOpCount(block.Transaction(i));
+  });
+  const int sig_ops = std::accumulate(partials.begin(), partials.end(), 0);
   if (sig_ops > 20'000) return Error::Structure_BadSigOpCount;
   return {};
 }
@@ -29,6 +29,11 @@ namespace hornet::consensus::rules {
     });
 }
 
+// Confirms that the block's inputs spend existing unspent outputs, without validating the spends.
+[[nodiscard]] inline Result ValidatePrevoutsUnspent(const BlockSpendingContext& context) {
+  return context.unspent.QueryPrevoutsUnspent(context.block);
+}
+
 [[nodiscard]] inline Result ValidateBlock(const protocol::Block& block,
                                         const protocol::BlockHeader& parent,
                                         const HeaderAncestryView& view,
@@ -45,4 +50,23 @@ namespace hornet::consensus::rules {
   return ValidateRules(ruleset, view.Length(), context);
 }
 
+// Performs all block validation except that of its spends and their scripts, for a block assumed
+// valid. The block's inputs must still spend unspent outputs, but only the query is needed, not the
+// spent outputs themselves, so the unspent view need not fetch them.
+[[nodiscard]] inline Result ValidateBlockAssumedValid(const protocol::Block& block,
+                                                      const protocol::BlockHeader& parent,
+                                                      const HeaderAncestryView& view,
+                                                      const int64_t current_time,
+                                                      const UnspentOutputsView& unspent) {
+  // clang-format off
+  static const auto ruleset = std::make_tuple(
+    Rule{ValidateHeader,          MakeHeaderContext},
+    Rule{ValidateNonSpending,     MakeEnvironmentContext},
+    Rule{ValidatePrevoutsUnspent, MakeBlockSpendingContext}
+  );
+  //clang-format on
+  const BlockValidationContext context{block, parent, view, current_time, unspent};
+  return ValidateRules(ruleset, view.Length(), context);
+}
+
 }  // namespace hornet::consensus::rules
@@ -28,23 +28,40 @@ inline bool IsVersionValidAtHeight(int32_t version, int height) {
   const int index = std::max(0, version);
   return !IsBIPEnabledAtHeight(kVersionExpiryToBIP[index], height);
 }
+
+inline Result CheckPreviousHash(const protocol::BlockHeader& header,
+                                const protocol::Hash& parent_hash) {
+  if (parent_hash != header.GetPreviousBlockHash()) return Error::Header_ParentNotFound;
+  return {};
+}
+
+inline Result CheckProofOfWork(const protocol::BlockHeader& header, const protocol::Hash& hash) {
+  const auto target = header.GetCompactTarget().Expand();
+  if (!(hash <= target)) return Error::Header_InvalidProofOfWork;
+  return {};
+}
 }  // namespace detail
 
 // A header MUST reference the hash of its valid parent.
 [[nodiscard]] inline Result ValidatePreviousHash(
     const HeaderValidationContext& context) {
-  if (context.parent.ComputeHash() != context.header.GetPreviousBlockHash())
-    return Error::Header_ParentNotFound;
-  return {};
+  return detail::CheckPreviousHash(context.header, context.parent.ComputeHash());
+}
+
+// A header MUST reference the hash of its parent, as computed ahead of time.
+[[nodiscard]] inline Result ValidateLinkedHash(const HeaderStructureContext& context) {
+  return detail::CheckPreviousHash(context.header, context.parent_hash);
 }
 
 // A header's 256-bit hash value MUST NOT exceed the header's proof-of-work target.
 [[nodiscard]] inline Result ValidateProofOfWork(
     const HeaderValidationContext& context) {
-  const auto hash = context.header.ComputeHash();
-  const auto target = context.header.GetCompactTarget().Expand();
-  if (!(hash <= target)) return Error::Header_InvalidProofOfWork;
-  return {};
+  return detail::CheckProofOfWork(context.header, context.header.ComputeHash());
+}
+
+// A header's 256-bit hash value, as computed ahead of time, MUST NOT exceed its target.
+[[nodiscard]] inline Result ValidateHashProofOfWork(const HeaderStructureContext& context) {
+  return detail::CheckProofOfWork(context.header, context.hash);
 }
 
 // A header's proof-of-work target MUST satisfy the difficulty adjustment formula.
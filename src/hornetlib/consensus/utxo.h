@@ -7,6 +7,7 @@
 
 #include "hornetlib/consensus/types.h"
 #include "hornetlib/protocol/block.h"
+#include "hornetlib/protocol/script/sighash.h"
 #include "hornetlib/protocol/transaction.h"
 
 namespace hornet::consensus {
@@ -18,6 +19,8 @@ struct SpendRecord {
   std::span<const uint8_t> pubkey_script;
   protocol::TransactionConstView tx;
   int spend_input_index;
+  // The sighash data shared by all of tx's inputs, built on first use, if available.
+  const protocol::script::LazyPrecomputedTransactionData* precomputed = nullptr;
 };
 
 // This class represents an abstract view onto the whole set of unspent outputs.
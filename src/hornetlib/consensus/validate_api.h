@@ -7,6 +7,7 @@
 #include "hornetlib/consensus/types.h"
 #include "hornetlib/protocol/block.h"
 #include "hornetlib/protocol/block_header.h"
+#include "hornetlib/protocol/hash.h"
 
 namespace hornet::consensus {
 
@@ -23,6 +24,22 @@ using rules::ValidateTransaction;
       rules::HeaderValidationContext{header, parent, view, current_time, view.Length()});
 }
 
+// Validates the header rules that need no ancestry, given the hashes of the header and its parent.
+[[nodiscard]] inline Result ValidateHeaderStructure(const protocol::BlockHeader& header,
+                                                    const protocol::Hash& hash,
+                                                    const protocol::Hash& parent_hash) {
+  return rules::ValidateHeaderStructure(rules::HeaderStructureContext{header, hash, parent_hash});
+}
+
+// Validates the header rules that depend on ancestry, for a header that passed ValidateHeaderStructure.
+[[nodiscard]] inline Result ValidateHeaderContextual(const protocol::BlockHeader& header,
+                                                     const protocol::BlockHeader& parent,
+                                                     const HeaderAncestryView& view,
+                                                     const int64_t current_time) {
+  return rules::ValidateHeaderContextual(
+      rules::HeaderValidationContext{header, parent, view, current_time, view.Length()});
+}
+
 [[nodiscard]] inline Result ValidateContextual(const protocol::Block& block,
                                                const HeaderAncestryView& view) {
   return rules::ValidateContextual(rules::BlockEnvironmentContext{block, view, view.Length()});
@@ -46,4 +63,12 @@ using rules::ValidateTransaction;
   return rules::ValidateBlock(block, parent, view, current_time, unspent);
 }
 
+[[nodiscard]] inline Result ValidateBlockAssumedValid(const protocol::Block& block,
+                                                      const protocol::BlockHeader& parent,
+                                                      const HeaderAncestryView& view,
+                                                      const int64_t current_time,
+                                                      const UnspentOutputsView& unspent) {
+  return rules::ValidateBlockAssumedValid(block, parent, view, current_time, unspent);
+}
+
 }  // namespace hornet::consensus
@@ -10,13 +10,18 @@
 #include <iomanip>
 #include <ostream>
 #include <span>
+#include <string_view>
+#include <vector>
 
+#include "hornetlib/crypto/ripemd160.h"
 #include "hornetlib/crypto/sha256.h"
+#include "hornetlib/crypto/sha256_batch.h"
 #include "hornetlib/util/as_span.h"
 #include "hornetlib/util/throw.h"
 
 namespace hornet::crypto {
 
+using bytes20_t = std::array<uint8_t, 20>;
 using bytes32_t = std::array<uint8_t, 32>;
 
 template <typename T>
@@ -61,14 +66,15 @@ inline bytes32_t DoubleSha256(const T &value) {
   return Sha256(Sha256(value));
 }
 
-// Computes a batch of same-sized double-SHA256 hashes using vectorization.
+// Computes a batch of same-sized double-SHA256 hashes, using vectorization for 64-byte inputs.
 inline void DoubleSha256Batch(const uint8_t* input,
                               int buffer_length_bytes,
                               int input_stride_bytes,
                               const int buffer_count,
                               uint8_t* output,
                               int output_stride_bytes = 32) {
-  // TODO: Replace this scalar implementation with a vectorized one.
+  if (buffer_length_bytes == 64)
+    return SHA256::DoubleHash64(input, input_stride_bytes, buffer_count, output, output_stride_bytes);
   for (int i = 0; i < buffer_count; ++i) {
     const uint8_t* buffer = input + i * input_stride_bytes;
     *reinterpret_cast<bytes32_t*>(output + i * output_stride_bytes) = DoubleSha256(buffer, buffer + buffer_length_bytes);
@@ -93,6 +99,17 @@ bytes32_t DoubleSha256(const Args&... args) {
   return DoubleSha256(buffer.data(), dst);
 }
 
+// Returns SHA256(SHA256(tag) || SHA256(tag) || data), the tagged hash defined in BIP340.
+inline bytes32_t TaggedHash(std::string_view tag, std::span<const uint8_t> data) {
+  const bytes32_t tag_hash = Sha256(tag);
+  return SHA256::Context{}.Update(tag_hash).Update(tag_hash).Update(data).Final();
+}
+
+// Returns RIPEMD160(SHA256(data)), the hash committed to by P2PKH and P2WPKH outputs.
+inline bytes20_t Hash160(std::span<const uint8_t> data) {
+  return RIPEMD160::Hash(Sha256(data));
+}
+
 // Writes the uint256_t as a 64-character hex string to an output stream,
 // using big-endian byte order (as typically displayed in Bitcoin).
 // Note: this is a textual representation, not binary output.
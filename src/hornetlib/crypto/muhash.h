@@ -0,0 +1,211 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+// MuHash3072: a rolling multiset hash in the multiplicative group of integers modulo the prime
+// 2^3072 - 1103717. Elements are mapped into the group with SHA-256 and a ChaCha20 keystream, as in
+// Bitcoin Core, so that digests of the same multiset agree.
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#include "hornetlib/crypto/hash.h"
+#include "hornetlib/crypto/sha256.h"
+
+namespace hornet::crypto {
+
+// An integer modulo 2^3072 - 1103717, stored as little-endian 64-bit limbs. Between operations the
+// value may be any representative below 2^3072; it is fully reduced only on serialization.
+class Num3072 {
+ public:
+  static constexpr int kLimbs = 48;
+  static constexpr int kBytes = kLimbs * 8;
+  static constexpr uint64_t kPrimeDiff = 1103717;  // 2^3072 minus the prime.
+
+  Num3072() { SetToOne(); }
+  explicit Num3072(std::span<const uint8_t, kBytes> bytes);
+
+  void SetToOne();
+  void Multiply(const Num3072& rhs);
+  void Divide(const Num3072& rhs) { Multiply(rhs.GetInverse()); }
+  Num3072 GetInverse() const;
+
+  // Returns the fully reduced value as 384 little-endian bytes.
+  std::array<uint8_t, kBytes> ToBytes() const;
+
+ private:
+  bool IsOverflow() const;
+  void FullReduce();
+
+  std::array<uint64_t, kLimbs> limbs_;
+};
+
+inline Num3072::Num3072(std::span<const uint8_t, kBytes> bytes) {
+  for (int i = 0; i < kLimbs; ++i) {
+    uint64_t limb = 0;
+    for (int b = 7; b >= 0; --b) limb = (limb << 8) | bytes[8 * i + b];
+    limbs_[i] = limb;
+  }
+}
+
+inline void Num3072::SetToOne() {
+  limbs_.fill(0);
+  limbs_[0] = 1;
+}
+
+inline void Num3072::Multiply(const Num3072& rhs) {
+  using uint128_t = unsigned __int128;
+  std::array<uint64_t, 2 * kLimbs> product = {};
+  for (int i = 0; i < kLimbs; ++i) {
+    uint128_t carry = 0;
+    for (int j = 0; j < kLimbs; ++j) {
+      carry += uint128_t{limbs_[i]} * rhs.limbs_[j] + product[i + j];
+      product[i + j] = static_cast<uint64_t>(carry);
+      carry >>= 64;
+    }
+    product[i + kLimbs] = static_cast<uint64_t>(carry);
+  }
+
+  // Folds the high half down, since 2^3072 is congruent to kPrimeDiff.
+  uint128_t carry = 0;
+  for (int i = 0; i < kLimbs; ++i) {
+    carry += uint128_t{product[kLimbs + i]} * kPrimeDiff + product[i];
+    limbs_[i] = static_cast<uint64_t>(carry);
+    carry >>= 64;
+  }
+  while (carry != 0) {
+    uint128_t add = carry * kPrimeDiff;
+    for (int i = 0; i < kLimbs && add != 0; ++i) {
+      add += limbs_[i];
+      limbs_[i] = static_cast<uint64_t>(add);
+      add >>= 64;
+    }
+    carry = add;
+  }
+}
+
+// Computes the inverse by Fermat's little theorem, raising to the power p - 2 with 4-bit windows.
+inline Num3072 Num3072::GetInverse() const {
+  std::array<Num3072, 16> powers;
+  for (int i = 1; i < 16; ++i) {
+    powers[i] = powers[i - 1];
+    powers[i].Multiply(*this);
+  }
+  // The exponent p - 2 = 2^3072 - kPrimeDiff - 2 has all bits set except in its lowest limb.
+  const uint64_t low_limb = ~uint64_t{0} - kPrimeDiff - 1;
+  Num3072 result;
+  for (int bit = 64 * kLimbs - 4; bit >= 0; bit -= 4) {
+    for (int i = 0; i < 4; ++i) result.Multiply(result);
+    const int window = bit >= 64 ? 15 : static_cast<int>((low_limb >> bit) & 15);
+    if (window != 0) result.Multiply(powers[window]);
+  }
+  return result;
+}
+
+inline bool Num3072::IsOverflow() const {
+  if (limbs_[0] <= ~uint64_t{0} - kPrimeDiff) return false;
+  for (int i = 1; i < kLimbs; ++i)
+    if (limbs_[i] != ~uint64_t{0}) return false;
+  return true;
+}
+
+// Subtracts the prime, i.e. adds kPrimeDiff and discards the carry out of 2^3072.
+inline void Num3072::FullReduce() {
+  uint64_t add = kPrimeDiff;
+  for (int i = 0; i < kLimbs && add != 0; ++i) {
+    limbs_[i] += add;
+    add = limbs_[i] < add;
+  }
+}
+
+inline std::array<uint8_t, Num3072::kBytes> Num3072::ToBytes() const {
+  Num3072 reduced = *this;
+  if (reduced.IsOverflow()) reduced.FullReduce();
+  std::array<uint8_t, kBytes> bytes;
+  for (int i = 0; i < kLimbs; ++i)
+    for (int b = 0; b < 8; ++b) bytes[8 * i + b] = static_cast<uint8_t>(reduced.limbs_[i] >> (8 * b));
+  return bytes;
+}
+
+namespace detail {
+
+// Writes the ChaCha20 keystream (RFC 8439) for the given key, with zero nonce and initial counter.
+inline void ChaCha20Keystream(const bytes32_t& key, std::span<uint8_t> out) {
+  const auto rotl = [](uint32_t v, int c) { return (v << c) | (v >> (32 - c)); };
+  const auto quarter = [&](std::array<uint32_t, 16>& x, int a, int b, int c, int d) {
+    x[a] += x[b]; x[d] = rotl(x[d] ^ x[a], 16);
+    x[c] += x[d]; x[b] = rotl(x[b] ^ x[c], 12);
+    x[a] += x[b]; x[d] = rotl(x[d] ^ x[a], 8);
+    x[c] += x[d]; x[b] = rotl(x[b] ^ x[c], 7);
+  };
+  std::array<uint32_t, 16> state = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
+  for (int i = 0; i < 8; ++i)
+    state[4 + i] = uint32_t{key[4 * i]} | uint32_t{key[4 * i + 1]} << 8 |
+                   uint32_t{key[4 * i + 2]} << 16 | uint32_t{key[4 * i + 3]} << 24;
+  for (size_t offset = 0; offset < out.size(); offset += 64, ++state[12]) {
+    std::array<uint32_t, 16> x = state;
+    for (int round = 0; round < 10; ++round) {
+      quarter(x, 0, 4, 8, 12); quarter(x, 1, 5, 9, 13); quarter(x, 2, 6, 10, 14); quarter(x, 3, 7, 11, 15);
+      quarter(x, 0, 5, 10, 15); quarter(x, 1, 6, 11, 12); quarter(x, 2, 7, 8, 13); quarter(x, 3, 4, 9, 14);
+    }
+    for (size_t i = 0; i < 64 && offset + i < out.size(); ++i)
+      out[offset + i] = static_cast<uint8_t>((x[i / 4] + state[i / 4]) >> (8 * (i % 4)));
+  }
+}
+
+}  // namespace detail
+
+// A multiset hash held as a fraction: inserted elements multiply the numerator and removed
+// elements multiply the denominator, so that the single division is deferred to Finalize.
+class MuHash3072 {
+ public:
+  MuHash3072() = default;  // The empty set.
+  MuHash3072(const Num3072& numerator, const Num3072& denominator)
+      : numerator_(numerator), denominator_(denominator) {}
+
+  // Maps an arbitrary byte string to a group element.
+  static Num3072 ToNum3072(std::span<const uint8_t> element);
+
+  MuHash3072& Insert(std::span<const uint8_t> element) {
+    numerator_.Multiply(ToNum3072(element));
+    return *this;
+  }
+  MuHash3072& Remove(std::span<const uint8_t> element) {
+    denominator_.Multiply(ToNum3072(element));
+    return *this;
+  }
+  MuHash3072& operator*=(const MuHash3072& rhs) {
+    numerator_.Multiply(rhs.numerator_);
+    denominator_.Multiply(rhs.denominator_);
+    return *this;
+  }
+  MuHash3072& operator/=(const MuHash3072& rhs) {
+    const Num3072 numerator = rhs.numerator_;  // Copied in case rhs aliases *this.
+    numerator_.Multiply(rhs.denominator_);
+    denominator_.Multiply(numerator);
+    return *this;
+  }
+
+  // Returns the SHA-256 of the set's group element. This performs a modular inversion.
+  bytes32_t Finalize() const {
+    Num3072 value = numerator_;
+    value.Divide(denominator_);
+    return Sha256(value.ToBytes());
+  }
+
+ private:
+  Num3072 numerator_;
+  Num3072 denominator_;
+};
+
+inline Num3072 MuHash3072::ToNum3072(std::span<const uint8_t> element) {
+  std::array<uint8_t, Num3072::kBytes> bytes;
+  detail::ChaCha20Keystream(SHA256::Hash(element), bytes);
+  return Num3072{bytes};
+}
+
+}  // namespace hornet::crypto
@@ -0,0 +1,132 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+// RIPEMD-160
+// Implemented from the spec at
+// https://homes.esat.kuleuven.be/~bosselae/ripemd160/pdf/AB-9601/AB-9601.pdf
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace hornet::crypto {
+
+namespace RIPEMD160 {
+using hash160_t = std::array<uint8_t, 20>;
+
+// Compute the RIPEMD-160 hash of an arbitrary byte stream
+hash160_t Hash(std::span<const uint8_t> bytes);
+}  // namespace RIPEMD160
+
+/* Implementation follows */
+
+namespace RIPEMD160 {
+namespace Detail {
+using State = std::array<uint32_t, 5>;
+using Block = std::array<uint32_t, 16>;  // 512-bit message block, little endian words
+
+static constexpr State s_initialHash = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+static constexpr std::array<uint32_t, 5> s_K = {0x00000000, 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xa953fd4e};
+static constexpr std::array<uint32_t, 5> s_KPrime = {0x50a28be6, 0x5c4dd124, 0x6d703ef3, 0x7a6d76e9, 0x00000000};
+
+// The message word selected at each step, for the left and right lines.
+static constexpr std::array<uint8_t, 80> s_r = {
+    0, 1, 2,  3,  4,  5,  6,  7,  8, 9, 10, 11, 12, 13, 14, 15, 7,  4,  13, 1,  10, 6,  15, 3,  12, 0, 9,
+    5, 2, 14, 11, 8,  3,  10, 14, 4, 9, 15, 8,  1,  2,  7,  0,  6,  13, 11, 5,  12, 1,  9,  11, 10, 0, 8,
+    12, 4, 13, 3, 7, 15, 14, 5, 6, 2, 4, 0,  5,  9,  7,  12, 2,  10, 14, 1,  3,  8,  11, 6,  15, 13};
+static constexpr std::array<uint8_t, 80> s_rPrime = {
+    5,  14, 7,  0,  9, 2,  11, 4,  13, 6,  15, 8, 1,  10, 3, 12, 6,  11, 3,  7,  0, 13, 5,  10, 14, 15, 8,
+    12, 4,  9,  1,  2, 15, 5,  1,  3,  7,  14, 6, 9,  11, 8, 12, 2,  10, 0,  4,  13, 8,  6,  4,  1,  3,  11,
+    15, 0,  5,  12, 2, 13, 9,  7,  10, 14, 12, 15, 10, 4, 1,  5,  8,  7,  6,  2,  13, 14, 0,  3,  9,  11};
+
+// The left rotation applied at each step, for the left and right lines.
+static constexpr std::array<uint8_t, 80> s_s = {
+    11, 14, 15, 12, 5,  8,  7,  9,  11, 13, 14, 15, 6,  7,  9,  8,  7,  6,  8,  13, 11, 9,  7,  15, 7,  12, 15,
+    9,  11, 7,  13, 12, 11, 13, 6,  7,  14, 9,  13, 15, 14, 8,  13, 6,  5,  12, 7,  5,  11, 12, 14, 15, 14, 15,
+    9,  8,  9,  14, 5,  6,  8,  6,  5,  12, 9,  15, 5,  11, 6,  8,  13, 12, 5,  12, 13, 14, 11, 8,  5,  6};
+static constexpr std::array<uint8_t, 80> s_sPrime = {
+    8,  9,  9,  11, 13, 15, 15, 5,  7,  7,  8,  11, 14, 14, 12, 6,  9,  13, 15, 7,  12, 8,  9,  11, 7,  7,  12,
+    7,  6,  15, 13, 11, 9,  7,  15, 11, 8,  6,  6,  14, 12, 13, 5,  14, 13, 13, 7,  5,  15, 5,  8,  11, 14, 14,
+    6,  14, 6,  9,  12, 9,  12, 5,  15, 8,  8,  5,  12, 9,  12, 5,  14, 6,  8,  13, 6,  5,  15, 13, 11, 11};
+
+inline uint32_t ROTL(uint32_t x, uint32_t count) {
+  return (x << count) | (x >> (32 - count));
+}
+
+// The nonlinear function of each of the five rounds.
+inline uint32_t F(int round, uint32_t x, uint32_t y, uint32_t z) {
+  switch (round) {
+    case 0: return x ^ y ^ z;
+    case 1: return (x & y) | (~x & z);
+    case 2: return (x | ~y) ^ z;
+    case 3: return (x & z) | (y & ~z);
+    default: return x ^ (y | ~z);
+  }
+}
+
+inline void ProcessBlock(const Block &X, State &H) {
+  uint32_t a = H[0], b = H[1], c = H[2], d = H[3], e = H[4];
+  uint32_t a2 = a, b2 = b, c2 = c, d2 = d, e2 = e;
+  for (int j = 0; j < 80; ++j) {
+    const int round = j / 16;
+    uint32_t t = ROTL(a + F(round, b, c, d) + X[s_r[j]] + s_K[round], s_s[j]) + e;
+    a = e;
+    e = d;
+    d = ROTL(c, 10);
+    c = b;
+    b = t;
+    // The right line applies the rounds in reverse order.
+    t = ROTL(a2 + F(4 - round, b2, c2, d2) + X[s_rPrime[j]] + s_KPrime[round], s_sPrime[j]) + e2;
+    a2 = e2;
+    e2 = d2;
+    d2 = ROTL(c2, 10);
+    c2 = b2;
+    b2 = t;
+  }
+  const uint32_t t = H[1] + c + d2;
+  H[1] = H[2] + d + e2;
+  H[2] = H[3] + e + a2;
+  H[3] = H[4] + a + b2;
+  H[4] = H[0] + b + c2;
+  H[0] = t;
+}
+
+inline Block LoadBlock(const uint8_t *bytes) {
+  Block block;
+  for (int i = 0; i < 16; ++i)
+    block[i] = uint32_t(bytes[4 * i]) | (uint32_t(bytes[4 * i + 1]) << 8) | (uint32_t(bytes[4 * i + 2]) << 16) |
+               (uint32_t(bytes[4 * i + 3]) << 24);
+  return block;
+}
+}  // namespace Detail
+
+inline hash160_t Hash(std::span<const uint8_t> bytes) {
+  using namespace Detail;
+
+  State H = s_initialHash;
+  size_t offset = 0;
+  for (; bytes.size() - offset >= 64; offset += 64) ProcessBlock(LoadBlock(bytes.data() + offset), H);
+
+  // Pads the remaining bytes with a one bit, zeros, and the message size in bits (little endian).
+  std::array<uint8_t, 128> tail = {};
+  const size_t remaining = bytes.size() - offset;
+  if (remaining > 0) std::memcpy(tail.data(), bytes.data() + offset, remaining);
+  tail[remaining] = 0x80;
+  const size_t tail_size = remaining < 56 ? 64 : 128;
+  const uint64_t size_in_bits = uint64_t(bytes.size()) << 3;
+  for (int i = 0; i < 8; ++i) tail[tail_size - 8 + i] = uint8_t(size_in_bits >> (8 * i));
+  for (size_t block = 0; block < tail_size; block += 64) ProcessBlock(LoadBlock(tail.data() + block), H);
+
+  hash160_t rv;
+  for (int i = 0; i < 5; ++i)
+    for (int b = 0; b < 4; ++b) rv[4 * i + b] = uint8_t(H[i] >> (8 * b));
+  return rv;
+}
+
+}  // namespace RIPEMD160
+
+}  // namespace hornet::crypto
@@ -0,0 +1,135 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "hornetlib/crypto/secp256k1/ecmult.h"
+#include "hornetlib/crypto/secp256k1/group.h"
+#include "hornetlib/crypto/secp256k1/scalar.h"
+
+namespace hornet::crypto::secp256k1 {
+
+struct EcdsaSignature {
+  Scalar r;
+  Scalar s;
+};
+
+// Parses a strict DER signature (BIP66), without the trailing sighash type byte. Returns nullopt
+// for any other encoding, or if r or s is not below the group order.
+inline std::optional<EcdsaSignature> ParseDerSignature(std::span<const uint8_t> der) {
+  if (der.size() < 8 || der.size() > 72 || der[0] != 0x30 || der[1] != der.size() - 2)
+    return std::nullopt;
+  std::array<Scalar, 2> values;
+  size_t offset = 2;
+  for (Scalar& value : values) {
+    if (offset + 2 > der.size() || der[offset] != 0x02) return std::nullopt;
+    const size_t length = der[offset + 1];
+    offset += 2;
+    if (length == 0 || offset + length > der.size()) return std::nullopt;
+    const auto integer = der.subspan(offset, length);
+    if (integer[0] & 0x80) return std::nullopt;  // Negative.
+    if (length > 1 && integer[0] == 0 && !(integer[1] & 0x80)) return std::nullopt;  // Padded.
+    const auto digits = integer[0] == 0 ? integer.subspan(1) : integer;
+    if (digits.size() > 32) return std::nullopt;
+    std::array<uint8_t, 32> bytes = {};
+    std::copy(digits.begin(), digits.end(), bytes.end() - digits.size());
+    bool overflow;
+    value = Scalar::FromBytes(bytes, &overflow);
+    if (overflow) return std::nullopt;
+    offset += length;
+  }
+  if (offset != der.size()) return std::nullopt;
+  return EcdsaSignature{values[0], values[1]};
+}
+
+// Parses a DER-like signature as consensus did before BIP66, without the trailing sighash type byte,
+// following libsecp256k1's lax parser. Lengths may use long form, and integers may be padded or have
+// their sign bit set. Returns nullopt if the structure can't be parsed, and a zero signature, which
+// never verifies, if r or s overflows.
+inline std::optional<EcdsaSignature> ParseLaxDerSignature(std::span<const uint8_t> der) {
+  size_t pos = 0;
+  // Reads a length byte, or a long-form length, which for the sequence is skipped.
+  const auto read_length = [&](size_t& length, bool skip) {
+    if (pos == der.size()) return false;
+    size_t bytes = der[pos++];
+    if (!(bytes & 0x80)) {
+      length = bytes;
+      return true;
+    }
+    bytes -= 0x80;
+    if (bytes > der.size() - pos) return false;
+    if (skip) {
+      pos += bytes;
+      return true;
+    }
+    for (; bytes > 0 && der[pos] == 0; --bytes) ++pos;
+    if (bytes >= sizeof(size_t)) return false;
+    for (length = 0; bytes > 0; --bytes) length = (length << 8) + der[pos++];
+    return true;
+  };
+  size_t length = 0;
+  if (pos == der.size() || der[pos++] != 0x30 || !read_length(length, true)) return std::nullopt;
+  std::array<std::span<const uint8_t>, 2> integers;
+  for (auto& integer : integers) {
+    if (pos == der.size() || der[pos++] != 0x02 || !read_length(length, false)) return std::nullopt;
+    if (length > der.size() - pos) return std::nullopt;
+    integer = der.subspan(pos, length);
+    pos += length;
+  }
+  std::array<Scalar, 2> values;
+  for (int i = 0; i < 2; ++i) {
+    auto digits = integers[i];
+    while (!digits.empty() && digits[0] == 0) digits = digits.subspan(1);
+    if (digits.size() > 32) return EcdsaSignature{};
+    std::array<uint8_t, 32> bytes = {};
+    std::copy(digits.begin(), digits.end(), bytes.end() - digits.size());
+    bool overflow;
+    values[i] = Scalar::FromBytes(bytes, &overflow);
+    if (overflow) return EcdsaSignature{};
+  }
+  return EcdsaSignature{values[0], values[1]};
+}
+
+// Verifies an ECDSA signature of a 32-byte message digest. As in consensus, high values of s are
+// accepted.
+inline bool VerifyEcdsa(const AffinePoint& public_key, std::span<const uint8_t, 32> digest,
+                        const EcdsaSignature& signature) {
+  if (signature.r.IsZero() || signature.s.IsZero()) return false;
+  const Scalar w = signature.s.Inverse();
+  const Scalar u1 = Scalar::FromBytes(digest) * w;
+  const Scalar u2 = signature.r * w;
+  const JacobianPoint point = MultiplyAdd(u1, {&public_key, 1}, {&u2, 1});
+  if (point.IsInfinity()) return false;
+
+  // The signature is valid if the x-coordinate of the point, reduced modulo n, equals r. Since
+  // p < 2n, the x-coordinate is either r itself or r + n, if that is still below p.
+  const auto r_bytes = signature.r.ToBytes();
+  const FieldElement r = *FieldElement::FromBytes(r_bytes);
+  if (point.HasX(r)) return true;
+  constexpr std::array<uint8_t, 32> kPrimeMinusOrder = {
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01,
+      0x45, 0x51, 0x23, 0x19, 0x50, 0xB7, 0x5F, 0xC4, 0x40, 0x2D, 0xA1, 0x72, 0x2F, 0xC9, 0xBA, 0xEE};
+  if (!(r_bytes < kPrimeMinusOrder)) return false;
+  constexpr std::array<uint8_t, 32> kOrder = {
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE,
+      0xBA, 0xAE, 0xDC, 0xE6, 0xAF, 0x48, 0xA0, 0x3B, 0xBF, 0xD2, 0x5E, 0x8C, 0xD0, 0x36, 0x41, 0x41};
+  return point.HasX(r + *FieldElement::FromBytes(kOrder));
+}
+
+// Verifies a DER-encoded ECDSA signature against a serialized public key. As in consensus, the
+// signature is parsed laxly; strict encoding (BIP66) is checked separately by the script rules.
+inline bool VerifyEcdsa(std::span<const uint8_t> public_key, std::span<const uint8_t, 32> digest,
+                        std::span<const uint8_t> der) {
+  const auto point = ParsePublicKey(public_key);
+  const auto signature = ParseLaxDerSignature(der);
+  return point && signature && VerifyEcdsa(*point, digest, *signature);
+}
+
+}  // namespace hornet::crypto::secp256k1
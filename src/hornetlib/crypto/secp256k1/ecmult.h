@@ -0,0 +1,145 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+// Multi-scalar multiplication by Strauss' method: every scalar is split in two halves of 128 bits
+// with the GLV endomorphism and recoded in windowed non-adjacent form (wNAF), so that all the
+// points share a single chain of 129 doublings. Multiples of the generator use a larger window
+// with tables that are computed once per process.
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <vector>
+
+#include "hornetlib/crypto/secp256k1/group.h"
+#include "hornetlib/crypto/secp256k1/scalar.h"
+#include "hornetlib/util/assert.h"
+
+namespace hornet::crypto::secp256k1 {
+
+namespace detail {
+
+// Each half of a split scalar is below 2^128 once its sign is taken out, and its wNAF has at most
+// one digit more.
+inline constexpr int kWnafLength = 129;
+inline constexpr int kPointWindow = 5;
+inline constexpr int kGeneratorWindow = 12;
+
+using Wnaf = std::array<int, kWnafLength>;
+
+// Recodes a half-scalar as odd digits in (-2^(w-1), 2^(w-1)), separated by runs of at least w - 1
+// zeros. Negates the digits if the scalar is high, i.e. stands for a negative 128-bit value.
+inline void ComputeWnaf(Scalar s, int w, Wnaf& wnaf) {
+  int sign = 1;
+  if (s.IsHigh()) {
+    s = s.Negate();
+    sign = -1;
+  }
+  wnaf.fill(0);
+  int carry = 0;
+  for (int bit = 0; bit < kWnafLength;) {
+    if (static_cast<int>(s.GetBits(bit, 1)) == carry) {
+      ++bit;
+      continue;
+    }
+    const int now = std::min(w, kWnafLength - bit);
+    int word = static_cast<int>(s.GetBits(bit, now)) + carry;
+    carry = (word >> (w - 1)) & 1;
+    word -= carry << w;
+    wnaf[bit] = sign * word;
+    bit += now;
+  }
+}
+
+// Fills table[i] with the affine point (2i + 1) * p, for every table of points at once, so that
+// all the Jacobian-to-affine conversions share a single field inversion.
+inline void ComputeOddMultiples(std::span<const AffinePoint> points, int table_size,
+                                std::vector<AffinePoint>& tables) {
+  std::vector<JacobianPoint> multiples;
+  multiples.reserve(points.size() * table_size);
+  for (const AffinePoint& point : points) {
+    const JacobianPoint twice = JacobianPoint{point}.Double();
+    multiples.emplace_back(point);
+    for (int i = 1; i < table_size; ++i) multiples.push_back(multiples.back().Add(twice));
+  }
+  std::vector<FieldElement> z_inverses(multiples.size());
+  for (size_t i = 0; i < multiples.size(); ++i)
+    z_inverses[i] = multiples[i].IsInfinity() ? FieldElement{1} : multiples[i].Z();
+  FieldElement::InverseAll(z_inverses);
+  tables.resize(multiples.size());
+  for (size_t i = 0; i < multiples.size(); ++i) tables[i] = multiples[i].ToAffine(z_inverses[i]);
+}
+
+// Returns digit * p for an odd digit, given the odd-multiples table of p.
+inline AffinePoint LookupOdd(const AffinePoint* table, int digit) {
+  return digit > 0 ? table[(digit - 1) / 2] : table[(-digit - 1) / 2].Negate();
+}
+
+// The odd multiples of G and of lambda * G for the generator window.
+struct GeneratorTables {
+  static constexpr int kSize = 1 << (kGeneratorWindow - 2);
+
+  GeneratorTables() {
+    const AffinePoint generator = AffinePoint::Generator();
+    ComputeOddMultiples({&generator, 1}, kSize, g);
+    lambda_g.reserve(g.size());
+    for (const AffinePoint& point : g) lambda_g.push_back(point.MulLambda());
+  }
+
+  static const GeneratorTables& Get() {
+    static const GeneratorTables tables;
+    return tables;
+  }
+
+  std::vector<AffinePoint> g;
+  std::vector<AffinePoint> lambda_g;
+};
+
+}  // namespace detail
+
+// Returns g_scalar * G + sum(scalars[i] * points[i]).
+inline JacobianPoint MultiplyAdd(const Scalar& g_scalar, std::span<const AffinePoint> points,
+                                 std::span<const Scalar> scalars) {
+  using namespace detail;
+  Assert(points.size() == scalars.size());
+  constexpr int kPointTableSize = 1 << (kPointWindow - 2);
+  const size_t count = points.size();
+
+  // Tables of the odd multiples of each point and of its image under the endomorphism.
+  std::vector<AffinePoint> tables;
+  ComputeOddMultiples(points, kPointTableSize, tables);
+  std::vector<AffinePoint> lambda_tables;
+  lambda_tables.reserve(tables.size());
+  for (const AffinePoint& point : tables) lambda_tables.push_back(point.MulLambda());
+
+  std::vector<Wnaf> wnafs(2 * count);
+  for (size_t i = 0; i < count; ++i) {
+    const auto [k1, k2] = Scalar::SplitLambda(scalars[i]);
+    ComputeWnaf(k1, kPointWindow, wnafs[2 * i]);
+    ComputeWnaf(k2, kPointWindow, wnafs[2 * i + 1]);
+  }
+  const GeneratorTables& generator = GeneratorTables::Get();
+  const auto [g1, g2] = Scalar::SplitLambda(g_scalar);
+  Wnaf g_wnaf1, g_wnaf2;
+  ComputeWnaf(g1, kGeneratorWindow, g_wnaf1);
+  ComputeWnaf(g2, kGeneratorWindow, g_wnaf2);
+
+  JacobianPoint r;
+  for (int bit = kWnafLength - 1; bit >= 0; --bit) {
+    r = r.Double();
+    for (size_t i = 0; i < count; ++i) {
+      const AffinePoint* table = &tables[i * kPointTableSize];
+      const AffinePoint* lambda_table = &lambda_tables[i * kPointTableSize];
+      if (const int digit = wnafs[2 * i][bit]) r = r.AddAffine(LookupOdd(table, digit));
+      if (const int digit = wnafs[2 * i + 1][bit]) r = r.AddAffine(LookupOdd(lambda_table, digit));
+    }
+    if (const int digit = g_wnaf1[bit]) r = r.AddAffine(LookupOdd(generator.g.data(), digit));
+    if (const int digit = g_wnaf2[bit]) r = r.AddAffine(LookupOdd(generator.lambda_g.data(), digit));
+  }
+  return r;
+}
+
+}  // namespace hornet::crypto::secp256k1
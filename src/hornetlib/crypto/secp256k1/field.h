@@ -0,0 +1,219 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "hornetlib/util/assert.h"
+
+namespace hornet::crypto::secp256k1 {
+
+// An element of the field of integers modulo p = 2^256 - 2^32 - 977, held in five 52-bit limbs
+// so that limb products and their sums fit comfortably in 128 bits.
+//
+// Every operation returns a weakly normalized value: limbs 0..3 are below 2^52, limb 4 is at most
+// 2^48, and the value is below 2p, but not necessarily below p. Comparisons and serialization
+// reduce fully. These operations are not constant-time, and are intended only for verification.
+class FieldElement {
+ public:
+  constexpr FieldElement() : n_{} {}
+  explicit constexpr FieldElement(uint64_t value)
+      : n_{value & kMask, value >> 52, 0, 0, 0} {}
+
+  // Parses 32 big-endian bytes. Returns nullopt if the value is not below p.
+  static std::optional<FieldElement> FromBytes(std::span<const uint8_t, 32> bytes);
+
+  // Returns 32 big-endian bytes of the fully reduced value.
+  std::array<uint8_t, 32> ToBytes() const;
+
+  bool IsZero() const;
+  bool IsOdd() const { return Normalized().n_[0] & 1; }
+  bool operator==(const FieldElement& rhs) const { return (*this - rhs).IsZero(); }
+
+  FieldElement operator+(const FieldElement& rhs) const;
+  FieldElement operator-(const FieldElement& rhs) const { return *this + rhs.Negate(); }
+  FieldElement operator*(const FieldElement& rhs) const;
+  FieldElement Square() const { return *this * *this; }
+  FieldElement MulInt(uint32_t k) const;
+  FieldElement Negate() const;
+
+  // Returns the multiplicative inverse, or zero for zero.
+  FieldElement Inverse() const;
+
+  // Returns a square root, or nullopt if the value is not a quadratic residue.
+  std::optional<FieldElement> Sqrt() const;
+
+  // Inverts all the (non-zero) elements in place with a single field inversion.
+  static void InverseAll(std::span<FieldElement> elements);
+
+ private:
+  static constexpr uint64_t kMask = (uint64_t{1} << 52) - 1;
+  static constexpr uint64_t kMask48 = (uint64_t{1} << 48) - 1;
+  static constexpr uint64_t kPrimeDiff = 0x1000003D1;  // 2^256 - p.
+  static constexpr uint64_t kR = kPrimeDiff << 4;      // 2^260 mod p.
+
+  // Raises to a 256-bit power given as little-endian 64-bit words, with 4-bit windows.
+  FieldElement Pow(const std::array<uint64_t, 4>& exponent) const;
+  FieldElement Normalized() const;
+  void NormalizeWeak();
+
+  std::array<uint64_t, 5> n_;
+};
+
+// Folds the bits of limb 4 above 2^48 back into limb 0, and propagates carries.
+inline void FieldElement::NormalizeWeak() {
+  const uint64_t x = n_[4] >> 48;
+  n_[4] &= kMask48;
+  n_[0] += x * kPrimeDiff;
+  n_[1] += n_[0] >> 52; n_[0] &= kMask;
+  n_[2] += n_[1] >> 52; n_[1] &= kMask;
+  n_[3] += n_[2] >> 52; n_[2] &= kMask;
+  n_[4] += n_[3] >> 52; n_[3] &= kMask;
+}
+
+// Returns the unique representative below p. Since a weakly normalized value is below 2p, it
+// suffices to subtract p once, i.e. to add 2^256 - p and test the carry out of 2^256.
+inline FieldElement FieldElement::Normalized() const {
+  FieldElement t = *this;
+  t.n_[0] += kPrimeDiff;
+  t.n_[1] += t.n_[0] >> 52; t.n_[0] &= kMask;
+  t.n_[2] += t.n_[1] >> 52; t.n_[1] &= kMask;
+  t.n_[3] += t.n_[2] >> 52; t.n_[2] &= kMask;
+  t.n_[4] += t.n_[3] >> 52; t.n_[3] &= kMask;
+  if (t.n_[4] >> 48) {
+    t.n_[4] &= kMask48;
+    return t;
+  }
+  return *this;
+}
+
+inline std::optional<FieldElement> FieldElement::FromBytes(std::span<const uint8_t, 32> bytes) {
+  std::array<uint64_t, 4> w = {};
+  for (int i = 0; i < 32; ++i) w[3 - i / 8] = (w[3 - i / 8] << 8) | bytes[i];
+  FieldElement r;
+  r.n_ = {w[0] & kMask, ((w[0] >> 52) | (w[1] << 12)) & kMask, ((w[1] >> 40) | (w[2] << 24)) & kMask,
+          ((w[2] >> 28) | (w[3] << 36)) & kMask, w[3] >> 16};
+  if (r.Normalized().n_ != r.n_) return std::nullopt;  // Not below p.
+  return r;
+}
+
+inline std::array<uint8_t, 32> FieldElement::ToBytes() const {
+  const auto& n = Normalized().n_;
+  const std::array<uint64_t, 4> w = {n[0] | (n[1] << 52), (n[1] >> 12) | (n[2] << 40),
+                                     (n[2] >> 24) | (n[3] << 28), (n[3] >> 36) | (n[4] << 16)};
+  std::array<uint8_t, 32> bytes;
+  for (int i = 0; i < 32; ++i) bytes[i] = static_cast<uint8_t>(w[3 - i / 8] >> (8 * (7 - i % 8)));
+  return bytes;
+}
+
+inline bool FieldElement::IsZero() const {
+  const auto& n = Normalized().n_;
+  return (n[0] | n[1] | n[2] | n[3] | n[4]) == 0;
+}
+
+inline FieldElement FieldElement::operator+(const FieldElement& rhs) const {
+  FieldElement r;
+  for (int i = 0; i < 5; ++i) r.n_[i] = n_[i] + rhs.n_[i];
+  r.NormalizeWeak();
+  return r;
+}
+
+// Returns 4p - a, whose limbs are all non-negative for a weakly normalized a.
+inline FieldElement FieldElement::Negate() const {
+  constexpr uint64_t kP0 = 0xFFFFEFFFFFC2F, kP = 0xFFFFFFFFFFFFF, kP4 = 0x0FFFFFFFFFFFF;
+  FieldElement r;
+  r.n_ = {4 * kP0 - n_[0], 4 * kP - n_[1], 4 * kP - n_[2], 4 * kP - n_[3], 4 * kP4 - n_[4]};
+  r.NormalizeWeak();
+  return r;
+}
+
+// Weakly normalized limbs are below 2^52, so k is bounded by 2^12 to keep each product in 64 bits.
+inline FieldElement FieldElement::MulInt(uint32_t k) const {
+  Assert(k <= 4096);
+  FieldElement r;
+  for (int i = 0; i < 5; ++i) r.n_[i] = n_[i] * k;
+  r.NormalizeWeak();
+  return r;
+}
+
+inline FieldElement FieldElement::operator*(const FieldElement& rhs) const {
+  using uint128_t = unsigned __int128;
+  const auto& a = n_;
+  const auto& b = rhs.n_;
+
+  // Schoolbook product in 52-bit columns, carried into ten limbs.
+  std::array<uint64_t, 10> t;
+  uint128_t c = 0;
+  for (int k = 0; k < 9; ++k) {
+    for (int i = std::max(0, k - 4); i <= std::min(k, 4); ++i) c += uint128_t{a[i]} * b[k - i];
+    t[k] = static_cast<uint64_t>(c) & kMask;
+    c >>= 52;
+  }
+  t[9] = static_cast<uint64_t>(c);
+
+  // Folds the upper five limbs down, since 2^260 is congruent to kR.
+  FieldElement r;
+  c = 0;
+  for (int k = 0; k < 5; ++k) {
+    c += uint128_t{t[k + 5]} * kR + t[k];
+    r.n_[k] = static_cast<uint64_t>(c) & kMask;
+    c >>= 52;
+  }
+  // Folds the carry out of 2^260 into limb 0.
+  c = c * kR + r.n_[0];
+  r.n_[0] = static_cast<uint64_t>(c) & kMask;
+  c = (c >> 52) + r.n_[1];
+  r.n_[1] = static_cast<uint64_t>(c) & kMask;
+  r.n_[2] += static_cast<uint64_t>(c >> 52);
+  r.NormalizeWeak();
+  return r;
+}
+
+inline FieldElement FieldElement::Pow(const std::array<uint64_t, 4>& exponent) const {
+  std::array<FieldElement, 16> powers;
+  powers[0] = FieldElement{1};
+  for (int i = 1; i < 16; ++i) powers[i] = powers[i - 1] * *this;
+  FieldElement r{1};
+  for (int bit = 252; bit >= 0; bit -= 4) {
+    r = r.Square().Square().Square().Square();
+    const int window = static_cast<int>((exponent[bit / 64] >> (bit % 64)) & 15);
+    if (window != 0) r = r * powers[window];
+  }
+  return r;
+}
+
+inline FieldElement FieldElement::Inverse() const {
+  // By Fermat's little theorem, a^(p - 2) is the inverse of a.
+  return Pow({0xFFFFFFFEFFFFFC2D, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF});
+}
+
+inline std::optional<FieldElement> FieldElement::Sqrt() const {
+  // Since p = 3 mod 4, a^((p + 1) / 4) is a square root of a whenever one exists.
+  const FieldElement root =
+      Pow({0xFFFFFFFFBFFFFF0C, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0x3FFFFFFFFFFFFFFF});
+  if (!(root.Square() == *this)) return std::nullopt;
+  return root;
+}
+
+inline void FieldElement::InverseAll(std::span<FieldElement> elements) {
+  if (elements.empty()) return;
+  // Montgomery's trick: invert the running product once, then unwind it.
+  std::vector<FieldElement> prefix(elements.size());
+  prefix[0] = elements[0];
+  for (size_t i = 1; i < elements.size(); ++i) prefix[i] = prefix[i - 1] * elements[i];
+  FieldElement inverse = prefix.back().Inverse();
+  for (size_t i = elements.size() - 1; i > 0; --i) {
+    const FieldElement element = elements[i];
+    elements[i] = inverse * prefix[i - 1];
+    inverse = inverse * element;
+  }
+  elements[0] = inverse;
+}
+
+}  // namespace hornet::crypto::secp256k1
@@ -0,0 +1,192 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "hornetlib/crypto/secp256k1/field.h"
+
+namespace hornet::crypto::secp256k1 {
+
+// The constant b of the curve y^2 = x^3 + b.
+inline const FieldElement kCurveB{7};
+
+// A point on the curve in affine coordinates.
+struct AffinePoint {
+  FieldElement x;
+  FieldElement y;
+  bool infinity = false;
+
+  static AffinePoint Generator();
+
+  bool IsOnCurve() const { return infinity || y.Square() == x.Square() * x + kCurveB; }
+  AffinePoint Negate() const { return {x, y.Negate(), infinity}; }
+
+  // Applies the endomorphism (x, y) -> (beta * x, y), which multiplies the point by lambda.
+  AffinePoint MulLambda() const;
+
+  // Returns the point with the given x-coordinate and the given parity of y, if there is one.
+  static std::optional<AffinePoint> FromX(const FieldElement& x, bool odd);
+};
+
+// A point in Jacobian coordinates (X, Y, Z), representing the affine point (X / Z^2, Y / Z^3).
+class JacobianPoint {
+ public:
+  JacobianPoint() : infinity_(true) {}
+  explicit JacobianPoint(const AffinePoint& p) : x_(p.x), y_(p.y), z_(1), infinity_(p.infinity) {}
+
+  bool IsInfinity() const { return infinity_; }
+  const FieldElement& Z() const { return z_; }
+
+  JacobianPoint Double() const;
+  JacobianPoint Add(const JacobianPoint& rhs) const;
+  JacobianPoint AddAffine(const AffinePoint& rhs) const;
+  JacobianPoint Negate() const;
+
+  // Returns true if the affine x-coordinate equals x, without an inversion.
+  bool HasX(const FieldElement& x) const { return !infinity_ && x * z_.Square() == x_; }
+
+  AffinePoint ToAffine() const;
+
+  // Returns the affine point given the precomputed inverse of Z.
+  AffinePoint ToAffine(const FieldElement& z_inverse) const;
+
+ private:
+  FieldElement x_;
+  FieldElement y_;
+  FieldElement z_;
+  bool infinity_;
+};
+
+inline AffinePoint AffinePoint::Generator() {
+  static const AffinePoint generator = [] {
+    constexpr std::array<uint8_t, 32> kX = {
+        0x79, 0xBE, 0x66, 0x7E, 0xF9, 0xDC, 0xBB, 0xAC, 0x55, 0xA0, 0x62, 0x95, 0xCE, 0x87, 0x0B, 0x07,
+        0x02, 0x9B, 0xFC, 0xDB, 0x2D, 0xCE, 0x28, 0xD9, 0x59, 0xF2, 0x81, 0x5B, 0x16, 0xF8, 0x17, 0x98};
+    constexpr std::array<uint8_t, 32> kY = {
+        0x48, 0x3A, 0xDA, 0x77, 0x26, 0xA3, 0xC4, 0x65, 0x5D, 0xA4, 0xFB, 0xFC, 0x0E, 0x11, 0x08, 0xA8,
+        0xFD, 0x17, 0xB4, 0x48, 0xA6, 0x85, 0x54, 0x19, 0x9C, 0x47, 0xD0, 0x8F, 0xFB, 0x10, 0xD4, 0xB8};
+    return AffinePoint{*FieldElement::FromBytes(kX), *FieldElement::FromBytes(kY)};
+  }();
+  return generator;
+}
+
+inline AffinePoint AffinePoint::MulLambda() const {
+  static const FieldElement beta = [] {
+    constexpr std::array<uint8_t, 32> kBeta = {
+        0x7A, 0xE9, 0x6A, 0x2B, 0x65, 0x7C, 0x07, 0x10, 0x6E, 0x64, 0x47, 0x9E, 0xAC, 0x34, 0x34, 0xE9,
+        0x9C, 0xF0, 0x49, 0x75, 0x12, 0xF5, 0x89, 0x95, 0xC1, 0x39, 0x6C, 0x28, 0x71, 0x95, 0x01, 0xEE};
+    return *FieldElement::FromBytes(kBeta);
+  }();
+  return {x * beta, y, infinity};
+}
+
+inline std::optional<AffinePoint> AffinePoint::FromX(const FieldElement& x, bool odd) {
+  const auto y = (x.Square() * x + kCurveB).Sqrt();
+  if (!y) return std::nullopt;
+  return AffinePoint{x, y->IsOdd() == odd ? *y : y->Negate()};
+}
+
+// Doubling for a = 0, from "dbl-2009-l" in the Explicit-Formulas Database.
+inline JacobianPoint JacobianPoint::Double() const {
+  if (infinity_ || y_.IsZero()) return {};
+  const FieldElement a = x_.Square();
+  const FieldElement b = y_.Square();
+  const FieldElement c = b.Square();
+  const FieldElement d = ((x_ + b).Square() - a - c).MulInt(2);
+  const FieldElement e = a.MulInt(3);
+  const FieldElement f = e.Square();
+  JacobianPoint r;
+  r.x_ = f - d.MulInt(2);
+  r.y_ = e * (d - r.x_) - c.MulInt(8);
+  r.z_ = (y_ * z_).MulInt(2);
+  r.infinity_ = false;
+  return r;
+}
+
+inline JacobianPoint JacobianPoint::Add(const JacobianPoint& rhs) const {
+  if (infinity_) return rhs;
+  if (rhs.infinity_) return *this;
+  const FieldElement z1z1 = z_.Square();
+  const FieldElement z2z2 = rhs.z_.Square();
+  const FieldElement u1 = x_ * z2z2;
+  const FieldElement u2 = rhs.x_ * z1z1;
+  const FieldElement s1 = y_ * rhs.z_ * z2z2;
+  const FieldElement s2 = rhs.y_ * z_ * z1z1;
+  const FieldElement h = u2 - u1;
+  const FieldElement r = s2 - s1;
+  if (h.IsZero()) return r.IsZero() ? Double() : JacobianPoint{};
+  const FieldElement hh = h.Square();
+  const FieldElement hhh = hh * h;
+  const FieldElement v = u1 * hh;
+  JacobianPoint sum;
+  sum.x_ = r.Square() - hhh - v.MulInt(2);
+  sum.y_ = r * (v - sum.x_) - s1 * hhh;
+  sum.z_ = z_ * rhs.z_ * h;
+  sum.infinity_ = false;
+  return sum;
+}
+
+// Mixed addition, where the right-hand side has Z = 1.
+inline JacobianPoint JacobianPoint::AddAffine(const AffinePoint& rhs) const {
+  if (infinity_) return JacobianPoint{rhs};
+  if (rhs.infinity) return *this;
+  const FieldElement z1z1 = z_.Square();
+  const FieldElement u2 = rhs.x * z1z1;
+  const FieldElement s2 = rhs.y * z_ * z1z1;
+  const FieldElement h = u2 - x_;
+  const FieldElement r = s2 - y_;
+  if (h.IsZero()) return r.IsZero() ? Double() : JacobianPoint{};
+  const FieldElement hh = h.Square();
+  const FieldElement hhh = hh * h;
+  const FieldElement v = x_ * hh;
+  JacobianPoint sum;
+  sum.x_ = r.Square() - hhh - v.MulInt(2);
+  sum.y_ = r * (v - sum.x_) - y_ * hhh;
+  sum.z_ = z_ * h;
+  sum.infinity_ = false;
+  return sum;
+}
+
+inline JacobianPoint JacobianPoint::Negate() const {
+  JacobianPoint r = *this;
+  r.y_ = y_.Negate();
+  return r;
+}
+
+inline AffinePoint JacobianPoint::ToAffine() const {
+  if (infinity_) return {{}, {}, true};
+  return ToAffine(z_.Inverse());
+}
+
+inline AffinePoint JacobianPoint::ToAffine(const FieldElement& z_inverse) const {
+  if (infinity_) return {{}, {}, true};
+  const FieldElement z2 = z_inverse.Square();
+  return {x_ * z2, y_ * z2 * z_inverse};
+}
+
+// Parses a serialized public key: compressed (0x02 or 0x03 and x), uncompressed (0x04, x and y),
+// or hybrid (0x06 or 0x07, x and y), as accepted by consensus without strict encoding.
+inline std::optional<AffinePoint> ParsePublicKey(std::span<const uint8_t> bytes) {
+  if (bytes.size() == 33 && (bytes[0] == 0x02 || bytes[0] == 0x03)) {
+    const auto x = FieldElement::FromBytes(bytes.subspan<1, 32>());
+    if (!x) return std::nullopt;
+    return AffinePoint::FromX(*x, bytes[0] == 0x03);
+  }
+  if (bytes.size() == 65 && (bytes[0] == 0x04 || bytes[0] == 0x06 || bytes[0] == 0x07)) {
+    const auto x = FieldElement::FromBytes(bytes.subspan<1, 32>());
+    const auto y = FieldElement::FromBytes(bytes.subspan<33, 32>());
+    if (!x || !y) return std::nullopt;
+    if (bytes[0] != 0x04 && y->IsOdd() != (bytes[0] == 0x07)) return std::nullopt;
+    const AffinePoint point{*x, *y};
+    if (!point.IsOnCurve()) return std::nullopt;
+    return point;
+  }
+  return std::nullopt;
+}
+
+}  // namespace hornet::crypto::secp256k1
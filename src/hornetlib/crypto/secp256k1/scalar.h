@@ -0,0 +1,223 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace hornet::crypto::secp256k1 {
+
+// An integer modulo the group order n, held fully reduced in four little-endian 64-bit words.
+class Scalar {
+ public:
+  constexpr Scalar() : d_{} {}
+  explicit constexpr Scalar(uint64_t value) : d_{value, 0, 0, 0} {}
+  explicit constexpr Scalar(const std::array<uint64_t, 4>& words) : d_(words) {}
+
+  // Parses 32 big-endian bytes, reducing modulo n. Sets *overflow if the value was not below n.
+  static Scalar FromBytes(std::span<const uint8_t, 32> bytes, bool* overflow = nullptr);
+  std::array<uint8_t, 32> ToBytes() const;
+
+  bool IsZero() const { return (d_[0] | d_[1] | d_[2] | d_[3]) == 0; }
+  bool IsHigh() const;  // True if the value exceeds n / 2.
+  bool operator==(const Scalar& rhs) const = default;
+
+  Scalar operator+(const Scalar& rhs) const;
+  Scalar operator*(const Scalar& rhs) const;
+  Scalar Negate() const;
+  Scalar Inverse() const;
+
+  // Returns count (at most 32) bits starting at the given offset.
+  uint32_t GetBits(int offset, int count) const;
+
+  // Splits k into (k1, k2) with k = k1 + k2 * lambda (mod n), where lambda is the cube root of
+  // unity acting on the curve as the endomorphism (x, y) -> (beta * x, y). Each half lies within
+  // 128 bits of zero, i.e. either it or its negation is below 2^128.
+  static std::pair<Scalar, Scalar> SplitLambda(const Scalar& k);
+
+ private:
+  static constexpr std::array<uint64_t, 4> kOrder = {0xBFD25E8CD0364141, 0xBAAEDCE6AF48A03B,
+                                                     0xFFFFFFFFFFFFFFFE, 0xFFFFFFFFFFFFFFFF};
+
+  static bool IsBelowOrder(const std::array<uint64_t, 4>& d);
+  static Scalar Reduce512(std::array<uint64_t, 8> wide);
+  static std::array<uint64_t, 8> MultiplyWide(const Scalar& a, const Scalar& b);
+
+  // Returns round(a * b / 2^384), for the GLV decomposition.
+  static Scalar MulShift384(const Scalar& a, const Scalar& b);
+
+  std::array<uint64_t, 4> d_;
+};
+
+inline bool Scalar::IsBelowOrder(const std::array<uint64_t, 4>& d) {
+  for (int i = 3; i >= 0; --i)
+    if (d[i] != kOrder[i]) return d[i] < kOrder[i];
+  return false;
+}
+
+// Adds 2^256 - n, i.e. subtracts n modulo 2^256, for a value known to be in [n, 2^256).
+inline Scalar Scalar::FromBytes(std::span<const uint8_t, 32> bytes, bool* overflow) {
+  Scalar r;
+  for (int i = 0; i < 32; ++i) r.d_[3 - i / 8] = (r.d_[3 - i / 8] << 8) | bytes[i];
+  const bool over = !IsBelowOrder(r.d_);
+  if (over) {
+    using uint128_t = unsigned __int128;
+    uint128_t c = 0;
+    for (int i = 0; i < 4; ++i) {
+      c += uint128_t{r.d_[i]} + ~kOrder[i] + (i == 0);
+      r.d_[i] = static_cast<uint64_t>(c);
+      c >>= 64;
+    }
+  }
+  if (overflow) *overflow = over;
+  return r;
+}
+
+inline std::array<uint8_t, 32> Scalar::ToBytes() const {
+  std::array<uint8_t, 32> bytes;
+  for (int i = 0; i < 32; ++i) bytes[i] = static_cast<uint8_t>(d_[3 - i / 8] >> (8 * (7 - i % 8)));
+  return bytes;
+}
+
+inline bool Scalar::IsHigh() const {
+  constexpr std::array<uint64_t, 4> kHalf = {0xDFE92F46681B20A0, 0x5D576E7357A4501D,
+                                             0xFFFFFFFFFFFFFFFF, 0x7FFFFFFFFFFFFFFF};
+  for (int i = 3; i >= 0; --i)
+    if (d_[i] != kHalf[i]) return d_[i] > kHalf[i];
+  return false;
+}
+
+inline uint32_t Scalar::GetBits(int offset, int count) const {
+  const int word = offset / 64, shift = offset % 64;
+  uint64_t bits = d_[word] >> shift;
+  if (shift + count > 64 && word < 3) bits |= d_[word + 1] << (64 - shift);
+  return static_cast<uint32_t>(bits & ((uint64_t{1} << count) - 1));
+}
+
+inline Scalar Scalar::operator+(const Scalar& rhs) const {
+  using uint128_t = unsigned __int128;
+  std::array<uint64_t, 8> wide = {};
+  uint128_t c = 0;
+  for (int i = 0; i < 4; ++i) {
+    c += uint128_t{d_[i]} + rhs.d_[i];
+    wide[i] = static_cast<uint64_t>(c);
+    c >>= 64;
+  }
+  wide[4] = static_cast<uint64_t>(c);
+  return Reduce512(wide);
+}
+
+inline Scalar Scalar::Negate() const {
+  if (IsZero()) return {};
+  using uint128_t = unsigned __int128;
+  Scalar r;
+  uint128_t c = 1;
+  for (int i = 0; i < 4; ++i) {
+    c += uint128_t{kOrder[i]} + ~d_[i];
+    r.d_[i] = static_cast<uint64_t>(c);
+    c >>= 64;
+  }
+  return r;
+}
+
+inline std::array<uint64_t, 8> Scalar::MultiplyWide(const Scalar& a, const Scalar& b) {
+  using uint128_t = unsigned __int128;
+  std::array<uint64_t, 8> wide = {};
+  for (int i = 0; i < 4; ++i) {
+    uint128_t c = 0;
+    for (int j = 0; j < 4; ++j) {
+      c += uint128_t{a.d_[i]} * b.d_[j] + wide[i + j];
+      wide[i + j] = static_cast<uint64_t>(c);
+      c >>= 64;
+    }
+    wide[i + 4] = static_cast<uint64_t>(c);
+  }
+  return wide;
+}
+
+// Reduces a 512-bit value modulo n by repeatedly folding the words above 2^256, since 2^256 is
+// congruent to the 129-bit constant 2^256 - n.
+inline Scalar Scalar::Reduce512(std::array<uint64_t, 8> wide) {
+  using uint128_t = unsigned __int128;
+  constexpr std::array<uint64_t, 3> kComplement = {0x402DA1732FC9BEBF, 0x4551231950B75FC4, 1};
+  while ((wide[4] | wide[5] | wide[6] | wide[7]) != 0) {
+    std::array<uint64_t, 8> folded = {wide[0], wide[1], wide[2], wide[3], 0, 0, 0, 0};
+    for (int i = 0; i < 4; ++i) {
+      uint128_t c = 0;
+      for (int j = 0; j < 3; ++j) {
+        c += uint128_t{wide[4 + i]} * kComplement[j] + folded[i + j];
+        folded[i + j] = static_cast<uint64_t>(c);
+        c >>= 64;
+      }
+      for (int k = i + 3; c != 0 && k < 8; ++k) {
+        c += folded[k];
+        folded[k] = static_cast<uint64_t>(c);
+        c >>= 64;
+      }
+    }
+    wide = folded;
+  }
+  Scalar r{{wide[0], wide[1], wide[2], wide[3]}};
+  if (!IsBelowOrder(r.d_)) {
+    uint128_t c = 1;
+    for (int i = 0; i < 4; ++i) {
+      c += uint128_t{r.d_[i]} + ~kOrder[i];
+      r.d_[i] = static_cast<uint64_t>(c);
+      c >>= 64;
+    }
+  }
+  return r;
+}
+
+inline Scalar Scalar::operator*(const Scalar& rhs) const {
+  return Reduce512(MultiplyWide(*this, rhs));
+}
+
+inline Scalar Scalar::Inverse() const {
+  // By Fermat's little theorem, a^(n - 2) is the inverse of a.
+  constexpr std::array<uint64_t, 4> kExponent = {0xBFD25E8CD036413F, 0xBAAEDCE6AF48A03B,
+                                                 0xFFFFFFFFFFFFFFFE, 0xFFFFFFFFFFFFFFFF};
+  std::array<Scalar, 16> powers;
+  powers[0] = Scalar{1};
+  for (int i = 1; i < 16; ++i) powers[i] = powers[i - 1] * *this;
+  Scalar r{1};
+  for (int bit = 252; bit >= 0; bit -= 4) {
+    for (int i = 0; i < 4; ++i) r = r * r;
+    const int window = static_cast<int>((kExponent[bit / 64] >> (bit % 64)) & 15);
+    if (window != 0) r = r * powers[window];
+  }
+  return r;
+}
+
+inline Scalar Scalar::MulShift384(const Scalar& a, const Scalar& b) {
+  const auto wide = MultiplyWide(a, b);
+  Scalar r{{wide[6], wide[7], 0, 0}};
+  if (wide[5] >> 63) {  // Rounds to nearest.
+    if (++r.d_[0] == 0) ++r.d_[1];
+  }
+  return r;
+}
+
+inline std::pair<Scalar, Scalar> Scalar::SplitLambda(const Scalar& k) {
+  // The constants of the decomposition, as in libsecp256k1: a short lattice basis {(a1, b1),
+  // (a2, b2)} of the kernel of (i, j) -> i + j * lambda, and g1, g2 = round(2^384 * b2 / n),
+  // round(2^384 * -b1 / n).
+  static constexpr Scalar kLambda{{0xDF02967C1B23BD72, 0x122E22EA20816678, 0xA5261C028812645A, 0x5363AD4CC05C30E0}};
+  static constexpr Scalar kMinusB1{{0x6F547FA90ABFE4C3, 0xE4437ED6010E8828, 0, 0}};
+  static constexpr Scalar kMinusB2{{0xD765CDA83DB1562C, 0x8A280AC50774346D, 0xFFFFFFFFFFFFFFFE, 0xFFFFFFFFFFFFFFFF}};
+  static constexpr Scalar kG1{{0xE893209A45DBB031, 0x3DAA8A1471E8CA7F, 0xE86C90E49284EB15, 0x3086D221A7D46BCD}};
+  static constexpr Scalar kG2{{0x1571B4AE8AC47F71, 0x221208AC9DF506C6, 0x6F547FA90ABFE4C4, 0xE4437ED6010E8828}};
+
+  const Scalar c1 = MulShift384(k, kG1);
+  const Scalar c2 = MulShift384(k, kG2);
+  const Scalar k2 = c1 * kMinusB1 + c2 * kMinusB2;
+  const Scalar k1 = k + (k2 * kLambda).Negate();
+  return {k1, k2};
+}
+
+}  // namespace hornet::crypto::secp256k1
@@ -0,0 +1,168 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+// BIP340 Schnorr signatures over secp256k1, with a batch verifier for Taproot key-path spends.
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "hornetlib/crypto/hash.h"
+#include "hornetlib/crypto/secp256k1/ecmult.h"
+#include "hornetlib/crypto/secp256k1/group.h"
+#include "hornetlib/crypto/secp256k1/scalar.h"
+#include "hornetlib/util/parallel_chunks.h"
+
+namespace hornet::crypto::secp256k1 {
+
+namespace detail {
+
+// A signature whose points have been lifted and whose challenge has been computed, so that it
+// remains only to check s * G == R + e * P.
+struct SchnorrEquation {
+  AffinePoint public_key;
+  AffinePoint r;
+  Scalar s;
+  Scalar e;
+};
+
+inline std::optional<SchnorrEquation> ParseSchnorr(std::span<const uint8_t, 32> public_key,
+                                                   std::span<const uint8_t, 32> message,
+                                                   std::span<const uint8_t, 64> signature) {
+  const auto px = FieldElement::FromBytes(public_key);
+  const auto rx = FieldElement::FromBytes(signature.first<32>());
+  if (!px || !rx) return std::nullopt;
+  bool overflow;
+  const Scalar s = Scalar::FromBytes(signature.last<32>(), &overflow);
+  if (overflow) return std::nullopt;
+  const auto p = AffinePoint::FromX(*px, false);
+  if (!p) return std::nullopt;
+  std::array<uint8_t, 96> challenge;
+  std::copy(signature.begin(), signature.begin() + 32, challenge.begin());
+  std::copy(public_key.begin(), public_key.end(), challenge.begin() + 32);
+  std::copy(message.begin(), message.end(), challenge.begin() + 64);
+  const Scalar e = Scalar::FromBytes(TaggedHash("BIP0340/challenge", challenge));
+  // The nonce point is only needed explicitly by the batch verifier.
+  return SchnorrEquation{*p, {*rx, {}}, s, e};
+}
+
+}  // namespace detail
+
+// Verifies a BIP340 signature of a 32-byte message under an x-only public key.
+inline bool VerifySchnorr(std::span<const uint8_t, 32> public_key, std::span<const uint8_t, 32> message,
+                          std::span<const uint8_t, 64> signature) {
+  const auto equation = detail::ParseSchnorr(public_key, message, signature);
+  if (!equation) return false;
+  const Scalar minus_e = equation->e.Negate();
+  const JacobianPoint point = MultiplyAdd(equation->s, {&equation->public_key, 1}, {&minus_e, 1});
+  if (point.IsInfinity()) return false;
+  const AffinePoint r = point.ToAffine();
+  return !r.y.IsOdd() && r.x == equation->r.x;
+}
+
+// Collects BIP340 signatures and verifies them together, checking the single randomized equation
+//   (sum a_i s_i) G - sum a_i R_i - sum (a_i e_i) P_i = 0,
+// which holds for all valid batches and, with overwhelming probability, for no batch containing an
+// invalid signature. The randomizers a_i are derived from a hash of the whole batch, with a_0 = 1.
+// Large batches are split into chunks that are verified on parallel threads.
+//
+// Add may be called concurrently from several threads; Verify reports only whether every signature
+// is valid, so a failed batch must be re-checked individually to find the culprit.
+//
+// Block validation does not use this yet: script checks verify each signature as it is reached, via
+// VerifySchnorr and the signature cache. The class is exercised by its tests and benchmark only.
+class SchnorrBatch {
+ public:
+  static constexpr int kChunkSize = 128;
+
+  // Adds a signature to the batch. Returns false, and marks the batch as failed, if the signature
+  // cannot be valid because it does not parse.
+  bool Add(std::span<const uint8_t, 32> public_key, std::span<const uint8_t, 32> message,
+           std::span<const uint8_t, 64> signature);
+
+  bool Verify() const;
+  size_t Size() const;
+  void Clear();
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<detail::SchnorrEquation> equations_;
+  std::vector<uint8_t> transcript_;
+  bool failed_ = false;
+};
+
+inline bool SchnorrBatch::Add(std::span<const uint8_t, 32> public_key, std::span<const uint8_t, 32> message,
+                              std::span<const uint8_t, 64> signature) {
+  auto equation = detail::ParseSchnorr(public_key, message, signature);
+  if (equation) {
+    const auto r = AffinePoint::FromX(equation->r.x, false);
+    if (r) equation->r = *r;
+    else equation.reset();
+  }
+  std::lock_guard lock(mutex_);
+  if (!equation) {
+    failed_ = true;
+    return false;
+  }
+  equations_.push_back(*equation);
+  transcript_.insert(transcript_.end(), public_key.begin(), public_key.end());
+  transcript_.insert(transcript_.end(), message.begin(), message.end());
+  transcript_.insert(transcript_.end(), signature.begin(), signature.end());
+  return true;
+}
+
+inline bool SchnorrBatch::Verify() const {
+  std::lock_guard lock(mutex_);
+  if (failed_) return false;
+  const int count = static_cast<int>(equations_.size());
+  const bytes32_t seed = TaggedHash("Hornet/batch", transcript_);
+  std::atomic<bool> valid = true;
+  util::ParallelChunks(count, kChunkSize, [&](int, int begin, int end) {
+    // Splits the chunk further so that each multi-scalar multiplication stays cache-friendly.
+    for (int first = begin; first < end && valid; first += kChunkSize) {
+      const int last = std::min(end, first + kChunkSize);
+      std::vector<AffinePoint> points;
+      std::vector<Scalar> scalars;
+      points.reserve(2 * (last - first));
+      scalars.reserve(2 * (last - first));
+      Scalar g_scalar;
+      for (int i = first; i < last; ++i) {
+        const detail::SchnorrEquation& equation = equations_[i];
+        Scalar a{1};
+        if (i > 0) {
+          std::array<uint8_t, 36> input;
+          std::copy(seed.begin(), seed.end(), input.begin());
+          for (int b = 0; b < 4; ++b) input[32 + b] = static_cast<uint8_t>(i >> (8 * b));
+          a = Scalar::FromBytes(Sha256(input));
+        }
+        g_scalar = g_scalar + a * equation.s;
+        points.push_back(equation.r);
+        scalars.push_back(a.Negate());
+        points.push_back(equation.public_key);
+        scalars.push_back((a * equation.e).Negate());
+      }
+      if (!MultiplyAdd(g_scalar, points, scalars).IsInfinity()) valid = false;
+    }
+  });
+  return valid;
+}
+
+inline size_t SchnorrBatch::Size() const {
+  std::lock_guard lock(mutex_);
+  return equations_.size();
+}
+
+inline void SchnorrBatch::Clear() {
+  std::lock_guard lock(mutex_);
+  equations_.clear();
+  transcript_.clear();
+  failed_ = false;
+}
+
+}  // namespace hornet::crypto::secp256k1
@@ -0,0 +1,184 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+
+#include "hornetlib/crypto/hash.h"
+#include "hornetlib/crypto/sha256.h"
+#include "hornetlib/util/rand.h"
+
+namespace hornet::crypto::secp256k1 {
+
+// A fixed-size cache of signatures that have already been verified, keyed by a salted hash of the
+// signature scheme, message, public key and signature. Lookups and inserts are lock-free.
+//
+// Each slot holds a 128-bit fingerprint of the salted hash, and an entry may live in any of kWays
+// slots derived from its fingerprint, as in a cuckoo hash table. An insert into a full set of slots
+// displaces an occupant into one of its own alternative slots, for up to kMaxDisplacements moves,
+// after which the last displaced entry is dropped. Concurrent inserts may also drop or duplicate
+// entries, which costs only a future miss. A fingerprint is written as two 64-bit halves, so a
+// racing reader may see a torn slot, but a torn slot can match only a key that agrees in 64 bits with
+// each of two verified entries, which the secret salt makes infeasible to arrange.
+class SignatureCache {
+ public:
+  enum class Scheme : uint8_t { Ecdsa = 0, Schnorr = 1 };
+
+  struct Key {
+    uint64_t lo;
+    uint64_t hi;
+  };
+
+  struct Stats {
+    uint64_t lookups = 0;
+    uint64_t hits = 0;
+    uint64_t inserts = 0;
+
+    double HitRate() const { return lookups == 0 ? 0.0 : double(hits) / lookups; }
+  };
+
+  static constexpr int kWays = 8;
+  static constexpr int kMaxDisplacements = 8;
+  static constexpr size_t kDefaultSizeBytes = size_t{32} << 20;
+
+  explicit SignatureCache(size_t max_bytes = kDefaultSizeBytes);
+
+  // The process-wide cache consulted by the script runtime.
+  static SignatureCache& Global();
+
+  // Discards all entries and reallocates within the given memory budget. Not safe to call
+  // concurrently with lookups or inserts.
+  void Resize(size_t max_bytes);
+
+  Key MakeKey(Scheme scheme, std::span<const uint8_t> message, std::span<const uint8_t> public_key,
+              std::span<const uint8_t> signature) const;
+
+  bool Contains(const Key& key);
+  void Insert(Key key);
+
+  size_t SizeBytes() const { return 2 * sizeof(uint64_t) * slot_count_; }
+  Stats GetStats() const;
+
+ private:
+  std::array<size_t, kWays> GetSlots(const Key& key) const;
+  Key Load(size_t slot) const;
+  void Store(size_t slot, const Key& key);
+
+  std::array<uint8_t, 32> salt_;
+  size_t slot_count_ = 0;
+  int slot_bits_ = 0;
+  std::unique_ptr<std::atomic<uint64_t>[]> slots_;  // Two words per slot; zero marks empty.
+  std::atomic<uint64_t> lookups_ = 0;
+  std::atomic<uint64_t> hits_ = 0;
+  std::atomic<uint64_t> inserts_ = 0;
+};
+
+inline SignatureCache::SignatureCache(size_t max_bytes) {
+  for (int i = 0; i < 4; ++i) {
+    const uint64_t random = util::Rand64();
+    std::memcpy(&salt_[8 * i], &random, sizeof(random));
+  }
+  Resize(max_bytes);
+}
+
+inline SignatureCache& SignatureCache::Global() {
+  static SignatureCache cache;
+  return cache;
+}
+
+inline void SignatureCache::Resize(size_t max_bytes) {
+  slot_count_ = std::bit_floor(std::max<size_t>(max_bytes / (2 * sizeof(uint64_t)), kWays));
+  slot_bits_ = std::countr_zero(slot_count_);
+  slots_ = std::make_unique<std::atomic<uint64_t>[]>(2 * slot_count_);
+  for (size_t i = 0; i < 2 * slot_count_; ++i) slots_[i].store(0, std::memory_order_relaxed);
+}
+
+inline SignatureCache::Key SignatureCache::MakeKey(Scheme scheme, std::span<const uint8_t> message,
+                                                   std::span<const uint8_t> public_key,
+                                                   std::span<const uint8_t> signature) const {
+  // Lengths are encoded so that the fields cannot run into one another. Signatures parsed laxly may
+  // be of any length, so the fields are hashed in turn rather than gathered into a fixed buffer.
+  const auto length = [](std::span<const uint8_t> bytes) {
+    const uint32_t size = static_cast<uint32_t>(bytes.size());
+    return std::array<uint8_t, 4>{static_cast<uint8_t>(size), static_cast<uint8_t>(size >> 8),
+                                  static_cast<uint8_t>(size >> 16), static_cast<uint8_t>(size >> 24)};
+  };
+  const std::array<uint8_t, 1> tag = {static_cast<uint8_t>(scheme)};
+  SHA256::Context context;
+  context.Update(salt_).Update(tag);
+  for (const auto field : {message, public_key, signature}) context.Update(length(field)).Update(field);
+  const bytes32_t hash = context.Final();
+  Key key;
+  std::memcpy(&key.lo, &hash[0], sizeof(key.lo));
+  std::memcpy(&key.hi, &hash[8], sizeof(key.hi));
+  key.lo |= 1;  // Never zero, which marks an empty slot.
+  return key;
+}
+
+// Derives the slots by double hashing with an odd stride, then multiply-shift into the table.
+inline std::array<size_t, SignatureCache::kWays> SignatureCache::GetSlots(const Key& key) const {
+  std::array<size_t, kWays> slots;
+  const uint64_t stride = key.hi | 1;
+  for (int i = 0; i < kWays; ++i) {
+    const uint64_t hash = (key.lo + i * stride) * 0x9E3779B97F4A7C15;
+    slots[i] = slot_bits_ == 0 ? 0 : static_cast<size_t>(hash >> (64 - slot_bits_));
+  }
+  return slots;
+}
+
+inline SignatureCache::Key SignatureCache::Load(size_t slot) const {
+  return {slots_[2 * slot].load(std::memory_order_relaxed), slots_[2 * slot + 1].load(std::memory_order_relaxed)};
+}
+
+inline void SignatureCache::Store(size_t slot, const Key& key) {
+  slots_[2 * slot].store(key.lo, std::memory_order_relaxed);
+  slots_[2 * slot + 1].store(key.hi, std::memory_order_relaxed);
+}
+
+inline bool SignatureCache::Contains(const Key& key) {
+  lookups_.fetch_add(1, std::memory_order_relaxed);
+  for (const size_t slot : GetSlots(key)) {
+    const Key stored = Load(slot);
+    if (stored.lo == key.lo && stored.hi == key.hi) {
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+inline void SignatureCache::Insert(Key key) {
+  inserts_.fetch_add(1, std::memory_order_relaxed);
+  for (int move = 0; move <= kMaxDisplacements; ++move) {
+    const auto slots = GetSlots(key);
+    for (const size_t slot : slots) {
+      const Key stored = Load(slot);
+      if (stored.lo == 0 || (stored.lo == key.lo && stored.hi == key.hi)) {
+        Store(slot, key);
+        return;
+      }
+    }
+    // Every slot is taken, so evicts an occupant and tries to re-home it instead.
+    const size_t victim = slots[move % kWays];
+    const Key evicted = Load(victim);
+    Store(victim, key);
+    if (evicted.lo == 0) return;
+    key = evicted;
+  }
+}
+
+inline SignatureCache::Stats SignatureCache::GetStats() const {
+  return {lookups_.load(std::memory_order_relaxed), hits_.load(std::memory_order_relaxed),
+          inserts_.load(std::memory_order_relaxed)};
+}
+
+}  // namespace hornet::crypto::secp256k1
@@ -11,9 +11,18 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <ostream>
 #include <span>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HORNET_SHA256_SHANI 1
+#elif defined(__aarch64__) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#include <arm_neon.h>
+#define HORNET_SHA256_ARMV8 1
+#endif
+
 namespace hornet::crypto {
 
 namespace SHA256 {
@@ -21,6 +30,39 @@ using hash256_t = std::array<uint8_t, 32>;
 
 // Compute the SHA-256 hash of an arbitrary byte stream
 hash256_t Hash(std::span<const uint8_t> bytes);
+
+// The implementations of the block compression function, chosen once per process.
+enum class Kernel { Scalar, ShaNi, ArmV8 };
+
+// Returns the fastest kernel supported by this CPU.
+Kernel GetKernel();
+
+// Returns true if the kernel can run on this CPU.
+bool IsSupported(Kernel kernel);
+
+// Computes a SHA-256 hash incrementally over a stream of bytes, so that the stream need not be
+// contiguous in memory.
+class Context {
+ public:
+  explicit Context(Kernel kernel = GetKernel());
+
+  // Starts a new stream.
+  void Init();
+
+  // Appends bytes to the stream.
+  Context& Update(std::span<const uint8_t> bytes);
+
+  // Returns the hash of the stream. Init must be called before the context is reused.
+  hash256_t Final();
+
+ private:
+  using CompressFunc = void (*)(std::array<uint32_t, 8>& state, const uint8_t* blocks, size_t count);
+
+  CompressFunc compress_;
+  std::array<uint32_t, 8> state_;
+  std::array<uint8_t, 64> buffer_;
+  uint64_t length_;  // The number of bytes appended so far.
+};
 }  // namespace SHA256
 
 /* Implementation follows */
@@ -44,12 +86,12 @@ using Schedule = std::array<uint32_t, 64>;
 using Block = std::array<uint32_t, 16>;  // 512-bit message block
 
 template <uint8_t Count>
-inline uint32_t ROTR(uint32_t x) {
+constexpr uint32_t ROTR(uint32_t x) {
   return (x >> Count) | (x << (32 - Count));
 }
 
 template <uint8_t Count>
-inline uint32_t SHR(uint32_t x) {
+constexpr uint32_t SHR(uint32_t x) {
   return x >> Count;
 }
 
@@ -69,29 +111,18 @@ inline uint32_t Sigma_1(uint32_t x) {
   return ROTR<6>(x) ^ ROTR<11>(x) ^ ROTR<25>(x);
 }
 
-inline uint32_t sigma_0(uint32_t x) {
+constexpr uint32_t sigma_0(uint32_t x) {
   return ROTR<7>(x) ^ ROTR<18>(x) ^ SHR<3>(x);
 }
 
-inline uint32_t sigma_1(uint32_t x) {
+constexpr uint32_t sigma_1(uint32_t x) {
   return ROTR<17>(x) ^ ROTR<19>(x) ^ SHR<10>(x);
 }
 
-inline uint32_t ReverseEndianByteIndex(uint32_t index) {
-  return (index & ~3u) | (3u - (index & 3u));
-}
-
-inline uint32_t ReverseEndianWord(uint32_t x) {
+constexpr uint32_t ReverseEndianWord(uint32_t x) {
   return (x << 24u) | ((x & 0x0000FF00) << 8) | ((x & 0x00FF0000) >> 8) | (x >> 24);
 }
 
-inline hash256_t ReverseEndianWords(const uint256_t &words) {
-  hash256_t rv;
-  uint32_t *output = reinterpret_cast<uint32_t *>(&rv[0]);
-  for (unsigned int i = 0; i < 8; ++i) output[i] = ReverseEndianWord(words[i]);
-  return rv;
-}
-
 inline void Process16WordBlock(const uint32_t *M, Schedule &W, uint256_t &H) {
   // Prepare the message schedule {W_t}
   for (uint8_t t = 0; t < 16; ++t) W[t] = M[t];
@@ -124,65 +155,172 @@ inline void Process16WordBlock(const uint32_t *M, Schedule &W, uint256_t &H) {
   H[6] += g;
   H[7] += h;
 }
+// Compresses count consecutive 64-byte blocks into the state.
+inline void CompressScalar(uint256_t &H, const uint8_t *blocks, size_t count) {
+  Schedule W;
+  Block M;
+  for (; count > 0; --count, blocks += 64) {
+    // The spec expects big-endian words, e.g. the byte stream "abcd" becomes 0x61626364.
+    std::memcpy(M.data(), blocks, sizeof(M));
+    for (uint32_t &word : M) word = ReverseEndianWord(word);
+    Process16WordBlock(M.data(), W, H);
+  }
+}
+
+#ifdef HORNET_SHA256_SHANI
+// Runs rounds 4g to 4g+3, given the message words w for those rounds. Also advances the message
+// schedule: the words for rounds 4g+4 to 4g+7 into next, and the first half of the words for
+// rounds 4g+12 to 4g+15 into prev.
+[[gnu::target("sha,sse4.1"), gnu::always_inline]] inline void ShaNiQuadRound(
+    __m128i &state0, __m128i &state1, const __m128i &w, __m128i &next, __m128i &prev, int g) {
+  __m128i kw = _mm_add_epi32(w, _mm_loadu_si128(reinterpret_cast<const __m128i *>(&s_K[4 * g])));
+  state1 = _mm_sha256rnds2_epu32(state1, state0, kw);
+  if (g >= 3 && g <= 14) next = _mm_sha256msg2_epu32(_mm_add_epi32(next, _mm_alignr_epi8(w, prev, 4)), w);
+  kw = _mm_shuffle_epi32(kw, 0x0E);
+  state0 = _mm_sha256rnds2_epu32(state0, state1, kw);
+  if (g >= 1 && g <= 12) prev = _mm_sha256msg1_epu32(prev, w);
+}
+
+// Compresses blocks with the x86 SHA extensions, which hold the state as ABEF and CDGH.
+[[gnu::target("sha,sse4.1")]] inline void CompressShaNi(uint256_t &H, const uint8_t *blocks,
+                                                         size_t count) {
+  const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  const __m128i dcba = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&H[0])), 0xB1);
+  const __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&H[4])), 0x1B);
+  __m128i state0 = _mm_alignr_epi8(dcba, efgh, 8);
+  __m128i state1 = _mm_blend_epi16(efgh, dcba, 0xF0);
+
+  for (; count > 0; --count, blocks += 64) {
+    const __m128i abef = state0, cdgh = state1;
+    __m128i m[4];
+    for (int i = 0; i < 4; ++i)
+      m[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(blocks + 16 * i)), byte_swap);
+    for (int g = 0; g < 16; g += 4) {
+      ShaNiQuadRound(state0, state1, m[0], m[1], m[3], g);
+      ShaNiQuadRound(state0, state1, m[1], m[2], m[0], g + 1);
+      ShaNiQuadRound(state0, state1, m[2], m[3], m[1], g + 2);
+      ShaNiQuadRound(state0, state1, m[3], m[0], m[2], g + 3);
+    }
+    state0 = _mm_add_epi32(state0, abef);
+    state1 = _mm_add_epi32(state1, cdgh);
+  }
+
+  const __m128i feba = _mm_shuffle_epi32(state0, 0x1B);
+  const __m128i dchg = _mm_shuffle_epi32(state1, 0xB1);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(&H[0]), _mm_blend_epi16(feba, dchg, 0xF0));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(&H[4]), _mm_alignr_epi8(dchg, feba, 8));
+}
+#endif
+
+#ifdef HORNET_SHA256_ARMV8
+// Compresses blocks with the ARMv8 SHA2 instructions.
+inline void CompressArmV8(uint256_t &H, const uint8_t *blocks, size_t count) {
+  uint32x4_t state0 = vld1q_u32(&H[0]), state1 = vld1q_u32(&H[4]);
+  for (; count > 0; --count, blocks += 64) {
+    const uint32x4_t abcd = state0, efgh = state1;
+    uint32x4_t m[4];
+    for (int i = 0; i < 4; ++i) m[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 16 * i)));
+    for (int g = 0; g < 16; ++g) {
+      uint32x4_t &w = m[g & 3];
+      const uint32x4_t kw = vaddq_u32(w, vld1q_u32(&s_K[4 * g]));
+      // Advances the schedule to the words for rounds 4g+16 to 4g+19.
+      if (g < 12) w = vsha256su1q_u32(vsha256su0q_u32(w, m[(g + 1) & 3]), m[(g + 2) & 3], m[(g + 3) & 3]);
+      const uint32x4_t prev0 = state0;
+      state0 = vsha256hq_u32(state0, state1, kw);
+      state1 = vsha256h2q_u32(state1, prev0, kw);
+    }
+    state0 = vaddq_u32(state0, abcd);
+    state1 = vaddq_u32(state1, efgh);
+  }
+  vst1q_u32(&H[0], state0);
+  vst1q_u32(&H[4], state1);
+}
+#endif
+
+inline Kernel DetectKernel() {
+#ifdef HORNET_SHA256_SHANI
+  if (__builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1")) return Kernel::ShaNi;
+#endif
+#ifdef HORNET_SHA256_ARMV8
+  return Kernel::ArmV8;
+#endif
+  return Kernel::Scalar;
+}
+
 }  // namespace Detail
 
-inline hash256_t Hash(std::span<const uint8_t> bytes) {
-  using namespace Detail;
-
-  const uint8_t *const byteStream = bytes.data();
-  const size_t sizeInBytes = bytes.size_bytes();
-  Schedule W;  // Local state
-  uint256_t H = s_initialHash;
-  size_t bytesProcessed = 0;
-  std::array<uint32_t, 32> localWords;
-  constexpr size_t wordsPerBlock = 16;
-  constexpr size_t bytesPerBlock = wordsPerBlock * sizeof(uint32_t);
-
-  // All the full 512-bit blocks can be processed immediately in streaming
-  // fashion
-  while (sizeInBytes - bytesProcessed >= bytesPerBlock) {
-    // The SHA-256 spec expects words to be organized in big endian format,
-    // so here we convert the byte stream appropriately so that e.g. the byte
-    // stream "abcd" will end up as 0x61626364
-    const uint32_t *pSrcWords = reinterpret_cast<const uint32_t *>(byteStream + bytesProcessed);
-    std::transform(pSrcWords, pSrcWords + wordsPerBlock, &localWords[0],
-                   [](uint32_t x) { return ReverseEndianWord(x); });
-    Process16WordBlock(&localWords[0], W, H);
-    bytesProcessed += bytesPerBlock;
+inline Kernel GetKernel() {
+  static const Kernel kernel = Detail::DetectKernel();
+  return kernel;
+}
+
+inline bool IsSupported(Kernel kernel) {
+  return kernel == Kernel::Scalar || kernel == GetKernel();
+}
+
+inline Context::Context(Kernel kernel) : compress_(Detail::CompressScalar) {
+#ifdef HORNET_SHA256_SHANI
+  if (kernel == Kernel::ShaNi) compress_ = Detail::CompressShaNi;
+#endif
+#ifdef HORNET_SHA256_ARMV8
+  if (kernel == Kernel::ArmV8) compress_ = Detail::CompressArmV8;
+#endif
+  Init();
+}
+
+inline void Context::Init() {
+  state_ = Detail::s_initialHash;
+  length_ = 0;
+}
+
+inline Context &Context::Update(std::span<const uint8_t> bytes) {
+  const uint8_t *data = bytes.data();
+  size_t size = bytes.size();
+  if (size == 0) return *this;
+  const size_t buffered = length_ % 64;
+  length_ += size;
+
+  // Completes a partially buffered block.
+  if (buffered > 0) {
+    const size_t fill = std::min(size, 64 - buffered);
+    std::memcpy(buffer_.data() + buffered, data, fill);
+    if (buffered + fill < 64) return *this;
+    compress_(state_, buffer_.data(), 1);
+    data += fill;
+    size -= fill;
+  }
+
+  // Compresses whole blocks in place, and buffers the remainder.
+  const size_t blocks = size / 64;
+  if (blocks > 0) compress_(state_, data, blocks);
+  std::memcpy(buffer_.data(), data + 64 * blocks, size % 64);
+  return *this;
+}
+
+inline hash256_t Context::Final() {
+  // Appends the one bit, the zero padding, and the big-endian message length in bits.
+  size_t buffered = length_ % 64;
+  buffer_[buffered++] = 0x80;
+  if (buffered > 56) {
+    std::fill(buffer_.begin() + buffered, buffer_.end(), 0);
+    compress_(state_, buffer_.data(), 1);
+    buffered = 0;
+  }
+  std::fill(buffer_.begin() + buffered, buffer_.begin() + 56, 0);
+  const uint64_t bits = length_ << 3;
+  for (int i = 0; i < 8; ++i) buffer_[56 + i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+  compress_(state_, buffer_.data(), 1);
+
+  hash256_t hash;
+  for (int i = 0; i < 8; ++i) {
+    const uint32_t word = Detail::ReverseEndianWord(state_[i]);
+    std::memcpy(&hash[4 * i], &word, sizeof(word));
   }
+  return hash;
+}
 
-  // Initialize blocks to zero bits
-  std::fill(localWords.begin(), localWords.end(), 0);
-  uint8_t *localBytes = reinterpret_cast<uint8_t *>(&localWords[0]);
-  const uint32_t bytesRemaining = static_cast<uint32_t>(sizeInBytes - bytesProcessed);
-
-  // Copy the message data while reversing endian-ness
-  for (uint32_t iByte = 0; iByte < bytesRemaining; ++iByte)
-    localBytes[ReverseEndianByteIndex(iByte)] = byteStream[bytesProcessed + iByte];
-
-  // Add the one bit after lBits of message data
-  localBytes[ReverseEndianByteIndex(bytesRemaining)] = 0x80;
-
-  // Add the message size in bits
-  const uint32_t lBits = bytesRemaining << 3;  // l bits of the message remaining
-  const uint32_t zeroBits = lBits <= 447
-                                ? 447 - lBits
-                                : 512 + 447 - lBits;  // k zero bits where l + 1 + k = 448 (mod 512)
-  const uint32_t messageSizeWordPos =
-      (lBits + 1 + zeroBits) >> 5;  // The message size goes after the zero padding bits
-  const uint64_t messageSizeInBits = sizeInBytes << 3;
-  const uint32_t messageSizeLoWord = static_cast<uint32_t>(messageSizeInBits);
-  const uint32_t messageSizeHiWord = static_cast<uint32_t>(messageSizeInBits >> 32);
-  localWords[messageSizeWordPos] = messageSizeHiWord;
-  localWords[messageSizeWordPos + 1] = messageSizeLoWord;
-
-  // Process the remaining blocks
-  Process16WordBlock(&localWords[0], W, H);
-  if (lBits >= 448)  // messageSizeWordPos + 1 >= 16
-    Process16WordBlock(&localWords[16], W, H);
-
-  // Return the final hash value
-  return ReverseEndianWords(H);
+inline hash256_t Hash(std::span<const uint8_t> bytes) {
+  return Context{}.Update(bytes).Final();
 }
 
 }  // namespace SHA256
@@ -0,0 +1,256 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+// Multi-lane SHA-256 of fixed-length messages: the double SHA-256 of 64-byte messages, as hashed
+// for every node of a Merkle tree, and the SHA-256 of 32-byte messages, as hashed for the outer
+// half of a double SHA-256. Each kernel hashes 4, 8 or 16 messages at once, one message per 32-bit
+// SIMD lane, and the widest kernel supported by the CPU is selected at runtime.
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "hornetlib/crypto/sha256.h"
+
+namespace hornet::crypto {
+
+namespace SHA256 {
+
+enum class BatchKernel { Scalar, Sse41, Avx2, Avx512 };
+
+// Returns the widest kernel supported by this CPU.
+BatchKernel GetBatchKernel();
+
+// Returns true if the kernel can run on this CPU.
+bool IsSupported(BatchKernel kernel);
+
+// Writes SHA256(SHA256(m)) for count 64-byte messages m, spaced input_stride bytes apart, to
+// digests spaced output_stride bytes apart. The digests may overwrite the messages in place, i.e.
+// output == input, provided that output_stride <= input_stride.
+void DoubleHash64(const uint8_t* input, int input_stride, int count, uint8_t* output,
+                  int output_stride, BatchKernel kernel = GetBatchKernel());
+
+// Writes SHA256(m) for count 32-byte messages m, e.g. the outer hash of a double SHA-256, on the
+// same terms as DoubleHash64.
+void Hash32(const uint8_t* input, int input_stride, int count, uint8_t* output, int output_stride,
+            BatchKernel kernel = GetBatchKernel());
+
+}  // namespace SHA256
+
+/* Implementation follows */
+
+namespace SHA256 {
+namespace Detail {
+
+// Returns the round constants plus the message schedule of the padding block that follows a
+// 64-byte message, which is the same for every message.
+constexpr std::array<uint32_t, 64> MakePadding64Schedule() {
+  std::array<uint32_t, 64> w = {0x80000000};
+  w[15] = 512;
+  for (int t = 16; t < 64; ++t)
+    w[t] = sigma_1(w[t - 2]) + w[t - 7] + sigma_0(w[t - 15]) + w[t - 16];
+  for (int t = 0; t < 64; ++t) w[t] += s_K[t];
+  return w;
+}
+static constexpr std::array<uint32_t, 64> s_padding64KW = MakePadding64Schedule();
+
+// The lane kernels below are generic over a GCC/Clang vector of 32-bit lanes. They take their
+// vectors by reference and are always inlined, so that no vector crosses a call boundary outside
+// the target-specific functions that instantiate them.
+
+template <typename V>
+[[gnu::always_inline]] inline void Round(const V& a, const V& b, const V& c, V& d, const V& e,
+                                         const V& f, const V& g, V& h, const V& kw) {
+  const V s1 = ((e >> 6) | (e << 26)) ^ ((e >> 11) | (e << 21)) ^ ((e >> 25) | (e << 7));
+  const V s0 = ((a >> 2) | (a << 30)) ^ ((a >> 13) | (a << 19)) ^ ((a >> 22) | (a << 10));
+  const V t1 = h + s1 + ((e & f) ^ (~e & g)) + kw;
+  const V t2 = s0 + ((a & b) ^ (a & c) ^ (b & c));
+  d += t1;
+  h = t1 + t2;
+}
+
+// Extends the rolling message schedule w to round t >= 16.
+template <typename V>
+[[gnu::always_inline]] inline void Expand(V (&w)[16], int t) {
+  const V& w2 = w[(t - 2) & 15];
+  const V& w15 = w[(t - 15) & 15];
+  w[t & 15] += (((w2 >> 17) | (w2 << 15)) ^ ((w2 >> 19) | (w2 << 13)) ^ (w2 >> 10)) +
+               w[(t - 7) & 15] + (((w15 >> 7) | (w15 << 25)) ^ ((w15 >> 18) | (w15 << 14)) ^ (w15 >> 3));
+}
+
+// Writes round t's constant plus schedule word to kw. The schedule is either the rolling message
+// schedule w, or else the precomputed schedule of the padding block of a 64-byte message.
+template <typename V, bool kPadding64>
+[[gnu::always_inline]] inline void NextKW(V (&w)[16], int t, V& kw) {
+  if constexpr (kPadding64) {
+    kw = V{} + s_padding64KW[t];
+  } else {
+    if (t >= 16) Expand(w, t);
+    kw = w[t & 15] + s_K[t];
+  }
+}
+
+// Runs the 64 rounds over the state, then adds the result into the state.
+template <typename V, bool kPadding64>
+[[gnu::always_inline]] inline void Compress(V (&state)[8], V (&w)[16]) {
+  V a = state[0], b = state[1], c = state[2], d = state[3];
+  V e = state[4], f = state[5], g = state[6], h = state[7];
+  V kw;
+  for (int t = 0; t < 64; t += 8) {
+    NextKW<V, kPadding64>(w, t, kw);
+    Round(a, b, c, d, e, f, g, h, kw);
+    NextKW<V, kPadding64>(w, t + 1, kw);
+    Round(h, a, b, c, d, e, f, g, kw);
+    NextKW<V, kPadding64>(w, t + 2, kw);
+    Round(g, h, a, b, c, d, e, f, kw);
+    NextKW<V, kPadding64>(w, t + 3, kw);
+    Round(f, g, h, a, b, c, d, e, kw);
+    NextKW<V, kPadding64>(w, t + 4, kw);
+    Round(e, f, g, h, a, b, c, d, kw);
+    NextKW<V, kPadding64>(w, t + 5, kw);
+    Round(d, e, f, g, h, a, b, c, kw);
+    NextKW<V, kPadding64>(w, t + 6, kw);
+    Round(c, d, e, f, g, h, a, b, kw);
+    NextKW<V, kPadding64>(w, t + 7, kw);
+    Round(b, c, d, e, f, g, h, a, kw);
+  }
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+// Hashes the 32-byte messages held in w[0] to w[7] into the state, as a single padded block.
+template <typename V>
+[[gnu::always_inline]] inline void Hash32Block(V (&w)[16], V (&state)[8]) {
+  for (int i = 0; i < 8; ++i) state[i] = V{} + s_initialHash[i];
+  w[8] = V{} + 0x80000000u;
+  for (int i = 9; i < 15; ++i) w[i] = V{};
+  w[15] = V{} + 256u;
+  Compress<V, false>(state, w);
+}
+
+enum class BatchOp { DoubleHash64, Hash32 };
+
+template <typename V, BatchOp kOp>
+[[gnu::always_inline]] inline void HashLanes(const uint8_t* input, int input_stride, uint8_t* output,
+                                             int output_stride) {
+  constexpr int kLanes = sizeof(V) / sizeof(uint32_t);
+  constexpr int kWords = kOp == BatchOp::DoubleHash64 ? 16 : 8;
+
+  // Transposes the messages so that each vector holds one big-endian word of every message.
+  V w[16];
+  for (int i = 0; i < kWords; ++i)
+    for (int j = 0; j < kLanes; ++j) {
+      uint32_t word;
+      std::memcpy(&word, input + j * input_stride + 4 * i, sizeof(word));
+      w[i][j] = ReverseEndianWord(word);
+    }
+
+  V state[8];
+  if constexpr (kOp == BatchOp::DoubleHash64) {
+    // First hash: the message block, then the constant padding block.
+    for (int i = 0; i < 8; ++i) state[i] = V{} + s_initialHash[i];
+    Compress<V, false>(state, w);
+    Compress<V, true>(state, w);
+    for (int i = 0; i < 8; ++i) w[i] = state[i];
+  }
+  Hash32Block(w, state);
+
+  // Loads every message before storing any digest, so the digests can overwrite the messages.
+  for (int j = 0; j < kLanes; ++j)
+    for (int i = 0; i < 8; ++i) {
+      const uint32_t word = ReverseEndianWord(state[i][j]);
+      std::memcpy(output + j * output_stride + 4 * i, &word, sizeof(word));
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HORNET_SHA256_BATCH_X86 1
+
+using Lanes4 = uint32_t __attribute__((vector_size(16)));
+using Lanes8 = uint32_t __attribute__((vector_size(32)));
+using Lanes16 = uint32_t __attribute__((vector_size(64)));
+
+template <BatchOp kOp>
+[[gnu::target("sse4.1")]] inline void HashLanes4(const uint8_t* input, int input_stride,
+                                                  uint8_t* output, int output_stride) {
+  HashLanes<Lanes4, kOp>(input, input_stride, output, output_stride);
+}
+
+template <BatchOp kOp>
+[[gnu::target("avx2")]] inline void HashLanes8(const uint8_t* input, int input_stride,
+                                                uint8_t* output, int output_stride) {
+  HashLanes<Lanes8, kOp>(input, input_stride, output, output_stride);
+}
+
+template <BatchOp kOp>
+[[gnu::target("avx512f")]] inline void HashLanes16(const uint8_t* input, int input_stride,
+                                                    uint8_t* output, int output_stride) {
+  HashLanes<Lanes16, kOp>(input, input_stride, output, output_stride);
+}
+#endif
+
+template <BatchOp kOp>
+inline void HashBatch(const uint8_t* input, int input_stride, int count, uint8_t* output,
+                      int output_stride, BatchKernel kernel) {
+  int i = 0;
+  const auto run = [&](int lanes, auto lanes_func) {
+    for (; count - i >= lanes; i += lanes)
+      lanes_func(input + i * input_stride, input_stride, output + i * output_stride, output_stride);
+  };
+
+  // Runs the widest permitted kernel, then narrower ones over the remainder.
+#ifdef HORNET_SHA256_BATCH_X86
+  if (kernel >= BatchKernel::Avx512) run(16, HashLanes16<kOp>);
+  if (kernel >= BatchKernel::Avx2) run(8, HashLanes8<kOp>);
+  if (kernel >= BatchKernel::Sse41) run(4, HashLanes4<kOp>);
+#endif
+  for (; i < count; ++i) {
+    const uint8_t* message = input + i * input_stride;
+    const hash256_t digest =
+        kOp == BatchOp::DoubleHash64 ? SHA256::Hash(SHA256::Hash({message, 64})) : SHA256::Hash({message, 32});
+    std::memcpy(output + i * output_stride, digest.data(), digest.size());
+  }
+}
+
+inline BatchKernel DetectBatchKernel() {
+#ifdef HORNET_SHA256_BATCH_X86
+  if (__builtin_cpu_supports("avx512f")) return BatchKernel::Avx512;
+  if (__builtin_cpu_supports("avx2")) return BatchKernel::Avx2;
+  if (__builtin_cpu_supports("sse4.1")) return BatchKernel::Sse41;
+#endif
+  return BatchKernel::Scalar;
+}
+
+}  // namespace Detail
+
+inline BatchKernel GetBatchKernel() {
+  static const BatchKernel kernel = Detail::DetectBatchKernel();
+  return kernel;
+}
+
+inline bool IsSupported(BatchKernel kernel) {
+  return static_cast<int>(kernel) <= static_cast<int>(GetBatchKernel());
+}
+
+inline void DoubleHash64(const uint8_t* input, int input_stride, int count, uint8_t* output,
+                         int output_stride, BatchKernel kernel) {
+  Detail::HashBatch<Detail::BatchOp::DoubleHash64>(input, input_stride, count, output, output_stride, kernel);
+}
+
+inline void Hash32(const uint8_t* input, int input_stride, int count, uint8_t* output,
+                   int output_stride, BatchKernel kernel) {
+  Detail::HashBatch<Detail::BatchOp::Hash32>(input, input_stride, count, output, output_stride, kernel);
+}
+
+}  // namespace SHA256
+
+}  // namespace hornet::crypto
@@ -147,8 +147,8 @@ class HashedTree {
 
       // Delete the current node
       const auto map_it = map_.find(node->hash);
-      map_.erase(map_it);
       list_.erase(map_it->second);
+      map_.erase(map_it);
     }
   }
 
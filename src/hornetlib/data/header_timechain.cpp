@@ -121,6 +121,11 @@ std::unique_ptr<HeaderTimechain::ValidationView> HeaderTimechain::GetValidationV
   return std::make_unique<HeaderTimechain::ValidationView>(*this, tip);
 }
 
+std::unique_ptr<HeaderTimechain::ValidationView> HeaderTimechain::GetValidationView(
+    ConstIterator tip) const {
+  return std::make_unique<HeaderTimechain::ValidationView>(*this, tip);
+}
+
 HeaderTimechain::ConstIterator HeaderTimechain::MakeContextIterator(ConstFindResult find) const {
   return {find.first, find.second ? *find.second : HeaderContext{}, GetPolicy()};
 }
@@ -167,4 +172,10 @@ std::vector<uint32_t> HeaderTimechain::ValidationView::LastNTimestamps(int count
   return result;
 }
 
+uint32_t HeaderTimechain::ValidationView::MedianTimePast() const {
+  static_assert(model::TimestampWindow::kCapacity == consensus::constants::kBlocksForMedianTime);
+  if (median_time_past_) return *median_time_past_;
+  return HeaderAncestryView::MedianTimePast();
+}
+
 }  // namespace hornet::data
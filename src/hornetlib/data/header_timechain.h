@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "hornetlib/consensus/header_ancestry_view.h"
@@ -39,6 +40,7 @@ class HeaderTimechain : public ChainTree<protocol::BlockHeader, model::HeaderCon
   Iterator ChainTip();
   const protocol::Hash& GetChainHash(int height) const;
   std::unique_ptr<ValidationView> GetValidationView(BaseConstIterator tip) const;
+  std::unique_ptr<ValidationView> GetValidationView(ConstIterator tip) const;
   std::optional<Locator> MakeLocator(int height, const protocol::Hash& hash) const;
   BaseConstIterator FindStable(int height, const protocol::Hash& hash) const;
 
@@ -144,17 +146,27 @@ class HeaderTimechain::ValidationView : public consensus::HeaderAncestryView {
  public:
   ValidationView(const HeaderTimechain& timechain, BaseConstIterator tip)
       : timechain_(timechain), tip_(tip) {}
+  ValidationView(const HeaderTimechain& timechain, ConstIterator tip)
+      : timechain_(timechain), tip_(tip), median_time_past_(tip->MedianTimePast()) {}
 
   void SetTip(BaseConstIterator tip) {
     tip_ = tip;
+    median_time_past_.reset();
+  }
+  // Takes the median time past from the tip's context, when it has one, rather than walking back.
+  void SetTip(ConstIterator tip) {
+    tip_ = tip;
+    median_time_past_ = tip->MedianTimePast();
   }
   virtual int Length() const override;
   virtual uint32_t TimestampAt(int height) const override;
   virtual std::vector<uint32_t> LastNTimestamps(int count) const override;
+  virtual uint32_t MedianTimePast() const override;
 
  private:
   const HeaderTimechain& timechain_;
   BaseConstIterator tip_;
+  std::optional<uint32_t> median_time_past_;
 };
 
 }  // namespace hornet::data
@@ -14,8 +14,10 @@ class AtomicVector {
   using Ptr = std::shared_ptr<const T>;
   using Container = std::vector<Ptr>;
   using Writer = typename SingleWriter<Container>::Writer;
+  using View = typename SingleWriter<Container>::View;
 
-  [[nodiscard]] std::shared_ptr<const Container> Snapshot() const noexcept {
+  // Returns an epoch-protected view of the current vector. Hold it only for the duration of a read.
+  [[nodiscard]] View Snapshot() const noexcept {
     return vector_.Snapshot();
   }
 
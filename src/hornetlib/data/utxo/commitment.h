@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "hornetlib/crypto/muhash.h"
+#include "hornetlib/data/utxo/index.h"
+#include "hornetlib/data/utxo/types.h"
+#include "hornetlib/protocol/hash.h"
+#include "hornetlib/util/parallel_chunks.h"
+#include "hornetlib/util/throw.h"
+
+namespace hornet::data::utxo {
+
+// A MuHash3072 commitment to the unspent output set, kept as a committed base plus one delta per
+// recent height, so that it can be rewound along with the index and queried at any recent height.
+// The set elements are outpoints: a txid commits to its outputs' amounts and scripts, so equal
+// outpoint sets imply equal coin sets, and a spend can be divided out knowing only its prevout.
+class Commitment {
+ public:
+  // Returns the product of the group elements of the given outpoints. Large batches are split
+  // into chunks that are multiplied on separate threads.
+  static crypto::Num3072 Product(std::span<const OutputKey> keys);
+
+  // Records the outputs created and spent by the block at the given height.
+  void Append(int height, std::span<const OutputKey> added, std::span<const OutputKey> spent);
+
+  // Discards the deltas of all heights greater than or equal to the given height.
+  void EraseSince(int height);
+
+  // Returns the hash of the unspent set after the block at the given height, or nullopt if that
+  // height or a predecessor has not been appended, or it precedes the recent window.
+  std::optional<protocol::Hash> GetHash(int height) const;
+
+ private:
+  static constexpr int kMinChunk = 256;  // Elements per chunk, amortizing the dispatch cost.
+
+  static crypto::Num3072 SerialProduct(std::span<const OutputKey> keys);
+  void Fold();
+
+  mutable std::mutex mutex_;
+  crypto::MuHash3072 base_;  // The set after all heights below base_end_.
+  int base_end_ = 1;         // The genesis block has no spendable outputs.
+  std::map<int, crypto::MuHash3072> deltas_;
+};
+
+/* static */ inline crypto::Num3072 Commitment::SerialProduct(std::span<const OutputKey> keys) {
+  crypto::Num3072 product;
+  std::array<uint8_t, sizeof(protocol::Hash) + sizeof(uint32_t)> element;
+  for (const OutputKey& key : keys) {
+    std::copy(key.hash.begin(), key.hash.end(), element.begin());
+    for (int b = 0; b < 4; ++b) element[sizeof(protocol::Hash) + b] = static_cast<uint8_t>(key.index >> (8 * b));
+    product.Multiply(crypto::MuHash3072::ToNum3072(element));
+  }
+  return product;
+}
+
+/* static */ inline crypto::Num3072 Commitment::Product(std::span<const OutputKey> keys) {
+  const int count = std::ssize(keys);
+  std::vector<crypto::Num3072> partials(util::GetChunkCount(count, kMinChunk));
+  util::ParallelChunks(count, kMinChunk, [&](int chunk, int begin, int end) {
+    partials[chunk] = SerialProduct(keys.subspan(begin, end - begin));
+  });
+  for (size_t t = 1; t < partials.size(); ++t) partials[0].Multiply(partials[t]);
+  return partials[0];
+}
+
+inline void Commitment::Append(int height, std::span<const OutputKey> added, std::span<const OutputKey> spent) {
+  crypto::MuHash3072 delta{Product(added), Product(spent)};
+  std::lock_guard lock(mutex_);
+  if (height < base_end_ || deltas_.contains(height))
+    util::ThrowInvalidArgument("Commitment::Append: Height ", height, " already exists.");
+  deltas_.emplace(height, std::move(delta));
+  Fold();
+}
+
+// Multiplies contiguous deltas that have left the recent window into the base.
+inline void Commitment::Fold() {
+  const int end = deltas_.rbegin()->first + 1 - Index::GetMutableWindow();
+  for (auto it = deltas_.begin(); it != deltas_.end() && it->first == base_end_ && base_end_ < end;) {
+    base_ *= it->second;
+    ++base_end_;
+    it = deltas_.erase(it);
+  }
+}
+
+inline void Commitment::EraseSince(int height) {
+  std::lock_guard lock(mutex_);
+  if (height < base_end_)
+    util::ThrowInvalidArgument("Commitment::EraseSince: Height ", height, " is already committed.");
+  deltas_.erase(deltas_.lower_bound(height), deltas_.end());
+}
+
+inline std::optional<protocol::Hash> Commitment::GetHash(int height) const {
+  crypto::MuHash3072 accumulator;
+  {
+    std::lock_guard lock(mutex_);
+    if (height < base_end_ - 1) return std::nullopt;
+    accumulator = base_;
+    for (int h = base_end_; h <= height; ++h) {
+      const auto it = deltas_.find(h);
+      if (it == deltas_.end()) return std::nullopt;
+      accumulator *= it->second;
+    }
+  }
+  return accumulator.Finalize();
+}
+
+}  // namespace hornet::data::utxo
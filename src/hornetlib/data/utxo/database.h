@@ -1,6 +1,9 @@
 #pragma once
 
+#include "hornetlib/crypto/hash.h"
+#include "hornetlib/data/utxo/commitment.h"
 #include "hornetlib/data/utxo/index.h"
+#include "hornetlib/data/utxo/sort.h"
 #include "hornetlib/data/utxo/table.h"
 #include "hornetlib/data/utxo/tiled_vector.h"
 #include "hornetlib/data/utxo/types.h"
@@ -8,15 +11,21 @@
 #include "hornetlib/protocol/transaction.h"
 #include "hornetlib/util/throw.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <exception>
 #include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <span>
 #include <stdexcept>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace hornet::data::utxo {
@@ -25,7 +34,8 @@ class Database {
  public:
   // Constructs an unspent output database with the given duration (in blocks) as the recent
   // window, i.e. the period during which outputs may be removed before being permanently committed.
-  Database(const std::filesystem::path& folder);
+  // When script_index is true, a secondary index by pubkey script hash is maintained alongside.
+  Database(const std::filesystem::path& folder, bool script_index = false);
 
   static std::vector<OutputKey> ExtractSpentKeys(const protocol::Block& block);
 
@@ -41,6 +51,21 @@ class Database {
 
   QueryResult Query(std::span<const OutputKey> keys, std::span<OutputId> rids, int since, int before) const;
 
+  // Executes the queries of several blocks in one pass over the index. Each request keeps its own
+  // height window, and its result is accumulated into request.result.
+  void QueryBatch(std::span<QueryRequest> requests) const;
+
+  // Returns the outputs unspent before the given height whose pubkey script SHA-256 is one of
+  // script_hashes, ordered by script hash then outpoint. Requires the script index, and sees a
+  // height once every height below it has been appended.
+  std::vector<ScriptKV> QueryScripts(std::span<const protocol::Hash> script_hashes, int before) const;
+
+  bool HasScriptIndex() const { return script_index_ != nullptr; }
+
+  // Returns the MuHash3072 digest of the unspent outpoint set after the block at the given height,
+  // or nullopt if that height is not contiguously appended or precedes the recent window.
+  std::optional<protocol::Hash> GetUtxoHash(int height) const;
+
   // Fetches the output headers and script bytes for each ID.
   int Fetch(std::span<const uint64_t> ids, std::span<OutputDetail> outputs, std::vector<uint8_t>* scripts) const;
 
@@ -65,15 +90,29 @@ class Database {
   }
   static void AppendSpends(const protocol::Block& block, int height, TiledVector<OutputKV>* entries);
 
+  // A height's funded script records, and the outpoints it spends, whose scripts are resolved once
+  // every height below it is in the primary index.
+  struct PendingScripts {
+    TiledVector<ScriptKV> entries;
+    std::vector<OutputKey> spent;
+  };
+  void AppendReadyScripts();
+  void AppendScripts(int height, PendingScripts&& pending);
+
   Table table_;
   Index index_;
+  std::unique_ptr<ScriptIndex> script_index_;
+  std::mutex script_mutex_;  // Serializes appends to the script index, which are made in height order.
+  std::mutex pending_mutex_;
+  std::map<int, PendingScripts> pending_scripts_;
+  Commitment commitment_;
   std::atomic_bool has_fatal_exception_ = false;
   std::exception_ptr fatal_exception_;
   mutable std::shared_mutex mutex_;
 };
 
-inline Database::Database(const std::filesystem::path& folder)
-    : table_(folder) {}
+inline Database::Database(const std::filesystem::path& folder, bool script_index /* = false */)
+    : table_(folder), script_index_(script_index ? std::make_unique<ScriptIndex>() : nullptr) {}
 
 /* static */ inline std::vector<OutputKey> Database::ExtractSpentKeys(const protocol::Block& block) {
   // Sizing pre-pass for single allocation.
@@ -99,6 +138,35 @@ inline QueryResult Database::Query(std::span<const OutputKey> keys,
   return index_.Query(keys, rids, since, before);
 }
 
+inline void Database::QueryBatch(std::span<QueryRequest> requests) const {
+  CheckRethrowFatal();
+  index_.QueryBatch(requests);
+}
+
+// Each key's newest record decides whether it is spent.
+inline std::vector<ScriptKV> Database::QueryScripts(std::span<const protocol::Hash> script_hashes,
+                                                    int before) const {
+  CheckRethrowFatal();
+  if (!script_index_) util::ThrowLogicError("Database::QueryScripts: script index is not enabled.");
+
+  std::vector<protocol::Hash> hashes(script_hashes.begin(), script_hashes.end());
+  std::sort(hashes.begin(), hashes.end());
+  hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+  std::vector<ScriptKV> found = script_index_->Scan(hashes, 0, before);
+  // Records sort by key and then by descending height, so the first of each key is its newest.
+  std::sort(found.begin(), found.end());
+  found.erase(std::unique(found.begin(), found.end(), [](const ScriptKV& lhs, const ScriptKV& rhs) {
+    return lhs.key == rhs.key;
+  }), found.end());
+  std::erase_if(found, [](const ScriptKV& kv) { return kv.IsDelete(); });
+  return found;
+}
+
+inline std::optional<protocol::Hash> Database::GetUtxoHash(int height) const {
+  CheckRethrowFatal();
+  return commitment_.GetHash(height);
+}
+
 inline int Database::Fetch(std::span<const OutputId> rids, std::span<OutputDetail> outputs, std::vector<uint8_t>* scripts) const {
   CheckRethrowFatal();
   return table_.Fetch(rids, outputs, scripts);
@@ -112,14 +180,74 @@ inline void Database::Append(const protocol::Block& block, int height) {
 
   std::shared_lock lock(mutex_);
   auto entries = index_.MakeAppendBuffer();
-  table_.AppendOutputs(block, height, &entries);
+  std::optional<TiledVector<ScriptKV>> script_entries;
+  if (script_index_) script_entries = script_index_->MakeAppendBuffer();
+  table_.AppendOutputs(block, height, &entries, script_entries ? &*script_entries : nullptr);
   AppendSpends(block, height, &entries);
+  std::vector<OutputKey> added, spent;
+  for (const auto& entry : entries) (entry.IsAdd() ? added : spent).push_back(entry.key);
+  commitment_.Append(height, added, spent);
 #if UTXO_LOG
   for (const auto& entry : entries)
     LogDebug() << "Append {" << entry.key.hash << ", " << entry.key.index << "}, height " << entry.Height() << ", " << (entry.IsAdd() ? "+" : "-");
 #endif
-  ParallelSort(entries.begin(), entries.end());
+  if (script_entries) {
+    std::lock_guard pending_lock(pending_mutex_);
+    pending_scripts_.insert_or_assign(height, PendingScripts{std::move(*script_entries), std::move(spent)});
+  }
+  util::ParallelSort(entries.begin(), entries.end());
   index_.Append(std::move(entries), height);
+  if (script_index_) AppendReadyScripts();
+}
+
+// Heights may be appended out of order, but a spent script can only be resolved once the height
+// that funded it is indexed, so each height waits until all below it are present.
+inline void Database::AppendReadyScripts() {
+  std::lock_guard script_lock(script_mutex_);
+  while (true) {
+    decltype(pending_scripts_)::node_type pending;
+    {
+      std::lock_guard pending_lock(pending_mutex_);
+      if (pending_scripts_.empty() || pending_scripts_.begin()->first >= index_.GetContiguousLength()) return;
+      pending = pending_scripts_.extract(pending_scripts_.begin());
+    }
+    AppendScripts(pending.key(), std::move(pending.mapped()));
+  }
+}
+
+// Adds a spent record for each outpoint the height spends, keyed by the hash of the script looked up
+// in the primary index and table, and appends the height's records to the script index as one run.
+inline void Database::AppendScripts(int height, PendingScripts&& pending) {
+  auto& [entries, spent] = pending;
+  Index::SortKeys(spent);
+  std::vector<OutputId> rids(spent.size());
+  index_.Query(spent, rids, 0, height);
+
+  // An output funded earlier in the same block is not visible to the query, but has its own record.
+  std::vector<std::pair<OutputKey, protocol::Hash>> local;
+  for (const auto& entry : entries) local.emplace_back(entry.key.outpoint, entry.key.hash);
+  std::sort(local.begin(), local.end());
+  std::vector<OutputKey> keys;
+  std::vector<OutputId> found;
+  for (int i = 0; i < std::ssize(spent); ++i) {
+    if (rids[i] != kNullOutputId && rids[i] != kSpentOutputId) {
+      keys.push_back(spent[i]);
+      found.push_back(rids[i]);
+      continue;
+    }
+    const auto it = std::lower_bound(local.begin(), local.end(), spent[i],
+                                     [](const auto& lhs, const OutputKey& key) { return lhs.first < key; });
+    if (it != local.end() && it->first == spent[i]) entries.PushBack(ScriptKV::Spent({it->second, spent[i]}, height));
+  }
+
+  SortTogether(found.begin(), found.end(), keys.begin());
+  std::vector<OutputDetail> outputs(found.size());
+  std::vector<uint8_t> scripts;
+  table_.Fetch(found, outputs, &scripts);
+  for (int i = 0; i < std::ssize(found); ++i)
+    entries.PushBack(ScriptKV::Spent({crypto::Sha256(outputs[i].script.Span(scripts)), keys[i]}, height));
+  util::ParallelSort(entries.begin(), entries.end());
+  script_index_->Append(std::move(entries), height);
 }
 
 /* static */ inline void Database::SortKeys(std::span<OutputKey> keys) {
@@ -133,7 +261,13 @@ inline void Database::Append(const protocol::Block& block, int height) {
 inline void Database::EraseSince(int height) {
   CheckRethrowFatal();
   std::unique_lock lock(mutex_);
+  commitment_.EraseSince(height);
   index_.EraseSince(height);
+  if (script_index_) {
+    script_index_->EraseSince(height);
+    std::lock_guard pending_lock(pending_mutex_);
+    pending_scripts_.erase(pending_scripts_.lower_bound(height), pending_scripts_.end());
+  }
   table_.EraseSince(height);
 }
 
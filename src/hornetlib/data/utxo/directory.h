@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 #include <optional>
 #include <tuple>
 #include <vector>
@@ -20,14 +21,17 @@ class Directory {
     return std::ssize(entries_);
   }
   
-  int GetBucket(const OutputKey& key) const {
+  // Buckets on the leading bits of the key's hash, which is the most significant part of its ordering.
+  template <typename Key>
+  int GetBucket(const Key& key) const {
     uint32_t le_word;
     std::memcpy(&le_word, key.hash.data(), sizeof(le_word));
     const uint32_t be_word = __builtin_bswap32(le_word);
     return be_word >> (32 - prefix_bits_);
   }
 
-  std::pair<uint32_t, uint32_t> LookupRange(const OutputKey& key) const {
+  template <typename Key>
+  std::pair<uint32_t, uint32_t> LookupRange(const Key& key) const {
     const int index = GetBucket(key);
     return {entries_[index], entries_[index + 1]};    
   }
@@ -57,7 +61,7 @@ inline void Directory::Rebuild(Iter kv_begin, Iter kv_end) {
   for (int i = 0; i < std::ssize(entries_); ++i) {
     // We want the bucket to index the first kv pair whose key prefix falls into this bucket.
     // If there are no such entries, the bucket is empty.
-    it = std::lower_bound(it, kv_end, i, [&](const OutputKV& kv, int bucket) {
+    it = std::lower_bound(it, kv_end, i, [&](const auto& kv, int bucket) {
       return GetBucket(kv.key) < bucket;
     });
     entries_[i] = it - kv_begin;
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "hornetlib/util/assert.h"
+#include "hornetlib/util/throw.h"
+
+namespace hornet::data::utxo {
+
+// Epoch-based memory reclamation, a user-space RCU.
+//
+// Readers pin the current epoch with a Guard, which costs one store and one fence to a cache line
+// owned by the calling thread, with no shared reference counts. Writers publish a new version and
+// retire the old one, tagged with the epoch in which it was superseded. A retired object is
+// destroyed once every pinned reader has advanced past that epoch, i.e. after a grace period.
+//
+// Guards nest, and must be destroyed on the thread that created them. While any guard is held by a
+// thread, objects retired since it was pinned are kept alive, so guards should be short-lived.
+class Epoch {
+ public:
+  class Guard {
+   public:
+    Guard(Guard&& rhs) noexcept : epoch_(std::exchange(rhs.epoch_, nullptr)) {}
+    Guard& operator=(Guard&&) = delete;
+    ~Guard() {
+      if (epoch_) epoch_->Unpin();
+    }
+
+   private:
+    friend class Epoch;
+    explicit Guard(Epoch* epoch) : epoch_(epoch) {}
+
+    Epoch* epoch_;
+  };
+
+  Epoch(const Epoch&) = delete;
+  Epoch& operator=(const Epoch&) = delete;
+  ~Epoch() {
+    for (auto& item : retired_) item.deleter();
+  }
+
+  // Returns the process-wide epoch domain.
+  static Epoch& Global() {
+    static Epoch instance;
+    return instance;
+  }
+
+  // Pins the current epoch on the calling thread for the lifetime of the returned guard.
+  [[nodiscard]] Guard Pin() {
+    ThreadState& state = GetThreadState();
+    if (state.depth++ == 0) {
+      state.slot->epoch.store(epoch_.load(std::memory_order_acquire), std::memory_order_relaxed);
+      // Orders the slot store before the caller's subsequent loads of published pointers.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    return Guard{this};
+  }
+
+  // Defers the deleter until all readers that may observe the retired object have unpinned.
+  // The caller must already have unlinked the object from any shared location.
+  void Retire(std::function<void()> deleter) {
+    const uint64_t epoch = epoch_.fetch_add(1, std::memory_order_acq_rel);
+    {
+      std::lock_guard lock(mutex_);
+      retired_.push_back({epoch, std::move(deleter)});
+    }
+    Reclaim();
+  }
+
+  // Destroys every retired object whose grace period has elapsed. Returns the number destroyed.
+  int Reclaim() {
+    // Pairs with the fence in Pin: either we observe the reader's slot, or it observes the unlink.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const uint64_t oldest = OldestPinnedEpoch();
+    std::vector<Retired> expired;
+    {
+      std::lock_guard lock(mutex_);
+      const auto it = std::stable_partition(retired_.begin(), retired_.end(), [=](const Retired& item) {
+        return item.epoch >= oldest;
+      });
+      std::move(it, retired_.end(), std::back_inserter(expired));
+      retired_.erase(it, retired_.end());
+    }
+    for (auto& item : expired) item.deleter();
+    return std::ssize(expired);
+  }
+
+  // Returns the number of retired objects still awaiting their grace period.
+  int PendingCount() const {
+    std::lock_guard lock(mutex_);
+    return std::ssize(retired_);
+  }
+
+ private:
+  static constexpr uint64_t kIdle = std::numeric_limits<uint64_t>::max();
+  static constexpr int kMaxThreads = 1'024;
+
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> epoch = kIdle;
+    std::atomic<bool> in_use = false;
+  };
+
+  struct Retired {
+    uint64_t epoch;
+    std::function<void()> deleter;
+  };
+
+  struct ThreadState {
+    Slot* slot = nullptr;
+    int depth = 0;
+    ~ThreadState() {
+      if (slot) {
+        slot->epoch.store(kIdle, std::memory_order_release);
+        slot->in_use.store(false, std::memory_order_release);
+      }
+    }
+  };
+
+  Epoch() = default;
+
+  ThreadState& GetThreadState() {
+    thread_local ThreadState state;
+    if (!state.slot) state.slot = AcquireSlot();
+    return state;
+  }
+
+  Slot* AcquireSlot() {
+    for (int i = 0; i < kMaxThreads; ++i) {
+      bool expected = false;
+      if (!slots_[i].in_use.load(std::memory_order_relaxed) &&
+          slots_[i].in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        // Publishes the slot to Reclaim scans before this thread can pin.
+        int high = high_water_.load();
+        while (high < i + 1 && !high_water_.compare_exchange_weak(high, i + 1));
+        return &slots_[i];
+      }
+    }
+    util::ThrowRuntimeError("Epoch: more than ", kMaxThreads, " concurrent reader threads.");
+  }
+
+  void Unpin() {
+    ThreadState& state = GetThreadState();
+    Assert(state.depth > 0);
+    if (--state.depth == 0) state.slot->epoch.store(kIdle, std::memory_order_release);
+  }
+
+  uint64_t OldestPinnedEpoch() const {
+    uint64_t oldest = kIdle;
+    const int count = high_water_.load();
+    for (int i = 0; i < count; ++i)
+      oldest = std::min(oldest, slots_[i].epoch.load(std::memory_order_acquire));
+    return oldest;
+  }
+
+  std::atomic<uint64_t> epoch_ = 0;
+  std::atomic<int> high_water_ = 0;
+  std::array<Slot, kMaxThreads> slots_;
+  mutable std::mutex mutex_;
+  std::vector<Retired> retired_;
+};
+
+}  // namespace hornet::data::utxo
@@ -2,6 +2,8 @@
 
 #include <memory>
 #include <numeric>
+#include <queue>
+#include <span>
 #include <vector>
 
 #include "hornetlib/data/utxo/compacter.h"
@@ -11,20 +13,26 @@
 
 namespace hornet::data::utxo {
 
-class Index {
+// Age-tiered LSM index of records keyed by KV::key. Recent ages are mutable to support reorgs; older
+// ages are compacted in the background. The primary index is keyed by outpoint (OutputKV), and the
+// optional script index by script hash and outpoint (ScriptKV).
+template <typename KV>
+class IndexT {
  public:
-  Index();
+  IndexT();
 
   QueryResult Query(std::span<const OutputKey> keys, std::span<OutputId> ids, int since, int before) const;
-  TiledVector<OutputKV> MakeAppendBuffer() const { return ages_[0]->MakeEntries(); }
-  void Append(TiledVector<OutputKV>&& entries, int height);
+  void QueryBatch(std::span<QueryRequest> requests) const;
+  std::vector<KV> Scan(std::span<const protocol::Hash> hashes, int since, int before) const;
+  TiledVector<KV> MakeAppendBuffer() const { return ages_[0]->MakeEntries(); }
+  void Append(TiledVector<KV>&& entries, int height);
   void EraseSince(int height);
   int GetContiguousLength() const;
   bool ContainsHeight(int height) const;
 
   static constexpr int GetMutableWindow();
   static void SortKeys(std::span<OutputKey> keys);
-  static void SortEntries(TiledVector<OutputKV>* entries);
+  static void SortEntries(TiledVector<KV>* entries);
 
  private:
   void EnqueueMerge(int index) { compacter_.Enqueue(index); }
@@ -35,25 +43,28 @@ class Index {
   static constexpr int kCompacterThreads = kAges;
   static constexpr int kMergeFanIn = 8;
   
-  std::vector<std::unique_ptr<MemoryAge>> ages_;
+  std::vector<std::unique_ptr<MemoryAgeT<KV>>> ages_;
   mutable Compacter compacter_;  // Constructed last, destroyed first.
 };
 
-inline Index::Index() : compacter_(kCompacterThreads, [this](int index) { DoMerge(index); }) {
+template <typename KV>
+inline IndexT<KV>::IndexT() : compacter_(kCompacterThreads, [this](int index) { DoMerge(index); }) {
   for (int i = 0; i < kAges; ++i)
-    ages_.emplace_back(std::make_unique<MemoryAge>(i < kMutableAges, kMergeFanIn, 
-      [this, index=i](MemoryAge*) { EnqueueMerge(index); })
+    ages_.emplace_back(std::make_unique<MemoryAgeT<KV>>(i < kMutableAges, kMergeFanIn, 
+      [this, index=i](MemoryAgeT<KV>*) { EnqueueMerge(index); })
     );
   // Add an empty entry for the genesis block, which has no spendable outputs.
   ages_[0]->Append({}, std::make_pair(0, 1));
 }
 
-inline void Index::DoMerge(int index) {
+template <typename KV>
+inline void IndexT<KV>::DoMerge(int index) {
   if (index + 1 < std::ssize(ages_))
     ages_[index]->Merge(ages_[index + 1].get());
 }
 
-inline QueryResult Index::Query(std::span<const OutputKey> keys, std::span<OutputId> rids, int since, int before) const {
+template <typename KV>
+inline QueryResult IndexT<KV>::Query(std::span<const OutputKey> keys, std::span<OutputId> rids, int since, int before) const {
   Assert(std::is_sorted(keys.begin(), keys.end()));
   return std::accumulate(ages_.begin(), ages_.end(), QueryResult{}, [&](const QueryResult& sum, const auto& age) {
     // Note: If the queried age is immutable, it will throw an exception if height is within its data range.
@@ -61,19 +72,60 @@ inline QueryResult Index::Query(std::span<const OutputKey> keys, std::span<Outpu
   });
 }
 
-inline void Index::Append(TiledVector<OutputKV>&& entries, int height) {
+// Queries several blocks' keys together: the sorted key sets are merged into one stream, so that each
+// run is walked once for the whole batch rather than once per block.
+template <typename KV>
+inline void IndexT<KV>::QueryBatch(std::span<QueryRequest> requests) const {
+  struct Cursor {
+    int request;
+    int index;
+  };
+  const auto greater = [&](const Cursor& lhs, const Cursor& rhs) {
+    return requests[rhs.request].keys[rhs.index] < requests[lhs.request].keys[lhs.index];
+  };
+  std::priority_queue<Cursor, std::vector<Cursor>, decltype(greater)> heap{greater};
+  size_t size = 0;
+  for (int i = 0; i < std::ssize(requests); ++i) {
+    Assert(std::is_sorted(requests[i].keys.begin(), requests[i].keys.end()));
+    Assert(requests[i].keys.size() == requests[i].rids.size());
+    size += requests[i].keys.size();
+    if (!requests[i].keys.empty()) heap.push({i, 0});
+  }
+  std::vector<QueryItem> items;
+  items.reserve(size);
+  while (!heap.empty()) {
+    Cursor cur = heap.top();
+    heap.pop();
+    items.push_back({requests[cur.request].keys[cur.index], cur.request, cur.index});
+    if (++cur.index < std::ssize(requests[cur.request].keys)) heap.push(cur);
+  }
+
+  for (const auto& age : ages_) age->QueryBatch(requests, items);
+}
+
+template <typename KV>
+inline std::vector<KV> IndexT<KV>::Scan(std::span<const protocol::Hash> hashes, int since, int before) const {
+  std::vector<KV> found;
+  for (const auto& age : ages_) age->Scan(hashes, since, before, &found);
+  return found;
+}
+
+template <typename KV>
+inline void IndexT<KV>::Append(TiledVector<KV>&& entries, int height) {
   Assert(std::is_sorted(entries.begin(), entries.end()));
   ages_[0]->Append(std::move(entries), {height, height + 1});
 }
 
-inline void Index::EraseSince(int height) {
+template <typename KV>
+inline void IndexT<KV>::EraseSince(int height) {
   const auto lock = compacter_.Lock();  // Serializes EraseSince with Merge calls.
   for (const auto& ptr : ages_)
     if (ptr->IsMutable()) ptr->EraseSince(height);
 }
 
 // Returns the number of contiguously added blocks since genesis, before any holes.
-inline int Index::GetContiguousLength() const {
+template <typename KV>
+inline int IndexT<KV>::GetContiguousLength() const {
   // This lock-free implementation requires to search the ages in increasing maturity.
 
   std::optional<int> age0_min, age0_min_pre_hole;
@@ -110,21 +162,25 @@ inline int Index::GetContiguousLength() const {
     return 0;
 }
 
-inline bool Index::ContainsHeight(int height) const {
+template <typename KV>
+inline bool IndexT<KV>::ContainsHeight(int height) const {
   for (const auto& age : ages_)
     if (age->ContainsHeight(height)) return true;
   return false;
 }
 
-/* static */ inline void Index::SortKeys(std::span<OutputKey> keys) {
-  ParallelSort(keys.begin(), keys.end());
+template <typename KV>
+/* static */ inline void IndexT<KV>::SortKeys(std::span<OutputKey> keys) {
+  util::ParallelSort(keys.begin(), keys.end());
 }
 
-/* static */ inline void Index::SortEntries(TiledVector<OutputKV>* entries) {
-  ParallelSort(entries->begin(), entries->end());
+template <typename KV>
+/* static */ inline void IndexT<KV>::SortEntries(TiledVector<KV>* entries) {
+  util::ParallelSort(entries->begin(), entries->end());
 }
 
-/* static */ inline constexpr int Index::GetMutableWindow() { 
+template <typename KV>
+/* static */ inline constexpr int IndexT<KV>::GetMutableWindow() { 
   int count = 0;
   int k = kMergeFanIn;
   for (int i = 0; i < kMutableAges; ++i) {
@@ -134,4 +190,7 @@ inline bool Index::ContainsHeight(int height) const {
   return count;
 }
 
+using Index = IndexT<OutputKV>;
+using ScriptIndex = IndexT<ScriptKV>;
+
 }  // namespace hornet::data::utxo
@@ -1,7 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <utility>
 #include <vector>
 
 #include "hornetlib/consensus/types.h"
@@ -24,10 +31,14 @@ class SpendJoiner {
    const char* what() const noexcept override { return "SpendJoiner cancelled."; }
   };
 
+  // When fetch is false, the spent outputs are only found unspent, not read, e.g. for a block
+  // assumed valid.
   SpendJoiner(Database& db, 
               std::shared_ptr<const protocol::Block> block, 
-              int height) 
-              : state_(State::Init), db_(db), block_(block), height_(height) {}
+              int height,
+              bool fetch = true) 
+              : state_(State::Init), db_(db), block_(block), height_(height),
+                fetch_(fetch) {}
 
   State GetState() const { return state_; }
   int GetHeight() const { return height_; }
@@ -35,18 +46,29 @@ class SpendJoiner {
   bool IsAdvanceReady() const;
   void Advance();
   
+  // Returns true if the next Advance would be a query, which can instead be batched with other
+  // joiners' queries by QueryBatch.
+  bool IsQueryReady() const;
+  static void QueryBatch(Database& db, std::span<SpendJoiner* const> joiners);
+
   bool IsJoinReady() const { return state_ == State::Fetched; }
   consensus::Result Join(auto&& callback);
 
   bool WaitForQuery() const;
   bool WaitForFetch() const;
 
+  // Registers a function to be called once the fetch is released, i.e. on reaching Fetched, Error or
+  // Cancelled, so that a consumer can be scheduled without polling. Called at once if already released.
+  void OnFetchReleased(std::function<void()> callback);
+
   void Cancel();
 
  private:
   void Parse();
   void Append();
   void Query();
+  std::optional<QueryRequest> BeginQuery();
+  void EndQuery(const QueryResult& found);
   void Fetch();
   void GotoError();
   void ReleaseQuery();
@@ -55,10 +77,13 @@ class SpendJoiner {
   std::atomic<State> state_;
   std::atomic<bool> release_query_ = false;
   std::atomic<bool> release_fetch_ = false;
+  std::mutex callback_mutex_;
+  std::function<void()> on_fetch_released_;
 
   Database& db_;
   std::shared_ptr<const protocol::Block> block_;
   const int height_;
+  const bool fetch_;  // Whether the spent outputs are read, rather than only found unspent.
   int query_before_ = 0;
   int found_funded_ = 0;
   int fetch_count_ = 0;
@@ -93,15 +118,23 @@ inline void SpendJoiner::Append() {
 }
 
 inline void SpendJoiner::Query() {
+  if (const auto request = BeginQuery())
+    EndQuery(db_.Query(request->keys, request->rids, request->since, request->before));
+}
+
+// Returns the next query over the heights now contiguous in the database, or nullopt if there are none.
+inline std::optional<QueryRequest> SpendJoiner::BeginQuery() {
   Assert(state_ == State::Appended || state_ == State::QueriedPartial || state_ == State::FetchedPartial);
   rids_.resize(keys_.size());
   outputs_.resize(keys_.size());
   const int commit_height = db_.GetContiguousLength();
   const int query_since = query_before_;  // Initially zero.
-  if (query_since >= commit_height) return;
+  if (query_since >= commit_height) return std::nullopt;
   query_before_ = std::min(commit_height, height_);
-  // TODO: Change API so Query takes &rids_[0] for clarity
-  const auto found = db_.Query(keys_, rids_, query_since, query_before_);
+  return QueryRequest{keys_, rids_, query_since, query_before_};
+}
+
+inline void SpendJoiner::EndQuery(const QueryResult& found) {
   found_funded_ += found.funded;
   Assert(found_funded_ <= std::ssize(keys_));
   if (found.spent > 0) 
@@ -120,10 +153,35 @@ inline void SpendJoiner::Query() {
   }
 }
 
+// Queries several joiners in one pass over the index, each with its own height window.
+/* static */ inline void SpendJoiner::QueryBatch(Database& db, std::span<SpendJoiner* const> joiners) {
+  std::vector<QueryRequest> requests;
+  std::vector<SpendJoiner*> owners;
+  for (SpendJoiner* joiner : joiners) {
+    if (auto request = joiner->BeginQuery()) {
+      requests.push_back(*request);
+      owners.push_back(joiner);
+    }
+  }
+  if (!requests.empty()) db.QueryBatch(requests);
+  for (int i = 0; i < std::ssize(owners); ++i) owners[i]->EndQuery(requests[i].result);
+}
+
 // Fetch the output records from the outputs table.
 inline void SpendJoiner::Fetch() {
   Assert(state_ == State::Queried || state_ == State::QueriedPartial);
 
+  if (!fetch_) {
+    // Nothing is read, but the states advance as usual, so a Fetched joiner has no outputs to Join.
+    if (state_ == State::QueriedPartial) {
+      state_ = State::FetchedPartial;
+    } else {
+      state_ = State::Fetched;
+      ReleaseFetch();
+    }
+    return;
+  }
+
   if (state_ == State::QueriedPartial) {
     // Since the previous action was a partial query, we haven't yet sorted the rid's.
     SortTogether(rids_.begin(), rids_.end(), inputs_.begin(), keys_.begin()/*, outputs_.begin() */);
@@ -155,9 +213,24 @@ inline consensus::Result SpendJoiner::Join(auto&& callback) {
   Assert(state_ == State::Fetched);
   Assert(inputs_.size() == outputs_.size());
 
+  // Inputs are sorted by transaction, so each transaction's spends form a contiguous run, in input
+  // order. The fields shared by the sighashes of a run are hashed only if a signature check needs
+  // them.
+  std::vector<protocol::script::SpentOutput> spent(outputs_.size());
+  for (int index = 0; index < std::ssize(outputs_); ++index)
+    spent[index] = {outputs_[index].header.amount, outputs_[index].script.Span(scripts_)};
+  std::deque<protocol::script::LazyPrecomputedTransactionData> precomputed;
+  std::vector<int> run_of(outputs_.size());
+  for (int begin = 0, end = 0; begin < std::ssize(inputs_); begin = end) {
+    while (end < std::ssize(inputs_) && inputs_[end].tx_index == inputs_[begin].tx_index) ++end;
+    std::fill(run_of.begin() + begin, run_of.begin() + end, std::ssize(precomputed));
+    precomputed.emplace_back(block_->Transaction(inputs_[begin].tx_index),
+                             std::span{spent}.subspan(begin, end - begin));
+  }
+
   consensus::Result rv = {};
   std::atomic<bool> failed = false;
-  ParallelFor<int>(0, std::ssize(outputs_), [&](int index) {
+  util::ParallelFor<int>(0, std::ssize(outputs_), [&](int index) {
     if (failed) return;
     const OutputDetail& detail = outputs_[index];
     const OutputHeader& header = detail.header;
@@ -167,7 +240,8 @@ inline consensus::Result SpendJoiner::Join(auto&& callback) {
       .amount = header.amount,
       .pubkey_script = detail.script.Span(scripts_),
       .tx = block_->Transaction(inputs_[index].tx_index),
-      .spend_input_index = inputs_[index].input_index
+      .spend_input_index = inputs_[index].input_index,
+      .precomputed = &precomputed[run_of[index]]
     };
     if (const consensus::Result result = callback(spend); !result) {
       bool expected = false;
@@ -199,6 +273,15 @@ inline bool SpendJoiner::IsAdvanceReady() const {
   }
 }
 
+inline bool SpendJoiner::IsQueryReady() const {
+  switch (state_) {
+    case State::Appended:
+    case State::FetchedPartial: return IsAdvanceReady();
+    case State::QueriedPartial: return db_.GetContiguousLength() >= height_;
+    default:                    return false;
+  }
+}
+
 inline void SpendJoiner::Advance() {
   switch (state_) {
     case State::Init:           Parse();  break;
@@ -223,6 +306,24 @@ inline void SpendJoiner::ReleaseQuery() {
 inline void SpendJoiner::ReleaseFetch() {
   release_fetch_ = true;
   release_fetch_.notify_all();
+  std::function<void()> callback;
+  {
+    std::lock_guard lock(callback_mutex_);
+    callback = std::exchange(on_fetch_released_, nullptr);
+  }
+  if (callback) callback();
+}
+
+inline void SpendJoiner::OnFetchReleased(std::function<void()> callback) {
+  {
+    std::lock_guard lock(callback_mutex_);
+    // ReleaseFetch sets the flag before taking the lock, so a callback stored here is always consumed.
+    if (!release_fetch_) {
+      on_fetch_released_ = std::move(callback);
+      return;
+    }
+  }
+  callback();
 }
 
 inline void SpendJoiner::GotoError() {
@@ -11,28 +11,33 @@
 
 namespace hornet::data::utxo {
 
-class MemoryAge {
+// One age of the LSM tree: a sequence of runs ordered by height, merged upward when enough are contiguous.
+template <typename KV>
+class MemoryAgeT {
  public:
-  using EnqueueFn = std::function<void(MemoryAge*)>;
+  using MemoryRun = MemoryRunT<KV>;
+  using EnqueueFn = std::function<void(MemoryAgeT*)>;
 
-  MemoryAge(bool is_mutable, int merge_fan_in = 8, EnqueueFn enqueue = {}) : is_mutable_(is_mutable), merge_fan_in_(merge_fan_in), enqueue_(std::move(enqueue)) {}
+  MemoryAgeT(bool is_mutable, int merge_fan_in = 8, EnqueueFn enqueue = {}) : is_mutable_(is_mutable), merge_fan_in_(merge_fan_in), enqueue_(std::move(enqueue)) {}
 
   bool IsMutable() const { return is_mutable_; }
   QueryResult Query(std::span<const OutputKey> keys, std::span<OutputId> rids, int since, int before) const;
+  void QueryBatch(std::span<QueryRequest> requests, std::span<const QueryItem> items) const;
+  void Scan(std::span<const protocol::Hash> hashes, int since, int before, std::vector<KV>* found) const;
   int Size() const { return runs_.Size(); }
   bool Empty() const { return runs_.Empty(); }
   bool IsMergeReady() const;
-  TiledVector<OutputKV> MakeEntries() const { return {kTileBits}; }
+  TiledVector<KV> MakeEntries() const { return {kTileBits}; }
   void Append(MemoryRun&& run);
-  void Append(TiledVector<OutputKV>&& entries, const std::pair<int, int>& range);
-  void Merge(MemoryAge* dst);
+  void Append(TiledVector<KV>&& entries, const std::pair<int, int>& range);
+  void Merge(MemoryAgeT* dst);
   void EraseSince(int height);
   bool ContainsHeight(int height) const;
 
   auto RunsSnapshot() const { return runs_.Snapshot(); }
 
  protected:
-  using MemoryRunPtr = AtomicVector<MemoryRun>::Ptr;
+  using MemoryRunPtr = typename AtomicVector<MemoryRun>::Ptr;
   static constexpr int kTileBits = 13;
 
   const bool is_mutable_ = false;
@@ -43,7 +48,8 @@ class MemoryAge {
   AtomicVector<MemoryRun> runs_;
 };
 
-inline QueryResult MemoryAge::Query(std::span<const OutputKey> keys, std::span<OutputId> rids, int since, int before) const {
+template <typename KV>
+inline QueryResult MemoryAgeT<KV>::Query(std::span<const OutputKey> keys, std::span<OutputId> rids, int since, int before) const {
   const auto snapshot = runs_.Snapshot();
   return std::accumulate(snapshot->rbegin(), snapshot->rend(), QueryResult{},
     [&](const QueryResult& sum, const MemoryRunPtr& run) {
@@ -53,7 +59,21 @@ inline QueryResult MemoryAge::Query(std::span<const OutputKey> keys, std::span<O
   );
 }
 
-inline bool MemoryAge::IsMergeReady() const {
+template <typename KV>
+inline void MemoryAgeT<KV>::QueryBatch(std::span<QueryRequest> requests, std::span<const QueryItem> items) const {
+  const auto snapshot = runs_.Snapshot();
+  for (auto it = snapshot->rbegin(); it != snapshot->rend(); ++it) (*it)->QueryBatch(requests, items);
+}
+
+template <typename KV>
+inline void MemoryAgeT<KV>::Scan(std::span<const protocol::Hash> hashes, int since, int before,
+                                 std::vector<KV>* found) const {
+  const auto snapshot = runs_.Snapshot();
+  for (const MemoryRunPtr& run : *snapshot) run->Scan(hashes, since, before, found);
+}
+
+template <typename KV>
+inline bool MemoryAgeT<KV>::IsMergeReady() const {
   const auto copy = runs_.Snapshot();
   Assert(std::is_sorted(copy->begin(), copy->end(), [](const MemoryRunPtr& lhs, const MemoryRunPtr& rhs) {
     return lhs->HeightRange().first < rhs->HeightRange().first;
@@ -69,11 +89,13 @@ inline bool MemoryAge::IsMergeReady() const {
   return ready >= merge_fan_in_;
 }
 
-inline void MemoryAge::Append(TiledVector<OutputKV>&& entries, const std::pair<int, int>& range) {
+template <typename KV>
+inline void MemoryAgeT<KV>::Append(TiledVector<KV>&& entries, const std::pair<int, int>& range) {
   Append(MemoryRun{is_mutable_, std::move(entries), range});
 }
 
-inline void MemoryAge::Append(MemoryRun&& run) {
+template <typename KV>
+inline void MemoryAgeT<KV>::Append(MemoryRun&& run) {
 #if UTXO_LOG
   LogDebug("Appending run #", runs_.Size(), " with ", run.Size(), " entries, heights [", run.HeightRange().first, ", ", run.HeightRange().second, ").");
 #endif
@@ -83,14 +105,15 @@ inline void MemoryAge::Append(MemoryRun&& run) {
   if (enqueue_ && IsMergeReady()) enqueue_(this);
 }
 
-inline void MemoryAge::Merge(MemoryAge* dst) {
+template <typename KV>
+inline void MemoryAgeT<KV>::Merge(MemoryAgeT* dst) {
   if (!IsMergeReady()) return;  // Nothing to do.
 
   bool expected = false;
   if (!is_merging_.compare_exchange_strong(expected, true))
     return;
   {
-    struct Guard { MemoryAge* a; ~Guard() { a->is_merging_ = false; } } guard{this};
+    struct Guard { MemoryAgeT* a; ~Guard() { a->is_merging_ = false; } } guard{this};
 
     // NOTE: Here we could take a copy-on-write lock, and hold it until the end of this function.
     // However, observe that we only perform the merge and publish a change to runs_ if we have enough
@@ -121,7 +144,8 @@ inline void MemoryAge::Merge(MemoryAge* dst) {
   if (enqueue_ && IsMergeReady()) enqueue_(this);
 }
 
-inline void MemoryAge::EraseSince(int height) {
+template <typename KV>
+inline void MemoryAgeT<KV>::EraseSince(int height) {
   Assert(IsMutable());
   Assert(!is_merging_);
 
@@ -138,7 +162,8 @@ inline void MemoryAge::EraseSince(int height) {
   }
 }
 
-inline bool MemoryAge::ContainsHeight(int height) const {
+template <typename KV>
+inline bool MemoryAgeT<KV>::ContainsHeight(int height) const {
   const auto runs = runs_.Snapshot();
   for (int i = 0; i < std::ssize(*runs); ++i) {
     const auto range = (*runs)[i]->HeightRange();
@@ -148,4 +173,6 @@ inline bool MemoryAge::ContainsHeight(int height) const {
   return false;
 }
 
+using MemoryAge = MemoryAgeT<OutputKV>;
+
 }  // namespace hornet::data::utxo
@@ -9,20 +9,23 @@
 
 #include "hornetlib/data/utxo/codec.h"
 #include "hornetlib/data/utxo/directory.h"
-#include "hornetlib/data/utxo/parallel.h"
 #include "hornetlib/data/utxo/tiled_vector.h"
 #include "hornetlib/data/utxo/search.h"
 #include "hornetlib/data/utxo/types.h"
 #include "hornetlib/util/assert.h"
+#include "hornetlib/util/parallel_chunks.h"
 
 namespace hornet::data::utxo {
 
-class MemoryRun {
+// An immutable sorted run of index records, with a directory over the leading bits of their key hashes.
+// KV is OutputKV for the primary index, or ScriptKV for the script index.
+template <typename KV>
+class MemoryRunT {
  public:
-  MemoryRun(bool is_mutable, int prefix_bits)
+  MemoryRunT(bool is_mutable, int prefix_bits)
       : is_mutable_(is_mutable), directory_(prefix_bits) {}
-  MemoryRun(const MemoryRun& rhs);
-  MemoryRun(bool is_mutable, TiledVector<OutputKV>&& entries, const std::pair<int, int>& height_range = { std::numeric_limits<int>::max(), std::numeric_limits<int>::min() })
+  MemoryRunT(const MemoryRunT& rhs);
+  MemoryRunT(bool is_mutable, TiledVector<KV>&& entries, const std::pair<int, int>& height_range = { std::numeric_limits<int>::max(), std::numeric_limits<int>::min() })
       : is_mutable_(is_mutable), entries_(std::move(entries)), directory_(ComputePrefixBits(entries_.Size()), entries_.begin(), entries_.end()), height_range_(height_range) {
         // TODO: Create Bloom filter.
       }
@@ -31,6 +34,8 @@ class MemoryRun {
   size_t Size() const { return entries_.Size(); }
   bool IsMutable() const { return is_mutable_; }
   QueryResult Query(std::span<const OutputKey> keys, std::span<OutputId> rids, int since, int before) const;
+  void QueryBatch(std::span<QueryRequest> requests, std::span<const QueryItem> items) const;
+  void Scan(std::span<const protocol::Hash> hashes, int since, int before, std::vector<KV>* found) const;
   std::pair<int, int> HeightRange() const { return height_range_; }
   bool ContainsHeight(int height) const {
     return height_range_.first <= height && height < height_range_.second;
@@ -40,7 +45,7 @@ class MemoryRun {
   auto Begin() const { return entries_.begin(); }
   auto End() const { return entries_.end(); }
 
-  static MemoryRun Merge(bool is_mutable, std::span<const std::shared_ptr<const MemoryRun>> inputs);
+  static MemoryRunT Merge(bool is_mutable, std::span<const std::shared_ptr<const MemoryRunT>> inputs);
 
  private:
    struct QueryRange {
@@ -48,47 +53,65 @@ class MemoryRun {
     std::span<OutputId> rids;
   };
 
-  int AddEntry(const OutputKV& kv, int next_bucket);
+  using Iterator = typename TiledVector<KV>::ConstIterator;
+
+  // Queries are split into at most kRanges key ranges, of at least kMinRangeKeys keys, to search in parallel.
+  static constexpr int kRanges = 8;
+  static constexpr int kMinRangeKeys = 256;
+
+  bool Overlaps(int since, int before) const {
+    return since < height_range_.second && height_range_.first < before;
+  }
+  void CheckQueryRange(int before) const;
+  void LookupKey(const OutputKey& key, int since, int before, Iterator* lower, OutputId* rid, QueryResult* found) const;
+  int AddEntry(const KV& kv, int next_bucket);
   static std::vector<QueryRange> SplitQuery(std::span<const OutputKey> keys, std::span<OutputId> rids, int splits);
   QueryResult QueryImpl(std::span<const OutputKey> keys, std::span<OutputId> rids, int since, int before) const;
 
   static int ComputePrefixBits(int entries) {
     constexpr int kMinPrefixBits = 4;
     constexpr int kTargetBytesPerBucket = 4096;
-    constexpr int kEntriesPerBucket = kTargetBytesPerBucket / sizeof(OutputKV);
+    constexpr int kEntriesPerBucket = kTargetBytesPerBucket / sizeof(KV);
     const int buckets = (entries + kEntriesPerBucket - 1) / kEntriesPerBucket;
     const int prefix_bits = buckets <= 0 ? 0 : std::bit_width(static_cast<unsigned int>(buckets - 1));
     return std::max(kMinPrefixBits, prefix_bits);
   }
 
   const bool is_mutable_;
-  TiledVector<OutputKV> entries_;
+  TiledVector<KV> entries_;
   Directory directory_;
   // TODO: Bloom filter.
   std::pair<int, int> height_range_ = { std::numeric_limits<int>::max(), std::numeric_limits<int>::min() };
 };
 
-inline MemoryRun::MemoryRun(const MemoryRun& rhs) 
+template <typename KV>
+inline MemoryRunT<KV>::MemoryRunT(const MemoryRunT& rhs) 
   : is_mutable_(rhs.is_mutable_), entries_(rhs.entries_), directory_(rhs.directory_), height_range_(rhs.height_range_) {
 }
 
-inline QueryResult MemoryRun::Query(std::span<const OutputKey> keys, std::span<OutputId> rids, int since, int before) const {
-  if (before <= height_range_.first || height_range_.second <= since) return {0, 0};  // No overlap
-
+template <typename KV>
+inline void MemoryRunT<KV>::CheckQueryRange(int before) const {
   // In an immutable run, we can only guarantee correct results if the entire run is contained within the queried time range.
   if (!IsMutable() && before < height_range_.second) 
     util::ThrowInvalidArgument("Queried height already merged to immutable.");
+}
+
+template <typename KV>
+inline QueryResult MemoryRunT<KV>::Query(std::span<const OutputKey> keys, std::span<OutputId> rids, int since, int before) const {
+  if (!Overlaps(since, before)) return {0, 0};
+  CheckQueryRange(before);
 
   // TODO: Check Bloom filter for quick exit.
 
-  static constexpr int kRanges = 8;
-  return ParallelSum<QueryResult>(SplitQuery(keys, rids, kRanges), {}, [&](const QueryRange& range) -> QueryResult {
+  const int ranges = util::GetChunkCount(std::ssize(keys), kMinRangeKeys, kRanges);
+  return util::ParallelSum<QueryResult>(SplitQuery(keys, rids, ranges), {}, [&](const QueryRange& range) -> QueryResult {
     if (range.keys.empty()) return {};
     return QueryImpl(range.keys, range.rids, since, before);
   });
 }
 
-/* static */ inline std::vector<MemoryRun::QueryRange> MemoryRun::SplitQuery(std::span<const OutputKey> keys, std::span<OutputId> rids, int splits) {
+template <typename KV>
+/* static */ inline std::vector<typename MemoryRunT<KV>::QueryRange> MemoryRunT<KV>::SplitQuery(std::span<const OutputKey> keys, std::span<OutputId> rids, int splits) {
   Assert(keys.size() == rids.size());
   std::vector<QueryRange> ranges(splits);
   const size_t size = keys.size();
@@ -102,7 +125,8 @@ inline QueryResult MemoryRun::Query(std::span<const OutputKey> keys, std::span<O
   return ranges;
 }
 
-inline QueryResult MemoryRun::QueryImpl(std::span<const OutputKey> keys, std::span<OutputId> rids, int since, int before) const {
+template <typename KV>
+inline QueryResult MemoryRunT<KV>::QueryImpl(std::span<const OutputKey> keys, std::span<OutputId> rids, int since, int before) const {
 #if UTXO_LOG
   LogDebug() << "Searching in [" << since << ", " << before << "), run contains:";
   for (const auto& kv : entries_)
@@ -112,58 +136,111 @@ inline QueryResult MemoryRun::QueryImpl(std::span<const OutputKey> keys, std::sp
       LogDebug() << "   {" << keys[i].hash << ", " << keys[i].index << "}, rid.offset = " << IdCodec::Offset(rids[i]);
 #endif
 
-  int adds = 0, deletes = 0;
+  QueryResult found;
   const int size = std::ssize(keys);
   // We can skip over previously found rid's if we can guarantee we won't find a newer entry here
   // than one that was found previously, i.e. if we're searching from genesis.
   const bool overwrite = since > 0;
-  auto lower = entries_.begin(), upper = entries_.end();
+  auto lower = entries_.begin();
   for (int index = 0; index < size; ++index) {
     if (rids[index] == kSpentOutputId || (!overwrite && rids[index] != kNullOutputId))
       continue;  // If the key was already found spent or we're not overwriting previous rid's, we can continue.
-    
-    // Get the key for this query.
-    const auto& key = keys[index];
-    
-    // Tighten bounds when available externally (e.g. directory).
-    const auto [lo, hi] = directory_.LookupRange(key);
-    lower = std::max(lower, entries_.begin() + lo);  // Lower bound is monotonically increasing...
-    upper = entries_.begin() + hi;                   // while upper bound resets for each key.
+    LookupKey(keys[index], since, before, &lower, &rids[index], &found);
+  }
+#if UTXO_LOG
+  LogDebug() << "Found " << found.funded << " + and " << found.spent << " -.";
+#endif
+  return found;
+}
 
-    // Tighten bounds again by galloping forwards until we pass over the key.
-    std::tie(lower, upper) = GallopingRangeSearch(lower, upper, key);
+// Searches for one key at or after *lower, which advances monotonically over sorted keys, and records
+// a match visible in [since, before) into *rid.
+template <typename KV>
+inline void MemoryRunT<KV>::LookupKey(const OutputKey& key, int since, int before, Iterator* lower,
+                                      OutputId* rid, QueryResult* found) const {
+  // Tighten bounds when available externally (e.g. directory).
+  const auto [lo, hi] = directory_.LookupRange(key);
+  *lower = std::max(*lower, entries_.begin() + lo);  // Lower bound is monotonically increasing...
+  auto upper = entries_.begin() + hi;                 // while upper bound resets for each key.
 
-    // Binary search in the remaining range for the first item that's ordered >= the query key.
-    auto it = std::lower_bound(lower, upper, key);
-  
-    // Check at most two equal-key entries (the lower_bound result and its immediate successor) for an exact match.
-    for (int i = 0; i < 2 && it != upper && it->key == key; ++i, ++it) {
-      if ((since <= it->data.height && it->data.height < before)) {
-        if (rids[index] != kNullOutputId) --adds;  // A Delete overwriting an Add.
-        rids[index] = it->IsAdd() ? it->rid : kSpentOutputId;
-        ++(it->IsAdd() ? adds : deletes);
-        break;
-      }
+  // Tighten bounds again by galloping forwards until we pass over the key.
+  std::tie(*lower, upper) = GallopingRangeSearch(*lower, upper, key);
+
+  // Binary search in the remaining range for the first item that's ordered >= the query key.
+  auto it = std::lower_bound(*lower, upper, key);
+
+  // Check at most two equal-key entries (the lower_bound result and its immediate successor) for an exact match.
+  for (int i = 0; i < 2 && it != upper && it->key == key; ++i, ++it) {
+    if ((since <= it->data.height && it->data.height < before)) {
+      if (*rid != kNullOutputId) --found->funded;  // A Delete overwriting an Add.
+      *rid = it->IsAdd() ? it->rid : kSpentOutputId;
+      ++(it->IsAdd() ? found->funded : found->spent);
+      break;
     }
   }
-#if UTXO_LOG
-  LogDebug() << "Found " << adds << " + and " << deletes << " -.";
-#endif
-  return {adds, deletes};
 }
 
-inline void MemoryRun::EraseSince(int height) {
+// Walks the run once for the merged keys of several requests, applying each request's own height
+// window and accumulating into its result. Like Query, the sorted keys are split into ranges that
+// are searched in parallel, each range accumulating its own results per request.
+template <typename KV>
+inline void MemoryRunT<KV>::QueryBatch(std::span<QueryRequest> requests, std::span<const QueryItem> items) const {
+  std::vector<char> active(requests.size());
+  for (int i = 0; i < std::ssize(requests); ++i) {
+    active[i] = Overlaps(requests[i].since, requests[i].before);
+    if (active[i]) CheckQueryRange(requests[i].before);
+  }
+  if (std::ranges::find(active, 1) == active.end()) return;
+
+  const int ranges = util::GetChunkCount(std::ssize(items), kMinRangeKeys, kRanges);
+  std::vector<std::vector<QueryResult>> found(ranges, std::vector<QueryResult>(requests.size()));
+  util::ParallelChunks(std::ssize(items), kMinRangeKeys, [&](int range, int begin, int end) {
+    auto lower = entries_.begin();
+    for (const QueryItem& item : items.subspan(begin, end - begin)) {
+      if (!active[item.request]) continue;
+      const QueryRequest& request = requests[item.request];
+      OutputId& rid = request.rids[item.index];
+      if (rid == kSpentOutputId || (request.since == 0 && rid != kNullOutputId)) continue;
+      LookupKey(item.key, request.since, request.before, &lower, &rid, &found[range][item.request]);
+    }
+  }, ranges);
+  for (const auto& results : found)
+    for (int i = 0; i < std::ssize(requests); ++i) requests[i].result += results[i];
+}
+
+// Appends the entries in [since, before) whose key hash is one of the given sorted hashes.
+template <typename KV>
+inline void MemoryRunT<KV>::Scan(std::span<const protocol::Hash> hashes, int since, int before,
+                                 std::vector<KV>* found) const {
+  Assert(std::is_sorted(hashes.begin(), hashes.end()));
+  if (!Overlaps(since, before)) return;
+  CheckQueryRange(before);
+
+  auto lower = entries_.begin();
+  for (const protocol::Hash& hash : hashes) {
+    const auto [lo, hi] = directory_.LookupRange(ScriptKey{hash, {}});
+    lower = std::max(lower, entries_.begin() + lo);
+    const auto upper = entries_.begin() + hi;
+    lower = std::partition_point(lower, upper, [&](const KV& kv) { return kv.key.hash < hash; });
+    for (; lower != upper && lower->key.hash == hash; ++lower)
+      if (since <= lower->data.height && lower->data.height < before) found->push_back(*lower);
+  }
+}
+
+template <typename KV>
+inline void MemoryRunT<KV>::EraseSince(int height) {
   Assert(IsMutable());
   Assert(ContainsHeight(height));
 
   // Run partially overlaps with undo range.
-  entries_.EraseIf([&](const OutputKV& kv) { return kv.data.height >= height; });
+  entries_.EraseIf([&](const KV& kv) { return kv.data.height >= height; });
   directory_.Rebuild(entries_.begin(), entries_.end());
   // TODO: Optionally rebuild Bloom filter.
   height_range_.second = height;
 }
 
-inline int MemoryRun::AddEntry(const OutputKV& kv, int bucket) {
+template <typename KV>
+inline int MemoryRunT<KV>::AddEntry(const KV& kv, int bucket) {
   const int cur_bucket = directory_.GetBucket(kv.key);
   const int offset = entries_.Size();
   while (bucket <= cur_bucket) directory_[bucket++] = offset;
@@ -172,8 +249,9 @@ inline int MemoryRun::AddEntry(const OutputKV& kv, int bucket) {
 }
 
 // Multi-way streaming merge of sorted input runs to a single sorted output run.
-/* static */ inline MemoryRun MemoryRun::Merge(bool is_mutable, std::span<const std::shared_ptr<const MemoryRun>> inputs) {
-  using Iterator = typename decltype(entries_)::ConstIterator;
+template <typename KV>
+/* static */ inline MemoryRunT<KV> MemoryRunT<KV>::Merge(bool is_mutable, std::span<const std::shared_ptr<const MemoryRunT>> inputs) {
+  using Iterator = typename TiledVector<KV>::ConstIterator;
   struct Cursor {
     Iterator current, end;
     bool operator >(const Cursor& rhs) const { return *rhs.current < *current; }
@@ -186,7 +264,7 @@ inline int MemoryRun::AddEntry(const OutputKV& kv, int bucket) {
   const int prefix_bits = ComputePrefixBits(approx_entries);
 
   // Initialize output.
-  MemoryRun dst{is_mutable, prefix_bits};
+  MemoryRunT dst{is_mutable, prefix_bits};
 
   // Initialize heap and destination height range.
   std::priority_queue<Cursor, std::vector<Cursor>, std::greater<Cursor>> heap;
@@ -226,4 +304,6 @@ inline int MemoryRun::AddEntry(const OutputKV& kv, int bucket) {
   return dst;
 }
 
+using MemoryRun = MemoryRunT<OutputKV>;
+
 }  // namespace hornet::data::utxo
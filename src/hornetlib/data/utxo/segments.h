@@ -42,7 +42,6 @@ class Segments {
   std::filesystem::path folder_;
   std::vector<Item> items_;
   UniqueFD fd_write_;
-  mutable UringIOEngine io_;
   std::atomic<uint64_t> size_bytes_ = 0;
   uint64_t max_segment_length_ = uint64_t(1) << 30;  // 1 GiB
 };
@@ -164,7 +163,9 @@ inline int Segments::FetchData(std::span<const OutputId> ids,
   }
 
   // Dispatch all the I/O requests to the I/O engine and wait for them to complete.
-  Read(io_, requests);
+  // A ring must not be shared by concurrent submitters, so each fetching thread owns one.
+  static thread_local UringIOEngine io;
+  Read(io, requests);
   return std::ssize(requests);
 }
 
@@ -1,15 +1,34 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
-#include <stdatomic.h>
+
+#include "hornetlib/data/utxo/epoch.h"
 
 namespace hornet::data::utxo {
 
 // Synchronization wrapper supporting multiple lock-free readers and serialized, scoped edits for writers.
+// Readers pin an epoch rather than taking a reference count, and superseded versions are reclaimed
+// after a grace period (see Epoch).
 template <class T>
 class SingleWriter {
  public:
+  // A read-only view of one published version. The version stays alive while the view exists.
+  class View {
+   public:
+    const T* get() const noexcept { return ptr_; }
+    const T* operator->() const noexcept { return ptr_; }
+    const T& operator*() const noexcept { return *ptr_; }
+
+   private:
+    friend class SingleWriter;
+    View(Epoch::Guard&& guard, const T* ptr) noexcept : guard_(std::move(guard)), ptr_(ptr) {}
+
+    Epoch::Guard guard_;
+    const T* ptr_;
+  };
+
   class Writer {
    public:
     Writer(SingleWriter<T>& target) noexcept : target_(target), lock_(target.mutex_) {}
@@ -20,7 +39,7 @@ class SingleWriter {
     T& operator*() { return *EnsureCopy(); }
 
     void Cancel() { copy_.reset(); }
-  
+
    private:
     T* EnsureCopy() {
       if (!copy_) copy_ = target_.Copy();
@@ -33,12 +52,18 @@ class SingleWriter {
   };
 
   template <typename... Args>
-  explicit SingleWriter(Args&&... args) : ptr_(std::make_shared<T>(std::forward<Args>(args)...)) {}
-  SingleWriter(std::shared_ptr<const T> ptr) : ptr_(std::move(ptr)) {}
+  explicit SingleWriter(Args&&... args) : ptr_(new Node{std::make_shared<T>(std::forward<Args>(args)...)}) {}
+  SingleWriter(std::shared_ptr<const T> ptr) : ptr_(new Node{std::move(ptr)}) {}
+  SingleWriter(const SingleWriter&) = delete;
+  SingleWriter& operator=(const SingleWriter&) = delete;
+  ~SingleWriter() {
+    delete ptr_.load(std::memory_order_acquire);
+  }
 
   // Returns a read-only snapshot of the current state (lock-free).
-  std::shared_ptr<const T> Snapshot() const { 
-    return std::atomic_load_explicit(&ptr_, std::memory_order_acquire);
+  View Snapshot() const {
+    auto guard = Epoch::Global().Pin();
+    return {std::move(guard), ptr_.load(std::memory_order_acquire)->value.get()};
   }
 
   // Returns a mutable copy of the current state (lock-free).
@@ -47,12 +72,14 @@ class SingleWriter {
   }
 
   // Operates on a read-only snapshot of the current state.
-  const T* operator ->() const { return Snapshot().get(); }
-  const T& operator *() const { return *Snapshot(); }
+  View operator ->() const { return Snapshot(); }
+  T operator *() const { return *Snapshot(); }
 
   // Atomically publishes a new version, ignoring other writers that may be mutating snapshots (lock-free).
-  void Publish(std::shared_ptr<const T> ptr) { 
-    std::atomic_store_explicit(&ptr_, std::move(ptr), std::memory_order_release);
+  // The previous version is retired, and destroyed once no reader can still observe it.
+  void Publish(std::shared_ptr<const T> ptr) {
+    const Node* old = ptr_.exchange(new Node{std::move(ptr)}, std::memory_order_acq_rel);
+    Epoch::Global().Retire([old] { delete old; });
   }
 
   // Returns an object that holds an exclusive lock, makes a copy, and publishes the mutated
@@ -61,8 +88,14 @@ class SingleWriter {
 
  private:
   friend class Writer;
+
+  // Owns one published version. Readers dereference the raw pointer without touching the count.
+  struct Node {
+    std::shared_ptr<const T> value;
+  };
+
   mutable std::mutex mutex_;
-  std::shared_ptr<const T> ptr_;
+  std::atomic<const Node*> ptr_;
 };
 
 }  // namespace hornet::data::utxo
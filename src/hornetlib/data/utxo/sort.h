@@ -1,39 +1,153 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <concepts>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
 #include <numeric>
+#include <span>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
+#include "hornetlib/data/utxo/types.h"
+#include "hornetlib/util/parallel_chunks.h"
+
 namespace hornet::data::utxo {
 
-template <typename Iter1, typename... Iters>
-inline void SortTogether(Iter1 begin, Iter1 end, Iters... secondaries) {
-  const auto a = begin;
-  const int size = end - begin;
-
-  // Generate permutation indices via sort.
-  std::vector<int> p(size);
-  std::iota(p.begin(), p.end(), 0);
-  std::sort(p.begin(), p.end(), [&](int i, int j) { return a[i] < a[j]; });
-
-  // Cycle rotation.
-  for (int dst = 0; dst < size; ++dst) {
-    if (p[dst] == dst) continue;
-    auto va = std::move(a[dst]);
-    auto vs = std::make_tuple(std::move(secondaries[dst])...);
-
-    int j = dst;
-    for (int next = p[j]; next != dst; j = next, next = p[j]) {
-      a[j] = std::move(a[next]);
-      ((secondaries[j] = std::move(secondaries[next])), ...);
-      p[j] = j;       // mark done
-    }
+// Maps a sort key to a 64-bit prefix that is monotone in the key's ordering: a < b implies
+// Get(a) <= Get(b). When kExact is true, the prefix determines the ordering completely.
+template <typename T>
+struct SortPrefix;
+
+template <std::integral T>
+  requires (sizeof(T) <= sizeof(uint64_t))
+struct SortPrefix<T> {
+  // Flips the sign bit of signed types so that negative values order first.
+  static constexpr bool kExact = true;
+  static uint64_t Get(T value) {
+    if constexpr (std::is_signed_v<T>)
+      return static_cast<uint64_t>(static_cast<int64_t>(value)) ^ (uint64_t{1} << 63);
+    else
+      return value;
+  }
+};
+
+template <>
+struct SortPrefix<InputHeader> {
+  static constexpr bool kExact = true;
+  static uint64_t Get(const InputHeader& input) {
+    return (uint64_t{static_cast<uint32_t>(input.tx_index)} << 32) | static_cast<uint32_t>(input.input_index);
+  }
+};
+
+template <>
+struct SortPrefix<OutputKey> {
+  // Hashes compare lexicographically by byte, so the leading eight bytes read big-endian form a prefix.
+  static constexpr bool kExact = false;
+  static uint64_t Get(const OutputKey& key) {
+    uint64_t prefix;
+    std::memcpy(&prefix, key.hash.data(), sizeof(prefix));
+    if constexpr (std::endian::native == std::endian::little) prefix = std::byteswap(prefix);
+    return prefix;
+  }
+};
+
+namespace detail {
+
+struct SortItem {
+  uint64_t prefix;
+  uint32_t index;
+};
+
+// Stable LSD radix sort on the 64-bit prefix, skipping digits on which all items agree.
+inline void RadixSort(std::vector<SortItem>* items) {
+  constexpr int kDigits = sizeof(uint64_t);
+  const size_t size = items->size();
+  std::array<std::array<uint32_t, 256>, kDigits> counts = {};
+  for (const SortItem& item : *items)
+    for (int d = 0; d < kDigits; ++d) ++counts[d][(item.prefix >> (8 * d)) & 0xff];
+
+  std::vector<SortItem> scratch(size);
+  SortItem* src = items->data();
+  SortItem* dst = scratch.data();
+  for (int d = 0; d < kDigits; ++d) {
+    auto& count = counts[d];
+    if (std::ranges::find(count, size) != count.end()) continue;  // All in one bucket.
+    uint32_t sum = 0;
+    for (uint32_t& c : count) sum += std::exchange(c, sum);
+    for (size_t i = 0; i < size; ++i) dst[count[(src[i].prefix >> (8 * d)) & 0xff]++] = src[i];
+    std::swap(src, dst);
+  }
+  if (src != items->data()) std::copy(src, src + size, items->data());
+}
+
+// Permutes [begin, begin + perm.size()) so that element i receives the old element perm[i].
+template <typename Iter>
+inline void Gather(Iter begin, std::span<const uint32_t> perm) {
+  std::vector<std::iter_value_t<Iter>> staging;
+  staging.reserve(perm.size());
+  for (uint32_t index : perm) staging.push_back(std::move(begin[index]));
+  std::move(staging.begin(), staging.end(), begin);
+}
+
+}  // namespace detail
+
+// Returns the permutation that sorts [begin, end): the i'th sorted element is begin[result[i]].
+template <typename Iter>
+inline std::vector<uint32_t> SortPermutation(Iter begin, Iter end) {
+  using Prefix = SortPrefix<std::iter_value_t<Iter>>;
+  constexpr size_t kRadixThreshold = 64;
+  const size_t size = end - begin;
+
+  // Packs (prefix, index) pairs so the sort touches 16 bytes per element instead of the full keys.
+  std::vector<detail::SortItem> items(size);
+  for (size_t i = 0; i < size; ++i) items[i] = {Prefix::Get(begin[i]), static_cast<uint32_t>(i)};
+  const auto by_prefix = [](const detail::SortItem& lhs, const detail::SortItem& rhs) {
+    return lhs.prefix < rhs.prefix;
+  };
+  if (size < kRadixThreshold) std::stable_sort(items.begin(), items.end(), by_prefix);
+  else detail::RadixSort(&items);
 
-    a[j] = std::move(va);
-    std::apply([&](auto&&... v) { ((secondaries[j] = std::move(v)), ...); }, vs);
-    p[j] = j;
+  if constexpr (!Prefix::kExact) {
+    // Resolves runs of equal prefixes by comparing the full keys.
+    for (auto run = items.begin(); run != items.end();) {
+      const auto run_end = std::find_if(run + 1, items.end(), [&](const detail::SortItem& item) {
+        return item.prefix != run->prefix;
+      });
+      if (run_end - run > 1)
+        std::sort(run, run_end, [&](const detail::SortItem& lhs, const detail::SortItem& rhs) {
+          return begin[lhs.index] < begin[rhs.index];
+        });
+      run = run_end;
+    }
   }
+
+  std::vector<uint32_t> perm(size);
+  std::ranges::transform(items, perm.begin(), &detail::SortItem::index);
+  return perm;
+}
+
+// Arrays shorter than this are gathered on the calling thread.
+inline constexpr int kMinParallelGather = 1 << 14;
+
+// Sorts [begin, end) and applies the same permutation to each of the parallel secondary arrays.
+// The keys are sorted by prefix, then each array is permuted with one gather pass.
+template <typename Iter1, typename... Iters>
+inline void SortTogether(Iter1 begin, Iter1 end, Iters... secondaries) {
+  if (end - begin < 2) return;
+  const std::vector<uint32_t> perm = SortPermutation(begin, end);
+  const std::array<std::function<void()>, 1 + sizeof...(Iters)> gathers = {
+    [&] { detail::Gather(begin, perm); },
+    [&] { detail::Gather(secondaries, perm); }...
+  };
+  // Short arrays are gathered inline, as one chunk.
+  const int min_chunk = end - begin < kMinParallelGather ? std::ssize(gathers) : 1;
+  util::ParallelFor<size_t>(0, gathers.size(), [&](size_t i) { gathers[i](); }, min_chunk);
 }
 
 }  // namespace hornet::data::utxo
@@ -26,10 +26,10 @@ class SpendPipeline {
   }
 
   // Creates a SpendJoiner, adds it to the pipeline, and returns it so it can be
-  // wrapped in a DatabaseView for the consumer.
-  std::shared_ptr<SpendJoiner> Add(std::shared_ptr<const protocol::Block> block, int height) {
+  // wrapped in a DatabaseView for the consumer. See SpendJoiner for the fetch flag.
+  std::shared_ptr<SpendJoiner> Add(std::shared_ptr<const protocol::Block> block, int height, bool fetch = true) {
     if (abort_) throw SpendJoiner::CancelledException{};
-    auto joiner = std::make_shared<SpendJoiner>(db_, std::move(block), height);
+    auto joiner = std::make_shared<SpendJoiner>(db_, std::move(block), height, fetch);
     {
       std::lock_guard lock(mutex_);
       std::erase_if(active_joiners_, [](const auto& weak) { return weak.expired(); });
@@ -59,51 +59,85 @@ class SpendPipeline {
  private:
   void WorkerLoop() {
     while (true) {
-      std::shared_ptr<SpendJoiner> job;
+      std::vector<std::shared_ptr<SpendJoiner>> jobs;
       {
         std::unique_lock lock(mutex_);
         cv_.wait(lock, [&] { return abort_ || !ready_queue_.empty(); });
         if (abort_) return;
-        job = ready_queue_.top();
+        jobs.push_back(ready_queue_.top());
         ready_queue_.pop();
+        if (jobs.front()->IsQueryReady()) TakeQueryReadyJobs(&jobs);
       }
 
-      Assert(job->IsAdvanceReady());
-      job->Advance();
-      const SpendJoiner::State state = job->GetState();
+      if (jobs.size() > 1) {
+        // Queries the pending blocks together, so that each index run is walked once for all of them.
+        std::vector<SpendJoiner*> joiners;
+        for (const auto& job : jobs) joiners.push_back(job.get());
+        SpendJoiner::QueryBatch(db_, joiners);
+      } else {
+        Assert(jobs.front()->IsAdvanceReady());
+        jobs.front()->Advance();
+      }
+      for (auto& job : jobs) Reschedule(std::move(job));
+    }
+  }
 
-      // If we just appended, we may have unblocked other jobs.
-      if (state == SpendJoiner::State::Appended)
-        WakeBlockedJobs();
+  // Moves other query-ready jobs from the ready queue into the batch, preserving the rest.
+  // Requires mutex_ to be held.
+  void TakeQueryReadyJobs(std::vector<std::shared_ptr<SpendJoiner>>* jobs) {
+    std::vector<std::shared_ptr<SpendJoiner>> others;
+    while (!ready_queue_.empty() && std::ssize(*jobs) < kMaxQueryBatch) {
+      auto job = ready_queue_.top();
+      ready_queue_.pop();
+      (job->IsQueryReady() ? *jobs : others).push_back(std::move(job));
+    }
+    for (auto& job : others) ready_queue_.push(std::move(job));
+  }
 
-      // If the job is finished (or failed), drops our reference.
-      if (state != SpendJoiner::State::Error && !job->IsJoinReady()) {
-        std::unique_lock lock(mutex_);
-        if (job->IsAdvanceReady()) {
-          // Ready for more work immediately.
-          ready_queue_.push(std::move(job));
-          cv_.notify_one();
-        } else {
-          // Blocked (waiting for DB height).
-          blocked_list_.push_back(std::move(job));
-        }
+  void Reschedule(std::shared_ptr<SpendJoiner> job) {
+    const SpendJoiner::State state = job->GetState();
+
+    // If we just appended, we may have unblocked other jobs.
+    if (state == SpendJoiner::State::Appended)
+      WakeBlockedJobs();
+
+    // If the job is finished (or failed), drops our reference. Once fetched, the consumer may already
+    // have joined it, so every terminal state must be tested, lest it be parked and woken again.
+    using enum SpendJoiner::State;
+    if (state == Fetched || state == Joined || state == Error || state == Cancelled) return;
+    {
+      // Checking readiness under blocked_mutex_ ensures that a concurrent append cannot run its
+      // wake-up between our check and our insertion into the blocked heap.
+      std::lock_guard lock(blocked_mutex_);
+      if (!job->IsAdvanceReady()) {
+        // Blocked until the database is contiguous up to the job's height.
+        blocked_heap_.push(std::move(job));
+        return;
       }
     }
+    PushReady(std::move(job));
   }
 
+  // Wakes exactly those blocked jobs whose height is now covered by the contiguous length.
   void WakeBlockedJobs() {
-    std::lock_guard lock(mutex_);
-    // Scan the blocked list for jobs that are now ready.
-    auto it = blocked_list_.begin();
-    while (it != blocked_list_.end()) {
-      if ((*it)->IsAdvanceReady()) {
-        ready_queue_.push(std::move(*it));
-        it = blocked_list_.erase(it);
-        cv_.notify_one();
-      } else {
-        ++it;
+    std::vector<std::shared_ptr<SpendJoiner>> woken;
+    {
+      std::lock_guard lock(blocked_mutex_);
+      const int length = db_.GetContiguousLength();
+      while (!blocked_heap_.empty() && blocked_heap_.top()->GetHeight() <= length) {
+        woken.push_back(blocked_heap_.top());
+        blocked_heap_.pop();
       }
     }
+    for (auto& job : woken) PushReady(std::move(job));
+  }
+
+  void PushReady(std::shared_ptr<SpendJoiner> job) {
+    {
+      std::lock_guard lock(mutex_);
+      ready_queue_.push(std::move(job));
+    }
+    cv_.notify_one();
   }
 
   struct OrderByHeight {
@@ -113,18 +147,22 @@ class SpendPipeline {
     }
   };
 
+  static constexpr int kMaxQueryBatch = 16;
+
   Database& db_;
   std::vector<std::thread> workers_;
   
-  std::priority_queue<std::shared_ptr<SpendJoiner>, 
-                      std::vector<std::shared_ptr<SpendJoiner>>, 
-                      OrderByHeight> ready_queue_;
-                      
-  std::vector<std::shared_ptr<SpendJoiner>> blocked_list_;
-  std::vector<std::weak_ptr<SpendJoiner>> active_joiners_;
+  using JoinerHeap = std::priority_queue<std::shared_ptr<SpendJoiner>,
+                                         std::vector<std::shared_ptr<SpendJoiner>>,
+                                         OrderByHeight>;
 
+  JoinerHeap ready_queue_;                     // Guarded by mutex_.
+  std::vector<std::weak_ptr<SpendJoiner>> active_joiners_;
   std::mutex mutex_;
   std::condition_variable cv_;
+
+  JoinerHeap blocked_heap_;  // Keyed on the contiguous length each job waits for.
+  std::mutex blocked_mutex_;
   std::atomic<bool> abort_ = false;
 };
 
@@ -8,14 +8,15 @@
 #include <span>
 #include <vector>
 
+#include "hornetlib/crypto/hash.h"
 #include "hornetlib/data/utxo/atomic_vector.h"
 #include "hornetlib/data/utxo/block_outputs.h"
 #include "hornetlib/data/utxo/flusher.h"
-#include "hornetlib/data/utxo/parallel.h"
 #include "hornetlib/data/utxo/segments.h"
 #include "hornetlib/data/utxo/tiled_vector.h"
 #include "hornetlib/data/utxo/types.h"
 #include "hornetlib/protocol/block.h"
+#include "hornetlib/util/parallel_chunks.h"
 
 namespace hornet::data::utxo {
 
@@ -27,7 +28,8 @@ class Table {
 
   int Fetch(std::span<const OutputId> ids, std::span<OutputDetail> outputs,
             std::vector<uint8_t>* scripts) const;
-  int AppendOutputs(const protocol::Block& block, int height, TiledVector<OutputKV>* entries);
+  int AppendOutputs(const protocol::Block& block, int height, TiledVector<OutputKV>* entries,
+                    TiledVector<ScriptKV>* script_entries = nullptr);
   void EraseSince(int height);
   void CommitBefore(int height);
   void SetMutableWindow(int duration) noexcept;
@@ -54,7 +56,7 @@ inline Table::Table(const std::filesystem::path& folder)
       flusher_([this](int height) { CommitBefore(height); }) {}
 
 /* static */ inline void Table::SortIds(std::span<OutputId> rids) {
-  ParallelSort(rids.begin(), rids.end());
+  util::ParallelSort(rids.begin(), rids.end());
 }
 
 /* static */ inline int Table::Unpack(std::span<const OutputId> rids,
@@ -173,7 +175,8 @@ inline int Table::FetchImpl(std::span<const OutputId> rids, std::span<OutputDeta
 }
 
 inline int Table::AppendOutputs(const protocol::Block& block, int height,
-                                TiledVector<OutputKV>* entries) {
+                                TiledVector<OutputKV>* entries,
+                                TiledVector<ScriptKV>* script_entries /* = nullptr */) {
   // Calculates the number of bytes requires for this block's outputs.
   size_t bytes = 0;
   for (const auto tx : block.Transactions())
@@ -197,6 +200,8 @@ inline int Table::AppendOutputs(const protocol::Block& block, int height,
       const int length = sizeof(header) + std::ssize(pk_script);
       const OutputKV kv{prevout, {height, OutputKV::Add}, IdCodec::Encode(address, length)};
       entries->PushBack(kv);
+      if (script_entries)
+        script_entries->PushBack(ScriptKV::Funded({crypto::Sha256(pk_script), prevout}, height, kv.rid));
     }
   }
 
@@ -222,8 +227,11 @@ inline void Table::EraseSince(int height) {
 inline void Table::CommitBefore(int height) {
   int blocks = 0;
   try {
-    for (const auto& ptr : *tail_.Snapshot()) {
-      if (ptr->Height() >= height) break;
+    // Commits only a prefix that is contiguous with the segments. An appender reserves its offset
+    // before inserting into the tail, so under concurrent appends the tail may briefly have a hole.
+    const auto snapshot = tail_.Snapshot();
+    for (const auto& ptr : *snapshot) {
+      if (ptr->Height() >= height || ptr->BeginOffset() != segments_.SizeBytes()) break;
       segments_.Append(ptr->Data());
       ++blocks;
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <iterator>
 #include <vector>
@@ -56,13 +57,18 @@ class TiledVector {
     tiles_.back().push_back(value);
   }
 
+  // Removes the matching entries, preserving order. Entries are compacted across tiles, since
+  // indexing relies on every tile but the last being full.
   template <typename Pred>
   size_t EraseIf(Pred&& pred) {
-    size_t removed = 0;
-    for (auto& tile : tiles_)
-      removed += std::erase_if(tile, std::forward<Pred>(pred));
-    std::erase_if(tiles_, [](const Tile& t) { return t.empty(); });
-    return removed;
+    const size_t size = Size();
+    const size_t kept = std::remove_if(begin(), end(), std::forward<Pred>(pred)) - begin();
+    tiles_.resize((kept + entries_per_tile_ - 1) / entries_per_tile_);
+    if (!tiles_.empty()) {
+      Tile& last = tiles_.back();
+      last.erase(last.begin() + (kept - (tiles_.size() - 1) * entries_per_tile_), last.end());
+    }
+    return size - kept;
   }
 
   const T& operator[](size_t index) const {
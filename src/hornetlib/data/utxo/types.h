@@ -2,6 +2,7 @@
 
 #include <compare>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 #include "hornetlib/protocol/transaction.h"
@@ -42,44 +43,56 @@ using OutputId = uint64_t;
 static constexpr OutputId kNullOutputId = 0;
 static constexpr OutputId kSpentOutputId = -1;
 
-struct OutputKV {
+// Key for the optional secondary index, which groups outputs by the SHA-256 of their pubkey script.
+struct ScriptKey {
+  std::strong_ordering operator <=>(const ScriptKey&) const = default;
+  protocol::Hash hash;
+  OutputKey outpoint;
+};
+
+// An index record: a key, the height and operation that produced it, and the output's ID.
+template <typename Key>
+struct KeyValue {
   enum Operation { Delete = -1, Add = 0 };
   
-  std::strong_ordering operator <=>(const OutputKV& rhs) const noexcept {
+  std::strong_ordering operator <=>(const KeyValue& rhs) const noexcept {
     if (auto cmp = key <=> rhs.key; cmp != 0) return cmp;
     return rhs.data.height <=> data.height;
   }
-  bool operator ==(const OutputKV& rhs) const {
+  bool operator ==(const KeyValue& rhs) const {
     return operator <=>(rhs) == 0;
   }
-  bool operator !=(const OutputKV& rhs) const {
+  bool operator !=(const KeyValue& rhs) const {
     return operator <=>(rhs) != 0;
   }
-  friend std::strong_ordering operator<=>(const OutputKV& lhs, const OutputKey& rhs) {
+  friend std::strong_ordering operator<=>(const KeyValue& lhs, const Key& rhs) {
     return lhs.key <=> rhs;
   }
-  friend std::strong_ordering operator<=>(const OutputKey& lhs, const OutputKV& rhs) {
+  friend std::strong_ordering operator<=>(const Key& lhs, const KeyValue& rhs) {
     return lhs <=> rhs.key;
   }
   bool IsAdd() const { return data.op == Operation::Add; }
   bool IsDelete() const { return data.op == Operation::Delete; }
   int Height() const { return data.height; }
 
-  static OutputKV Spent(const OutputKey& key, int height) {
+  static KeyValue Spent(const Key& key, int height) {
     return { key, { height, Delete }, kNullOutputId };
   }
 
-  static OutputKV Funded(const OutputKey& key, int height, OutputId rid) {
+  static KeyValue Funded(const Key& key, int height, OutputId rid) {
     return { key, { height, Add }, rid };
   }
 
-  OutputKey key;
+  Key key;
   struct {
     int height : 31;
     int op     :  1;
   } data;
   OutputId rid;
 };
+
+using OutputKV = KeyValue<OutputKey>;
+using ScriptKV = KeyValue<ScriptKey>;
 static_assert(sizeof(OutputKV) == 48);
 
 struct QueryResult {
@@ -93,4 +106,21 @@ struct QueryResult {
   }
 };
 
+// One block's part of a batched query: its sorted keys, the IDs to fill, its visible heights
+// [since, before), and the accumulated result.
+struct QueryRequest {
+  std::span<const OutputKey> keys;
+  std::span<OutputId> rids;
+  int since = 0;
+  int before = 0;
+  QueryResult result = {};
+};
+
+// A key in the merged stream of a batched query, routed back to slot `index` of request `request`.
+struct QueryItem {
+  OutputKey key;
+  int request;
+  int index;
+};
+
 }  // namespace hornet::data::utxo
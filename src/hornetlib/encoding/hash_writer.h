@@ -0,0 +1,53 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "hornetlib/crypto/hash.h"
+#include "hornetlib/crypto/sha256.h"
+#include "hornetlib/encoding/writer.h"
+
+namespace hornet::encoding {
+
+// A writer that feeds the bytes written straight into a SHA-256 state, which compresses them 64
+// bytes at a time, so that a serialization can be hashed without being buffered.
+class HashWriter : public WriterBase<HashWriter> {
+ public:
+  // Write raw byte
+  size_t WriteByte(uint8_t byte) {
+    return WriteBytes({&byte, 1});
+  }
+
+  // Write raw bytes
+  size_t WriteBytes(std::span<const uint8_t> span) {
+    const size_t offset = size_;
+    context_.Update(span);
+    size_ += span.size();
+    return offset;
+  }
+
+  // Returns the number of bytes written
+  size_t GetPos() const {
+    return size_;
+  }
+
+  // Returns the SHA256 hash of the bytes written. The writer must not be used afterwards.
+  crypto::bytes32_t GetHash() {
+    return context_.Final();
+  }
+
+  // Returns the double-SHA256 hash of the bytes written. The writer must not be used afterwards.
+  crypto::bytes32_t GetDoubleHash() {
+    return crypto::Sha256(GetHash());
+  }
+
+ private:
+  crypto::SHA256::Context context_;
+  size_t size_ = 0;
+};
+
+}  // namespace hornet::encoding
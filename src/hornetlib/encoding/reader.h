@@ -35,6 +35,11 @@ class Reader {
     return pos_ >= buffer_.size();
   }
 
+  // Returns the bytes not yet read, without consuming them.
+  std::span<const uint8_t> Remaining() const {
+    return buffer_.subspan(pos_);
+  }
+
   uint8_t ReadByte() {
     RequireAvailable(1);
     return buffer_[pos_++];
@@ -16,53 +16,18 @@
 
 namespace hornet::encoding {
 
-class Writer {
+// Provides the encodings of integers and strings to a writer that derives from it, in terms of the
+// writer's WriteByte, WriteBytes and GetPos.
+template <typename Derived>
+class WriterBase {
  public:
-  Writer() : pos_(buffer_.end()) {}
-
-  // Write raw byte
-  size_t WriteByte(uint8_t byte) {
-    size_t before = GetPos();
-
-    if (pos_ == buffer_.end()) {
-      buffer_.push_back(byte);
-      pos_ = buffer_.end();
-    } else {
-      *pos_++ = byte;
-    }
-    return before;
-  }
-
   size_t WriteBool(bool flag) {
-    return WriteByte(static_cast<uint8_t>(flag ? 1 : 0));
-  }
-
-  // Write raw bytes
-  size_t WriteBytes(std::span<const uint8_t> span) {
-    size_t offset = GetPos();
-
-    if (pos_ == buffer_.end()) {
-      // Append to the end of the buffer
-      buffer_.insert(pos_, span.begin(), span.end());
-      pos_ = buffer_.end();
-    } else {
-      // Overwrite the current data
-      auto remaining = std::distance(pos_, buffer_.end());
-      size_t to_write = std::min<size_t>(remaining, span.size());
-      std::copy_n(span.begin(), to_write, pos_);
-      pos_ += to_write;
-      // Appends the remaining data to the buffer end
-      if (to_write < span.size()) {
-        buffer_.insert(pos_, span.begin() + to_write, span.end());
-        pos_ = buffer_.end();
-      }
-    }
-    return offset;
+    return Self().WriteByte(static_cast<uint8_t>(flag ? 1 : 0));
   }
 
   template <std::integral T>
   size_t WriteRaw(T value) {
-    return WriteBytes({reinterpret_cast<const uint8_t *>(&value), sizeof(T)});
+    return Self().WriteBytes({reinterpret_cast<const uint8_t *>(&value), sizeof(T)});
   }
 
   // Writes an integral value in little-endian order
@@ -106,18 +71,18 @@ class Writer {
   size_t WriteVarInt(T value) {
     if (value < 0)
       util::ThrowInvalidArgument("Encoder::WriteVarInt passed negative value ", value, ".");
-    size_t pos = GetPos();
+    size_t pos = Self().GetPos();
     const uint64_t x = static_cast<uint64_t>(value);
     if (x < 0xFD) {
-      WriteByte(static_cast<uint8_t>(x));
+      Self().WriteByte(static_cast<uint8_t>(x));
     } else if (x <= 0xFFFF) {
-      WriteByte(0xFD);
+      Self().WriteByte(0xFD);
       WriteLE(static_cast<uint16_t>(x));
     } else if (x <= 0xFFFFFFFF) {
-      WriteByte(0xFE);
+      Self().WriteByte(0xFE);
       WriteLE(static_cast<uint32_t>(x));
     } else {
-      WriteByte(0xFF);
+      Self().WriteByte(0xFF);
       WriteLE(x);
     }
     return pos;
@@ -126,7 +91,7 @@ class Writer {
   // Writes a variable-length string
   size_t WriteVarString(const std::string &s) {
     size_t pos = WriteVarInt(s.size());
-    WriteBytes({reinterpret_cast<const uint8_t *>(s.data()), s.size()});
+    Self().WriteBytes({reinterpret_cast<const uint8_t *>(s.data()), s.size()});
     return pos;
   }
 
@@ -138,7 +103,51 @@ class Writer {
     }
     std::array<char, kLength> cstr = {};
     std::copy_n(str.data(), std::min(str.size(), kLength), cstr.begin());
-    return WriteBytes({reinterpret_cast<const uint8_t *>(cstr.data()), sizeof(cstr)});
+    return Self().WriteBytes({reinterpret_cast<const uint8_t *>(cstr.data()), sizeof(cstr)});
+  }
+
+ private:
+  Derived &Self() { return static_cast<Derived &>(*this); }
+};
+
+class Writer : public WriterBase<Writer> {
+ public:
+  Writer() : pos_(buffer_.end()) {}
+
+  // Write raw byte
+  size_t WriteByte(uint8_t byte) {
+    size_t before = GetPos();
+
+    if (pos_ == buffer_.end()) {
+      buffer_.push_back(byte);
+      pos_ = buffer_.end();
+    } else {
+      *pos_++ = byte;
+    }
+    return before;
+  }
+
+  // Write raw bytes
+  size_t WriteBytes(std::span<const uint8_t> span) {
+    size_t offset = GetPos();
+
+    if (pos_ == buffer_.end()) {
+      // Append to the end of the buffer
+      buffer_.insert(pos_, span.begin(), span.end());
+      pos_ = buffer_.end();
+    } else {
+      // Overwrite the current data
+      auto remaining = std::distance(pos_, buffer_.end());
+      size_t to_write = std::min<size_t>(remaining, span.size());
+      std::copy_n(span.begin(), to_write, pos_);
+      pos_ += to_write;
+      // Appends the remaining data to the buffer end
+      if (to_write < span.size()) {
+        buffer_.insert(pos_, span.begin() + to_write, span.end());
+        pos_ = buffer_.end();
+      }
+    }
+    return offset;
   }
 
   // Returns the current seek position
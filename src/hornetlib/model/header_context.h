@@ -4,6 +4,10 @@
 // For licensing or usage inquiries, contact: ask@hornetnode.com.
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
 #include <ostream>
 
 #include "hornetlib/protocol/block_header.h"
@@ -12,6 +16,45 @@
 
 namespace hornet::model {
 
+// The timestamps of the most recent headers in a chain, oldest first, ending at the newest header.
+// Pushing a header slides the window forward in constant time. Popping the newest header cannot
+// recover the timestamp before the oldest, so the window then holds one fewer timestamp.
+class TimestampWindow {
+ public:
+  static constexpr int kCapacity = 11;  // The number of ancestors in the median time past.
+
+  TimestampWindow Push(uint32_t timestamp) const {
+    TimestampWindow window;
+    std::copy(timestamps_.begin() + 1, timestamps_.end(), window.timestamps_.begin());
+    window.timestamps_.back() = timestamp;
+    window.size_ = std::min(size_ + 1, kCapacity);
+    return window;
+  }
+
+  TimestampWindow Pop() const {
+    TimestampWindow window;
+    std::copy(timestamps_.begin(), timestamps_.end() - 1, window.timestamps_.begin() + 1);
+    window.size_ = std::max(size_ - 1, 0);
+    return window;
+  }
+
+  int Size() const {
+    return size_;
+  }
+
+  // Returns the median of the timestamps in the window.
+  uint32_t Median() const {
+    std::array<uint32_t, kCapacity> sorted = timestamps_;
+    const auto begin = sorted.end() - size_;
+    std::nth_element(begin, begin + size_ / 2, sorted.end());
+    return begin[size_ / 2];
+  }
+
+ private:
+  std::array<uint32_t, kCapacity> timestamps_ = {};  // The last size_ entries are valid.
+  int size_ = 0;
+};
+
 struct HeaderContext {
   static HeaderContext Null() {
     return {{}, {}, {}, {}, -1};
@@ -19,22 +62,30 @@ struct HeaderContext {
 
   static HeaderContext Genesis(const protocol::BlockHeader& header) {
     const auto work = header.GetWork();
-    return HeaderContext{header, header.ComputeHash(), work, work, 0}; 
+    return HeaderContext{header, header.ComputeHash(), work, work, 0,
+                         TimestampWindow{}.Push(header.GetTimestamp())};
   }
 
   HeaderContext Extend(const protocol::BlockHeader& next, const protocol::Hash& hash) const {
     const auto work = next.GetWork();
-    return {next, hash, work, total_work + work, height + 1};
+    return {next, hash, work, total_work + work, height + 1, timestamps.Push(next.GetTimestamp())};
   }
 
   HeaderContext Extend(const protocol::BlockHeader& next) const {
-    const auto work = next.GetWork();
-    return {next, next.ComputeHash(), work, total_work + work, height + 1};
+    return Extend(next, next.ComputeHash());
   }
 
   HeaderContext Rewind(const protocol::BlockHeader& prev) const {
     const auto hash = data.GetPreviousBlockHash();
-    return {prev, hash, prev.GetWork(), total_work - local_work, height - 1};
+    return {prev, hash, prev.GetWork(), total_work - local_work, height - 1, timestamps.Pop()};
+  }
+
+  // Returns the median timestamp of this header and its ancestors, up to TimestampWindow::kCapacity
+  // of them, or nullopt if the context doesn't carry all of their timestamps.
+  std::optional<uint32_t> MedianTimePast() const {
+    if (height < 0 || timestamps.Size() < std::min(height + 1, TimestampWindow::kCapacity))
+      return std::nullopt;
+    return timestamps.Median();
   }
 
   friend std::ostream& operator <<(std::ostream& os, const HeaderContext& obj) {
@@ -52,6 +103,7 @@ struct HeaderContext {
   protocol::Work local_work;
   protocol::Work total_work;
   int height = -1;
+  TimestampWindow timestamps;  // Incrementally maintained by Extend, for MedianTimePast.
 };
 
 }  // namespace hornet::model
@@ -5,15 +5,19 @@
 #pragma once
 
 #include <ranges>
+#include <span>
 #include <vector>
 
+#include "hornetlib/crypto/sha256_batch.h"
 #include "hornetlib/encoding/reader.h"
 #include "hornetlib/encoding/writer.h"
 #include "hornetlib/protocol/block_header.h"
 #include "hornetlib/protocol/transaction.h"
+#include "hornetlib/protocol/transaction_scanner.h"
 #include "hornetlib/protocol/script/view.h"
 #include "hornetlib/util/io.h"
 #include "hornetlib/util/iterator_range.h"
+#include "hornetlib/util/parallel_chunks.h"
 
 namespace hornet::protocol {
 
@@ -59,6 +63,11 @@ class Block {
     transactions_.push_back(detail);
   }
 
+  // Computes the txid and wtxid of every transaction, on the shared worker pool for large blocks,
+  // and caches them in each transaction, so that readers never compute them lazily and may read
+  // them concurrently.
+  void ComputeHashes();
+
   // Returns the number of weight units (WU) for the block.
   int GetWeightUnits() const {
     return 4 * serialized_bytes_ - 3 * data_.GetWitnessBytes();
@@ -77,6 +86,21 @@ class Block {
     return size;
   }
 
+  // Returns the number of bytes allocated for the block beyond those in use.
+  int UnusedBytes() const {
+    const int unused_transactions = transactions_.capacity() - transactions_.size();
+    return unused_transactions * sizeof(TransactionDetail) + data_.UnusedBytes();
+  }
+
+  // Returns the number of times the transaction arrays grew by reallocation while being filled,
+  // and the bytes those reallocations copied.
+  int GetReallocations() const {
+    return data_.GetReallocations();
+  }
+  int64_t GetReallocatedBytes() const {
+    return data_.GetReallocatedBytes();
+  }
+
   void Serialize(encoding::Writer& writer, bool include_witness = true) const {
     header_.Serialize(writer);
     writer.WriteVarInt(transactions_.size());
@@ -94,6 +118,14 @@ class Block {
     if (txn_count > kUpperBoundTxInBlock)
       util::ThrowOutOfRange("Too many transactions in block: ", txn_count, ".");
     transactions_.resize(txn_count);
+
+    // A first pass counts the elements of every transaction, so that each array is allocated once,
+    // at its exact size. A truncated block is left for the second pass to reject.
+    TransactionScanner scanner{reader.Remaining()};
+    size_t scanned = 0;
+    while (scanned < txn_count && scanner.Scan()) ++scanned;
+    if (scanned == txn_count) data_.Reserve(scanner.Counts());
+
     for (auto& tx : transactions_)
       tx.Deserialize(reader, data_);
     const auto end = reader.GetPos();
@@ -101,6 +133,15 @@ class Block {
     serialized_bytes_ = end - start;
   }
 
+  // Deserializes a block from a shared payload, borrowing its script bytes in place rather than
+  // copying them. The block keeps the payload alive, and copies the bytes only if it is modified.
+  void Deserialize(ScriptBytes::Payload payload) {
+    data_ = {};
+    data_.scripts.Borrow(payload);
+    encoding::Reader reader{*payload};
+    Deserialize(reader);
+  }
+
   void Write(std::ofstream& os) const {
     constexpr int32_t kVersion = 1;
     util::Write(os, kVersion);
@@ -126,10 +167,31 @@ class Block {
   }
 
  private:
+  friend class BlockParser;
+
   BlockHeader header_;
   std::vector<TransactionDetail> transactions_;
   TransactionData data_;
   int serialized_bytes_ = 0;
 };
 
+inline void Block::ComputeHashes() {
+  constexpr int kMinChunk = 256;  // Transactions per chunk, amortizing the dispatch cost.
+  util::ParallelChunks(GetTransactionCount(), kMinChunk, [&](int, int begin, int end) {
+    // Streams each serialization through the inner hash, then computes the outer hashes of the
+    // 32-byte digests together with the multi-lane kernel, in the chunk's own scratch storage.
+    const int count = end - begin;
+    std::vector<Hash> hashes(2 * count);
+    Hash* const txids = hashes.data();
+    Hash* const wtxids = txids + count;
+    for (int i = 0; i < count; ++i) {
+      const TransactionDetail& tx = transactions_[begin + i];
+      txids[i] = ComputeTxidInnerHash(tx, data_, false);
+      wtxids[i] = tx.IsWitness() ? ComputeTxidInnerHash(tx, data_, true) : txids[i];
+    }
+    crypto::SHA256::Hash32(txids->data(), sizeof(Hash), 2 * count, txids->data(), sizeof(Hash));
+    for (int i = 0; i < count; ++i) transactions_[begin + i].SetHashes(txids[i], wtxids[i]);
+  });
+}
+
 }  // namespace hornet::protocol
@@ -0,0 +1,137 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "hornetlib/crypto/sha256.h"
+#include "hornetlib/encoding/reader.h"
+#include "hornetlib/protocol/block.h"
+#include "hornetlib/protocol/header.h"
+#include "hornetlib/protocol/parser.h"
+#include "hornetlib/protocol/transaction_scanner.h"
+#include "hornetlib/util/throw.h"
+
+namespace hornet::protocol {
+
+// Parses the payload of a block message incrementally, as its bytes arrive. Each call appends the
+// bytes to the payload, hashes them into the checksum, and parses the block header and every whole
+// transaction received so far, so that the block is already parsed and checksummed when its last
+// byte lands. The block borrows its script bytes from the payload, rather than copying them.
+class BlockParser {
+ public:
+  explicit BlockParser(const Header& header)
+      : header_(header), payload_(std::make_shared<std::vector<uint8_t>>()) {
+    payload_->reserve(header.bytes);
+    block_.data_.scripts.Borrow(payload_);
+  }
+
+  // Consumes bytes from the front of the given buffer, up to the end of the payload, and returns
+  // the number of bytes consumed.
+  size_t Parse(std::span<const uint8_t> bytes);
+
+  bool IsComplete() const {
+    return payload_->size() == header_.bytes;
+  }
+
+  // Returns the number of payload bytes not yet consumed.
+  size_t RemainingBytes() const {
+    return header_.bytes - payload_->size();
+  }
+
+  // Verifies the checksum and returns the parsed block. Requires IsComplete.
+  Block Finish();
+
+ private:
+  // There's no way for 100K transactions to fit in a 4MB block.
+  static constexpr size_t kUpperBoundTxInBlock = 100'000;
+
+  void ParseHeader();
+  // Ensures the block has room for the next transaction, with the given counts and size. When it
+  // does not, reserves room for the rest of the block, projected from the transactions so far.
+  void Presize(const TransactionCounts& next, size_t size);
+
+  const Header header_;
+  crypto::SHA256::Context checksum_;
+  std::shared_ptr<std::vector<uint8_t>> payload_;  // The bytes consumed so far.
+  size_t parsed_ = 0;                              // The bytes parsed so far.
+  size_t transactions_begin_ = 0;                  // The offset of the first transaction.
+  size_t transaction_count_ = 0;
+  bool has_header_ = false;
+  Block block_;
+};
+
+inline size_t BlockParser::Parse(std::span<const uint8_t> bytes) {
+  bytes = bytes.first(std::min(bytes.size(), RemainingBytes()));
+  payload_->insert(payload_->end(), bytes.begin(), bytes.end());
+  checksum_.Update(bytes);
+
+  if (!has_header_) ParseHeader();
+  while (has_header_ && block_.transactions_.size() < transaction_count_) {
+    const auto payload = std::span<const uint8_t>{*payload_};
+    TransactionScanner scanner{payload.subspan(parsed_)};
+    const auto size = scanner.Scan();
+    if (!size) break;
+    Presize(scanner.Counts(), *size);
+    // Reads from the whole payload, so that scripts are indexed at their offsets in the payload.
+    encoding::Reader reader{payload.first(parsed_ + *size)};
+    reader.Seek(parsed_);
+    block_.transactions_.emplace_back().Deserialize(reader, block_.data_);
+    parsed_ += *size;
+  }
+  if (IsComplete() && (!has_header_ || block_.transactions_.size() < transaction_count_))
+    util::ThrowOutOfRange("Block payload ends inside a transaction.");
+  return bytes.size();
+}
+
+inline void BlockParser::ParseHeader() {
+  // The block header is followed by the transaction count, whose width is given by its first byte.
+  constexpr size_t kCountOffset = 80;  // The size of a serialized block header.
+  if (payload_->size() <= kCountOffset) return;
+  const uint8_t prefix = (*payload_)[kCountOffset];
+  const size_t width = prefix < 0xFD ? 1 : prefix == 0xFD ? 3 : prefix == 0xFE ? 5 : 9;
+  if (payload_->size() < kCountOffset + width) return;
+
+  encoding::Reader reader{*payload_};
+  block_.header_.Deserialize(reader);
+  transaction_count_ = reader.ReadVarInt();
+  if (transaction_count_ > kUpperBoundTxInBlock)
+    util::ThrowOutOfRange("Too many transactions in block: ", transaction_count_, ".");
+  block_.transactions_.reserve(transaction_count_);
+  parsed_ = transactions_begin_ = reader.GetPos();
+  has_header_ = true;
+}
+
+inline void BlockParser::Presize(const TransactionCounts& next, size_t size) {
+  auto& data = block_.data_;
+  if (data.HasRoom(next)) return;
+  // Scales the counts so far by the ratio of all transaction bytes to those parsed so far.
+  const auto seen = static_cast<int64_t>(parsed_ + size - transactions_begin_);
+  const auto total = static_cast<int64_t>(header_.bytes - transactions_begin_);
+  const auto further = [&](size_t current, int64_t count) {
+    return (static_cast<int64_t>(current) + count) * total / seen - static_cast<int64_t>(current);
+  };
+  // Script bytes are borrowed from the payload, so they need no room.
+  data.Reserve({.inputs = further(data.inputs.size(), next.inputs),
+                .outputs = further(data.outputs.size(), next.outputs),
+                .witnesses = further(data.witnesses.size(), next.witnesses),
+                .components = further(data.components.size(), next.components)});
+}
+
+inline Block BlockParser::Finish() {
+  Assert(IsComplete());
+  if (!has_header_) util::ThrowOutOfRange("Block payload is truncated.");
+  const auto hash = checksum_.Final();
+  Parser::VerifyChecksum(header_, crypto::SHA256::Hash(hash));
+  // Any bytes trailing the last transaction are hashed, but otherwise ignored.
+  block_.serialized_bytes_ = static_cast<int>(parsed_);
+  return std::move(block_);
+}
+
+}  // namespace hornet::protocol
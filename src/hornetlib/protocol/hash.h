@@ -6,12 +6,15 @@
 
 #include <array>
 #include <cassert>
+#include <charconv>
 #include <compare>
 #include <cstdint>
 #include <cstring>
 #include <iomanip>
 #include <ios>
+#include <optional>
 #include <ostream>
+#include <string_view>
 
 // Proof-of-work types and relationships:
 //
@@ -35,6 +38,17 @@ struct Hash : public std::array<uint8_t, 32> {
     for (size_t i = 0; i < x.size(); ++i) (*this)[i] = *it++;
     for (size_t i = x.size(); i < 32; ++i) (*this)[i] = 0;
   }
+  // Parses a hash from 64 hex digits in display order, i.e. most significant byte first.
+  static std::optional<Hash> FromHex(std::string_view hex) {
+    if (hex.size() != 2 * sizeof(Base)) return std::nullopt;
+    Hash hash;
+    for (int i = 0; i < int(sizeof(Base)); ++i) {
+      const char* const digits = hex.data() + 2 * i;
+      const auto [end, error] = std::from_chars(digits, digits + 2, hash[sizeof(Base) - 1 - i], 16);
+      if (error != std::errc{} || end != digits + 2) return std::nullopt;
+    }
+    return hash;
+  }
   bool IsNull() const {
     return *this == Hash{};
   }
@@ -12,14 +12,15 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include "hornetlib/encoding/reader.h"
 #include "hornetlib/protocol/message_handler.h"
 #include "hornetlib/util/throw.h"
 
 // Forward declarations;
 namespace hornet::encoding {
 class Writer;
-class Reader;
 }  // namespace hornet::encoding
 
 namespace hornet::protocol {
@@ -39,6 +40,11 @@ class Message {
   virtual ~Message() = default;
   virtual void Serialize(encoding::Writer&) const {}
   virtual void Deserialize(encoding::Reader&) {}
+  // Deserializes from a shared payload, which a message may keep alive to reference in place.
+  virtual void DeserializeShared(std::shared_ptr<const std::vector<uint8_t>> payload) {
+    encoding::Reader reader{*payload};
+    Deserialize(reader);
+  }
   virtual std::string GetName() const = 0;
   virtual void Notify(MessageHandler& handler) const {
     handler.OnMessage(*this);
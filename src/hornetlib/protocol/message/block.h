@@ -1,6 +1,8 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "hornetlib/protocol/block.h"
 #include "hornetlib/protocol/transaction.h"
@@ -27,9 +29,24 @@ class Block : public Message {
   virtual void Deserialize(encoding::Reader& reader) override {
     protocol::Block block;
     block.Deserialize(reader);
-    block_ = std::make_shared<const protocol::Block>(std::move(block));
+    SetBlock(std::move(block));
   };
 
+  // Borrows the block's script bytes from the payload instead of copying them.
+  virtual void DeserializeShared(std::shared_ptr<const std::vector<uint8_t>> payload) override {
+    protocol::Block block;
+    block.Deserialize(std::move(payload));
+    SetBlock(std::move(block));
+  }
+
+  // Sets the block, e.g. one parsed incrementally as it arrived.
+  void SetBlock(protocol::Block block) {
+    // Computes the transaction hashes ahead of validation. Large blocks are split across the shared
+    // worker pool, which the parsing thread joins, so decoder threads never start threads of their own.
+    block.ComputeHashes();
+    block_ = std::make_shared<const protocol::Block>(std::move(block));
+  }
+
  protected:
   std::shared_ptr<const protocol::Block> block_;
 };
@@ -35,8 +35,30 @@ class Parser {
     return header;
   }
 
-  // Parses (unframes) a buffer to extract command and payload.
+  // Parses (unframes) a buffer to extract command and payload, verifying the checksum.
   ParsedMessage Parse(std::span<const uint8_t> buffer) const {
+    const ParsedMessage parsed = Unframe(buffer);
+    VerifyChecksum(parsed);
+    return parsed;
+  }
+
+  // Unframes a buffer to extract command and payload, validating the header but deferring the
+  // checksum, which hashes the whole payload, to a later call to VerifyChecksum.
+  ParsedMessage Unframe(std::span<const uint8_t> buffer) const {
+    const Header header = UnframeHeader(buffer);
+
+    // Validate buffer length -- incomplete messages not allowed here.
+    if (header.bytes > buffer.size() - kHeaderLength) {
+      throw Error("Declared payload length exceeds buffer size.");
+    }
+
+    // Return unframed payload
+    return {header, buffer.subspan(kHeaderLength, header.bytes)};
+  }
+
+  // Reads and validates the header at the front of a buffer, which may hold only part of the
+  // payload, e.g. for a payload parsed as it arrives.
+  Header UnframeHeader(std::span<const uint8_t> buffer) const {
     // Validate buffer holds enough data for header.
     if (buffer.size() < kHeaderLength) {
       throw Error("Message too short: requires 24-byte header.");
@@ -50,24 +72,24 @@ class Parser {
       throw Error("Invalid magic bytes.");
     }
 
-    // Validate buffer length -- incomplete messages not allowed here.
-    if (header.bytes > buffer.size() - kHeaderLength) {
-      throw Error("Declared payload length exceeds buffer size.");
-    } else if (header.bytes > kMaxMessageSize) {
+    // Validate the declared length.
+    if (header.bytes > kMaxMessageSize) {
       throw Error("Payload size exceeds protocol maximum.");
     }
+    return header;
+  }
 
-    // Extract payload
-    const auto payload = buffer.subspan(kHeaderLength, header.bytes);
+  // Validates the payload against the checksum in its header.
+  static void VerifyChecksum(const ParsedMessage& parsed) {
+    VerifyChecksum(parsed.header, crypto::DoubleSha256(parsed.payload));
+  }
 
-    // Validate checksum
-    const auto hash = crypto::DoubleSha256(payload);
-    if (!std::equal(header.checksum.begin(), header.checksum.end(), hash.begin())) {
+  // Validates the double SHA-256 of a payload, e.g. one hashed as it arrived, against the checksum
+  // in its header.
+  static void VerifyChecksum(const Header& header, const crypto::bytes32_t& payload_hash) {
+    if (!std::equal(header.checksum.begin(), header.checksum.end(), payload_hash.begin())) {
       throw Error("Checksum mismatch");
     }
-
-    // Return unframed payload
-    return {header, payload};
   }
 
   // Determines whether a buffer contains at least one complete message, ready
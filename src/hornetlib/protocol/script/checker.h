@@ -0,0 +1,103 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "hornetlib/protocol/script/lang/types.h"
+#include "hornetlib/protocol/script/parser.h"
+#include "hornetlib/protocol/script/runtime/engine.h"
+#include "hornetlib/protocol/script/runtime/signature.h"
+#include "hornetlib/protocol/script/sighash.h"
+#include "hornetlib/protocol/script/writer.h"
+#include "hornetlib/protocol/transaction.h"
+#include "hornetlib/util/assert.h"
+
+namespace hornet::protocol::script {
+
+namespace detail {
+
+// Returns the script with every push of the given data removed, matching at instruction boundaries
+// as consensus does when removing a signature from legacy script code.
+inline std::vector<uint8_t> FindAndDelete(lang::Bytes script, lang::Bytes data) {
+  Writer writer;
+  writer.PushData(data);
+  const std::vector<uint8_t> pattern = writer.Release();
+  std::vector<uint8_t> result;
+  size_t position = 0, copied = 0;
+  bool found = false;
+  while (true) {
+    result.insert(result.end(), script.begin() + copied, script.begin() + position);
+    while (script.size() - position >= pattern.size() &&
+           std::equal(pattern.begin(), pattern.end(), script.begin() + position)) {
+      position += pattern.size();
+      found = true;
+    }
+    copied = position;
+    Parser parser{script.subspan(position)};
+    if (!parser.Next()) break;
+    position += parser.Position();
+  }
+  if (!found) return {script.begin(), script.end()};
+  result.insert(result.end(), script.begin() + copied, script.end());
+  return result;
+}
+
+}  // namespace detail
+
+// Checks signatures over the signature hashes of one transaction input.
+class TransactionSignatureChecker : public runtime::SignatureChecker {
+ public:
+  // The precomputed data must be for the transaction, with all its spent outputs.
+  TransactionSignatureChecker(const TransactionConstView tx, int input, const SpentOutput& spent,
+                              const LazyPrecomputedTransactionData& precomputed)
+      : tx_(tx), input_(input), spent_(spent), precomputed_(precomputed) {}
+
+  bool CheckEcdsa(const runtime::Environment& env, lang::Bytes signature, lang::Bytes public_key,
+                  lang::Bytes script_code) const override;
+  bool CheckSchnorr(const runtime::Environment& env, lang::Bytes signature, lang::Bytes public_key,
+                    std::optional<lang::Bytes> annex) const override;
+
+ private:
+  const TransactionConstView tx_;
+  const int input_;
+  const SpentOutput spent_;
+  const LazyPrecomputedTransactionData& precomputed_;
+};
+
+inline bool TransactionSignatureChecker::CheckEcdsa(const runtime::Environment& env, lang::Bytes signature,
+                                                    lang::Bytes public_key, lang::Bytes script_code) const {
+  if (signature.empty()) return false;
+  const uint8_t hash_type = signature.back();
+  crypto::bytes32_t sighash;
+  if (env.version == runtime::Version::Legacy) {
+    // Legacy script code never includes the signature itself.
+    sighash = LegacySighash(tx_, input_, detail::FindAndDelete(script_code, signature), hash_type);
+  } else {
+    const PrecomputedTransactionData& precomputed = precomputed_.Get();
+    Assert(precomputed.segwit_ready);
+    sighash = SegwitV0Sighash(tx_, precomputed, input_, script_code, spent_.amount, hash_type);
+  }
+  return runtime::CheckEcdsaSignature(env, public_key, signature.first(signature.size() - 1), sighash);
+}
+
+inline bool TransactionSignatureChecker::CheckSchnorr(const runtime::Environment& env, lang::Bytes signature,
+                                                      lang::Bytes public_key,
+                                                      std::optional<lang::Bytes> annex) const {
+  if (public_key.size() != 32 || (signature.size() != 64 && signature.size() != 65)) return false;
+  // An explicit hash type byte may not restate the default.
+  const uint8_t hash_type = signature.size() == 65 ? signature.back() : sighash::kDefault;
+  if (signature.size() == 65 && hash_type == sighash::kDefault) return false;
+  const PrecomputedTransactionData& precomputed = precomputed_.Get();
+  Assert(precomputed.taproot_ready);
+  const auto sighash = TaprootSighash(tx_, precomputed, input_, spent_, hash_type, annex);
+  return sighash && runtime::CheckSchnorrSignature(env, public_key.first<32>(), signature.first<64>(), *sighash);
+}
+
+}  // namespace hornet::protocol::script
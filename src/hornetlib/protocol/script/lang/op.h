@@ -39,6 +39,7 @@ enum class Op : uint8_t {
   PushTrue = PushConst1,      // Pushes the immediate Boolean TRUE.
 
   // Control operations.
+  Verify = 0x69,
   Return = 0x6a,
   
   // Stack operations.
@@ -48,10 +49,15 @@ enum class Op : uint8_t {
 
   // Bitwise operations.
   Equal = 0x87,
+  EqualVerify = 0x88,
 
   // Arithmetic operations.
   Add = 0x93,
 
+  // Cryptographic hashing operations.
+  Hash160 = 0xa9,
+  CodeSeparator = 0xab,
+
   // Check signature opcodes.
   CheckSig = 0xac,
   CheckSigVerify = 0xad,
@@ -24,13 +24,29 @@ struct Instruction {
 
 // Reasons for Bitcoin Script failure.
 enum class Error {
-  NonMinimalNumber,   // An integer was not encoded minimally.
-  NonMinimalPush,     // A push operation did not use the minimal opcode.
-  NumberOverflow,     // An encoded integer was outside the permitted size range.
-  StackItemOverflow,  // An item pushed to the stack was too large.
-  StackOverflow,      // Too many items were pushed to the stack.
-  StackUnderflow,     // An empty stack was popped.
-  OpCountExcessive    // Too many non-push operations were encountered in the script.
+  NonMinimalNumber,            // An integer was not encoded minimally.
+  NonMinimalPush,              // A push operation did not use the minimal opcode.
+  NumberOverflow,              // An encoded integer was outside the permitted size range.
+  StackItemOverflow,           // An item pushed to the stack was too large.
+  StackOverflow,               // Too many items were pushed to the stack.
+  StackUnderflow,              // An empty stack was popped.
+  OpCountExcessive,            // Too many non-push operations were encountered in the script.
+  ScriptSize,                  // A script exceeded the maximum script size.
+  BadOpcode,                   // A script ended in the middle of a push instruction.
+  EvalFalse,                   // A script finished with an empty or false top-of-stack.
+  Verify,                      // OP_VERIFY found a false top-of-stack.
+  EqualVerify,                 // OP_EQUALVERIFY found unequal items.
+  CheckSigVerify,              // OP_CHECKSIGVERIFY found an invalid signature.
+  SigDer,                      // A signature was not strictly DER-encoded, as required by BIP66.
+  SigPushOnly,                 // A P2SH signature script contained a non-push operation.
+  CleanStack,                  // A witness script left other than exactly one item on the stack.
+  SchnorrSig,                  // A Taproot key-path signature was invalid.
+  WitnessProgramWrongLength,   // A witness v0 program was neither 20 nor 32 bytes.
+  WitnessProgramWitnessEmpty,  // A witness program was spent with an empty witness.
+  WitnessProgramMismatch,      // The witness did not match the witness program.
+  WitnessMalleated,            // A native witness program was spent with a signature script.
+  WitnessMalleatedP2SH,        // A P2SH witness program had a signature script other than its push.
+  WitnessUnexpected            // A witness was given for an input that is not a witness program.
 };
 
 }  // namespace hornet::protocol::script::lang
@@ -28,6 +28,7 @@ class Parser {
     const auto size = ReadInstructionSize(opcode, it_pushdata);
     if (!size || it_pushdata + size->pushdata_bytes + size->payload_bytes > script_.end()) {
       cursor_ = script_.end();
+      truncated_ = true;
       return std::nullopt;
     }
     const auto it_payload = it_pushdata + size->pushdata_bytes;
@@ -46,6 +47,16 @@ class Parser {
     return script_;
   }
 
+  // Returns the offset of the next instruction within the script.
+  int Position() const {
+    return int(cursor_ - script_.begin());
+  }
+
+  // Returns true if parsing stopped at a push instruction that overran the end of the script.
+  bool IsTruncated() const {
+    return truncated_;
+  }
+
  private:
   struct InstructionSize {
     uint8_t pushdata_bytes;
@@ -73,6 +84,7 @@ class Parser {
 
   lang::Bytes script_;
   Iterator cursor_;
+  bool truncated_ = false;
 };
 
 }  // namespace hornet::protocol
@@ -34,4 +34,12 @@ inline int64_t DecodeInt40(lang::Bytes bytes, bool require_minimal = false) {
   return Decode<int64_t, 5>(bytes, require_minimal);
 }
 
+// Interprets a stack item as a Boolean: false if every byte is zero, except possibly for a final
+// sign bit (negative zero), and true otherwise.
+inline bool DecodeBool(lang::Bytes bytes) {
+  for (int i = 0; i < std::ssize(bytes); ++i)
+    if (bytes[i] != 0) return i < std::ssize(bytes) - 1 || bytes[i] != 0x80;
+  return false;
+}
+
 }  // namespace hornet::protocol::script::runtime
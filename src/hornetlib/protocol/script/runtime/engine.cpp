@@ -12,6 +12,8 @@ namespace hornet::protocol::script::runtime {
 
 void RegisterArithmeticHandlers(Dispatcher& table);  // In ops/arithmetic.cpp
 void RegisterBitwiseHandlers(Dispatcher& table);     // In ops/bitwise.cpp
+void RegisterControlHandlers(Dispatcher& table);     // In ops/control.cpp
+void RegisterCryptoHandlers(Dispatcher& table);      // In ops/crypto.cpp
 void RegisterStackHandlers(Dispatcher& table);        // In ops/stack.cpp
 
 namespace detail {
@@ -27,6 +29,8 @@ Handler GetHandler(Version version, lang::Op opcode) {
       std::fill(handlers.begin(), handlers.end(), &OnUnknown);
       RegisterArithmeticHandlers(handlers);
       RegisterBitwiseHandlers(handlers);
+      RegisterControlHandlers(handlers);
+      RegisterCryptoHandlers(handlers);
       RegisterStackHandlers(handlers);
       // TODO: Fill in other handler entries, depending on version.
       return handlers;
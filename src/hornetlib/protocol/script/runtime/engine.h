@@ -4,6 +4,9 @@
 // For licensing or usage inquiries, contact: ask@hornetnode.com.
 #pragma once
 
+#include <optional>
+
+#include "hornetlib/crypto/secp256k1/signature_cache.h"
 #include "hornetlib/protocol/script/lang/types.h"
 #include "hornetlib/protocol/script/runtime/stack.h"
 
@@ -24,11 +27,29 @@ struct Policy {
   bool require_minimal = true;
 };
 
+struct Environment;
+
+// Verifies signatures over the transaction being validated, on behalf of the signature opcodes.
+class SignatureChecker {
+ public:
+  virtual ~SignatureChecker() = default;
+
+  // Checks an ECDSA signature, with its trailing sighash type byte, in a legacy or segwit v0
+  // script, given its script code: the executing script from after the last OP_CODESEPARATOR.
+  virtual bool CheckEcdsa(const Environment& env, lang::Bytes signature, lang::Bytes public_key,
+                          lang::Bytes script_code) const = 0;
+
+  // Checks a Schnorr signature, with its optional sighash type byte, for a Taproot key-path spend.
+  virtual bool CheckSchnorr(const Environment& env, lang::Bytes signature, lang::Bytes public_key,
+                            std::optional<lang::Bytes> annex) const = 0;
+};
+
 // The virtual machine state.
 struct Machine {
   // Mutable machine state.
   runtime::Stack& stack;
   int non_push_op_count = 0;
+  int code_separator = 0;  // The offset after the last OP_CODESEPARATOR executed.
 
   // Immutable machine state.
   const lang::Bytes script;
@@ -42,6 +63,15 @@ struct Machine {
 struct Environment {
   int height = 0;
   Version version = Version::Legacy;
+
+  // Whether ECDSA signatures must be strictly DER-encoded (BIP66).
+  bool strict_der = false;
+
+  // Verifies the signatures of the transaction input being spent. Null if there is no transaction.
+  const SignatureChecker* checker = nullptr;
+
+  // Signatures already verified, consulted before EC verification. Null disables caching.
+  crypto::secp256k1::SignatureCache* signature_cache = &crypto::secp256k1::SignatureCache::Global();
 };
 
 // All of the above script execution context, grouped for convenience.
@@ -35,9 +35,17 @@ static void OnEqual(const Context& context) {
   });
 }
 
+// Op::EqualVerify
+static void OnEqualVerify(const Context& context) {
+  OnEqual(context);
+  if (!context.Stack().TopAsBool()) Throw(lang::Error::EqualVerify, "OP_EQUALVERIFY found unequal items.");
+  context.Stack().Pop();
+}
+
 // Register handlers
 void RegisterBitwiseHandlers(Dispatcher& table) {
   table[Op::Equal] = &OnEqual;
+  table[Op::EqualVerify] = &OnEqualVerify;
 }
 
 }  // namespace hornet::protocol::script::runtime
@@ -0,0 +1,24 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetlib/protocol/script/lang/types.h"
+#include "hornetlib/protocol/script/runtime/engine.h"
+#include "hornetlib/protocol/script/runtime/throw.h"
+
+namespace hornet::protocol::script::runtime {
+
+using lang::Op;
+
+// Op::Verify
+static void OnVerify(const Context& context) {
+  if (!context.Stack().TopAsBool()) Throw(lang::Error::Verify, "OP_VERIFY found a false top-of-stack.");
+  context.Stack().Pop();
+}
+
+// Register handlers
+void RegisterControlHandlers(Dispatcher& table) {
+  table[Op::Verify] = &OnVerify;
+}
+
+}  // namespace hornet::protocol::script::runtime
@@ -0,0 +1,68 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetlib/crypto/hash.h"
+#include "hornetlib/protocol/script/lang/types.h"
+#include "hornetlib/protocol/script/runtime/engine.h"
+#include "hornetlib/protocol/script/runtime/signature.h"
+#include "hornetlib/protocol/script/runtime/throw.h"
+#include "hornetlib/util/throw.h"
+
+namespace hornet::protocol::script::runtime {
+
+using lang::Op;
+
+namespace detail {
+// Pops a signature and public key and returns whether the signature is valid.
+inline static bool CheckSignature(const Context& context) {
+  if (context.Version() == Version::Tapscript)
+    util::ThrowLogicError("Tapscript signature opcodes not yet implemented.");
+  if (context.env.checker == nullptr) util::ThrowLogicError("No signature checker in the script environment.");
+  auto& stack = context.Stack();
+  const lang::Bytes signature = stack.At(1);
+  // Under BIP66, a badly encoded signature fails the script, rather than merely failing the check.
+  if (context.env.strict_der && !signature.empty() && !IsValidSignatureEncoding(signature))
+    Throw(lang::Error::SigDer, "Signature is not strictly DER-encoded.");
+  // The script code begins after the last OP_CODESEPARATOR executed.
+  const lang::Bytes script_code = context.machine.script.subspan(context.machine.code_separator);
+  const bool valid = context.env.checker->CheckEcdsa(context.env, signature, stack.At(0), script_code);
+  stack.Pop(2);
+  return valid;
+}
+}  // namespace detail
+
+// Op::Hash160
+static void OnHash160(const Context& context) {
+  const auto hash = crypto::Hash160(context.Stack().Top());
+  context.Stack().Pop().Push(hash);
+}
+
+// Op::CodeSeparator
+static void OnCodeSeparator(const Context& context) {
+  context.machine.code_separator = context.instruction.offset + 1;
+}
+
+// Op::CheckSig
+static void OnCheckSig(const Context& context) {
+  // Consensus pushes an empty vector, not a zero byte, for a failed check.
+  static constexpr uint8_t kTrue = 1;
+  const bool valid = detail::CheckSignature(context);
+  context.Stack().Push(valid ? lang::Bytes{&kTrue, 1} : lang::Bytes{});
+}
+
+// Op::CheckSigVerify
+static void OnCheckSigVerify(const Context& context) {
+  if (!detail::CheckSignature(context))
+    Throw(lang::Error::CheckSigVerify, "OP_CHECKSIGVERIFY found an invalid signature.");
+}
+
+// Register handlers
+void RegisterCryptoHandlers(Dispatcher& table) {
+  table[Op::Hash160] = &OnHash160;
+  table[Op::CodeSeparator] = &OnCodeSeparator;
+  table[Op::CheckSig] = &OnCheckSig;
+  table[Op::CheckSigVerify] = &OnCheckSigVerify;
+}
+
+}  // namespace hornet::protocol::script::runtime
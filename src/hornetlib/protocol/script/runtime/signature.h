@@ -0,0 +1,69 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "hornetlib/crypto/secp256k1/ecdsa.h"
+#include "hornetlib/crypto/secp256k1/schnorr.h"
+#include "hornetlib/crypto/secp256k1/signature_cache.h"
+#include "hornetlib/protocol/script/runtime/engine.h"
+
+namespace hornet::protocol::script::runtime {
+
+namespace detail {
+
+// Returns true if the signature is in the environment's cache, or else verifies it and, if valid,
+// adds it to the cache.
+template <typename Verify>
+inline bool CheckCached(const Environment& env, crypto::secp256k1::SignatureCache::Scheme scheme,
+                        std::span<const uint8_t> public_key, std::span<const uint8_t> signature,
+                        std::span<const uint8_t, 32> sighash, Verify&& verify) {
+  if (env.signature_cache == nullptr) return verify();
+  const auto key = env.signature_cache->MakeKey(scheme, sighash, public_key, signature);
+  if (env.signature_cache->Contains(key)) return true;
+  if (!verify()) return false;
+  env.signature_cache->Insert(key);
+  return true;
+}
+
+}  // namespace detail
+
+// Returns true if an ECDSA signature, with its trailing sighash type byte, is strictly DER-encoded
+// as BIP66 requires.
+inline bool IsValidSignatureEncoding(std::span<const uint8_t> signature) {
+  // 0x30 [total length] 0x02 [R length] [R] 0x02 [S length] [S] [sighash type]
+  const size_t size = signature.size();
+  if (size < 9 || size > 73 || signature[0] != 0x30 || signature[1] != size - 3) return false;
+  const size_t r_length = signature[3];
+  if (5 + r_length >= size) return false;
+  const size_t s_length = signature[5 + r_length];
+  if (r_length + s_length + 7 != size) return false;
+  // Each integer is non-empty, non-negative, and not padded with a needless zero byte.
+  const auto is_valid_integer = [&](size_t offset, size_t length) {
+    if (signature[offset - 2] != 0x02 || length == 0 || (signature[offset] & 0x80)) return false;
+    return !(length > 1 && signature[offset] == 0 && !(signature[offset + 1] & 0x80));
+  };
+  return is_valid_integer(4, r_length) && is_valid_integer(6 + r_length, s_length);
+}
+
+// Verifies a DER-encoded ECDSA signature (without its sighash type byte) of a sighash digest.
+inline bool CheckEcdsaSignature(const Environment& env, std::span<const uint8_t> public_key,
+                                std::span<const uint8_t> signature, std::span<const uint8_t, 32> sighash) {
+  const auto verify = [&] { return crypto::secp256k1::VerifyEcdsa(public_key, sighash, signature); };
+  return detail::CheckCached(env, crypto::secp256k1::SignatureCache::Scheme::Ecdsa, public_key, signature,
+                             sighash, verify);
+}
+
+// Verifies a BIP340 Schnorr signature of a sighash digest.
+inline bool CheckSchnorrSignature(const Environment& env, std::span<const uint8_t, 32> public_key,
+                                  std::span<const uint8_t, 64> signature, std::span<const uint8_t, 32> sighash) {
+  const auto verify = [&] { return crypto::secp256k1::VerifySchnorr(public_key, sighash, signature); };
+  return detail::CheckCached(env, crypto::secp256k1::SignatureCache::Scheme::Schnorr, public_key, signature,
+                             sighash, verify);
+}
+
+}  // namespace hornet::protocol::script::runtime
@@ -4,8 +4,12 @@
 // For licensing or usage inquiries, contact: ask@hornetnode.com.
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <memory>
 #include <span>
+#include <utility>
 #include <vector>
 
 #include "hornetlib/protocol/script/lang/minimal.h"
@@ -16,35 +20,66 @@
 
 namespace hornet::protocol::script::runtime {
 
+// The script stack. Small stacks, which are most of them, live entirely in inline storage; a
+// stack that outgrows it borrows a buffer of the maximum size from its thread's StackArena, and
+// returns it when cleared or destroyed. Either way, pushes never allocate.
 class Stack {
  public:
-  Stack() {
-    data_.reserve(kMaxItemSize * kMaxItems);
-    items_.reserve(kMaxItems);
+  static constexpr int kMaxItems = 1'000;
+  static constexpr int kMaxItemSize = 520;
+  using Item = util::SubArray<uint8_t, int16_t>;
+
+  // Storage for a stack of the maximum size.
+  struct Buffer {
+    std::unique_ptr<uint8_t[]> data = std::make_unique_for_overwrite<uint8_t[]>(kMaxItems * kMaxItemSize);
+    std::unique_ptr<Item[]> items = std::make_unique<Item[]>(kMaxItems);
+  };
+
+  Stack() = default;
+  Stack(const Stack& other) {
+    CopyFrom(other);
+  }
+  Stack(Stack&& other) noexcept {
+    MoveFrom(other);
+  }
+  Stack& operator=(const Stack& other) {
+    if (this != &other) CopyFrom(other);
+    return *this;
+  }
+  Stack& operator=(Stack&& other) noexcept {
+    if (this != &other) MoveFrom(other);
+    return *this;
+  }
+  ~Stack() {
+    ReleaseBuffer();
   }
 
   bool Empty() const {
-    return items_.empty();
+    return item_count_ == 0;
   }
 
   int Size() const {
-    return std::ssize(items_);
+    return item_count_;
   }
 
+  // Empties the stack in constant time.
   void Clear() {
-    items_.clear();
-    data_.clear();
+    item_count_ = data_size_ = 0;
+    ReleaseBuffer();
   }
 
   Stack& Push(lang::Bytes bytes) {
-    if (std::ssize(items_) >= kMaxItems)
+    if (item_count_ >= kMaxItems)
       Throw(lang::Error::StackOverflow, "Stack overflow: exceeded the limit of ", kMaxItems,
             " items.");
     if (std::ssize(bytes) > kMaxItemSize)
       Throw(lang::Error::StackItemOverflow, "Stack item overflow: ", bytes.size(),
             " bytes exceeded ", kMaxItemSize, " byte size limit.");
-    items_.emplace_back(Item{int(std::ssize(data_)), int16_t(std::ssize(bytes))});
-    data_.insert(data_.end(), bytes.begin(), bytes.end());
+    // The pushed bytes may be a stack item, which stays valid in the inline storage after Grow().
+    if (!buffer_ && (item_count_ == kInlineItems || data_size_ + std::ssize(bytes) > kInlineBytes)) Grow();
+    Items()[item_count_++] = Item{data_size_, int16_t(std::ssize(bytes))};
+    std::copy(bytes.begin(), bytes.end(), Data() + data_size_);
+    data_size_ += int(std::ssize(bytes));
     return *this;
   }
 
@@ -63,22 +98,19 @@ class Stack {
 
   Stack& Pop(int count = 1) {
     if (Size() < count) Throw(lang::Error::StackUnderflow, "Pop() of empty stack.");
-    items_.resize(items_.size() - count);
-    data_.resize(items_.empty() ? 0 : items_.back().EndIndex());
+    item_count_ -= count;
+    data_size_ = item_count_ == 0 ? 0 : Items()[item_count_ - 1].EndIndex();
     return *this;
   }
 
   lang::Bytes Top() const {
     if (Empty()) Throw(lang::Error::StackUnderflow, "Top() of empty stack.");
-    return items_.back().Span(data_);
+    return ItemBytes(item_count_ - 1);
   }
 
   // Interpret the top-of-stack as a Boolean. Throws if stack is empty.
   bool TopAsBool() const {
-    const auto top = Top();
-    for (int i = 0; i < std::ssize(top); ++i)
-      if (top[i] != 0) return i < std::ssize(top) - 1 || top[i] != 0x80;
-    return false;
+    return DecodeBool(Top());
   }
 
   // Interpret the stack item at the given position as a 32-bit integer.
@@ -90,16 +122,98 @@ class Stack {
   // Retrieve the stack item at the given position.
   std::span<const uint8_t> At(int position) const {
     if (position >= Size()) Throw(lang::Error::StackUnderflow, "Accessed an invalid stack position.");
-    int index = std::ssize(items_) - 1 - position;
-    return items_[index].Span(data_);
+    return ItemBytes(item_count_ - 1 - position);
+  }
+
+  // Returns true if the stack has outgrown its inline storage.
+  bool IsBuffered() const {
+    return buffer_ != nullptr;
   }
- 
+
  protected:
-  static constexpr int kMaxItems = 1'000;
-  static constexpr int kMaxItemSize = 520;
-  using Item = util::SubArray<uint8_t, int16_t>;
-  std::vector<Item> items_;
-  std::vector<uint8_t> data_;
+  // Enough for the signatures, keys and hashes of the standard scripts.
+  static constexpr int kInlineItems = 32;
+  static constexpr int kInlineBytes = 512;
+
+  uint8_t* Data() {
+    return buffer_ ? buffer_->data.get() : inline_data_.data();
+  }
+  const uint8_t* Data() const {
+    return buffer_ ? buffer_->data.get() : inline_data_.data();
+  }
+  Item* Items() {
+    return buffer_ ? buffer_->items.get() : inline_items_.data();
+  }
+  const Item* Items() const {
+    return buffer_ ? buffer_->items.get() : inline_items_.data();
+  }
+  lang::Bytes ItemBytes(int index) const {
+    const Item item = Items()[index];
+    return {Data() + item.StartIndex(), size_t(item.Size())};
+  }
+
+  // Moves the contents from the inline storage into a buffer borrowed from the arena.
+  void Grow();
+  // Returns any borrowed buffer to the arena.
+  void ReleaseBuffer();
+  void CopyFrom(const Stack& other);
+  void MoveFrom(Stack& other);
+
+  std::unique_ptr<Buffer> buffer_;
+  int item_count_ = 0;
+  int data_size_ = 0;
+  std::array<Item, kInlineItems> inline_items_;
+  std::array<uint8_t, kInlineBytes> inline_data_;
 };
 
+// A per-thread pool of stack buffers, so that large stacks reuse memory across script executions.
+class StackArena {
+ public:
+  static StackArena& Local() {
+    thread_local StackArena arena;
+    return arena;
+  }
+
+  std::unique_ptr<Stack::Buffer> Acquire() {
+    if (free_.empty()) return std::make_unique<Stack::Buffer>();
+    auto buffer = std::move(free_.back());
+    free_.pop_back();
+    return buffer;
+  }
+
+  void Release(std::unique_ptr<Stack::Buffer> buffer) {
+    free_.push_back(std::move(buffer));
+  }
+
+ private:
+  std::vector<std::unique_ptr<Stack::Buffer>> free_;
+};
+
+inline void Stack::Grow() {
+  buffer_ = StackArena::Local().Acquire();
+  std::copy_n(inline_items_.begin(), item_count_, buffer_->items.get());
+  std::copy_n(inline_data_.begin(), data_size_, buffer_->data.get());
+}
+
+inline void Stack::ReleaseBuffer() {
+  if (buffer_) StackArena::Local().Release(std::move(buffer_));
+}
+
+inline void Stack::CopyFrom(const Stack& other) {
+  item_count_ = other.item_count_;
+  data_size_ = other.data_size_;
+  if (other.buffer_ && !buffer_) buffer_ = StackArena::Local().Acquire();
+  if (!other.buffer_) ReleaseBuffer();
+  std::copy_n(other.Items(), item_count_, Items());
+  std::copy_n(other.Data(), data_size_, Data());
+}
+
+inline void Stack::MoveFrom(Stack& other) {
+  if (!other.buffer_) return CopyFrom(other);
+  ReleaseBuffer();
+  buffer_ = std::move(other.buffer_);
+  item_count_ = std::exchange(other.item_count_, 0);
+  data_size_ = std::exchange(other.data_size_, 0);
+}
+
 }  // namespace hornet::protocol::script::runtime
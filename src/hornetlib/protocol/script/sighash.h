@@ -0,0 +1,289 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+// Signature hashes for legacy, segwit v0 (BIP143) and Taproot (BIP341/BIP342) inputs.
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "hornetlib/crypto/hash.h"
+#include "hornetlib/encoding/writer.h"
+#include "hornetlib/protocol/script/lang/op.h"
+#include "hornetlib/protocol/script/parser.h"
+#include "hornetlib/protocol/transaction.h"
+
+namespace hornet::protocol::script {
+
+// The sighash type flags, as carried in the final byte of a signature.
+namespace sighash {
+inline constexpr uint8_t kDefault = 0x00;  // Taproot only: as kAll, with the type byte omitted.
+inline constexpr uint8_t kAll = 0x01;
+inline constexpr uint8_t kNone = 0x02;
+inline constexpr uint8_t kSingle = 0x03;
+inline constexpr uint8_t kAnyoneCanPay = 0x80;
+}  // namespace sighash
+
+// An output spent by a transaction input, as looked up in the UTXO set.
+struct SpentOutput {
+  int64_t amount = 0;
+  std::span<const uint8_t> pk_script;
+};
+
+// Returns true if the script is a witness v1 (Taproot) output program.
+inline bool IsPayToTaproot(std::span<const uint8_t> pk_script) {
+  return pk_script.size() == 34 && pk_script[0] == 0x51 && pk_script[1] == 0x20;
+}
+
+// The hashes of the transaction fields that are shared by the signature hashes of all the inputs,
+// computed once per transaction so that signing every input does not rehash the whole transaction.
+// BIP341 hashes the serialized fields once with SHA-256; BIP143 hashes the same serializations
+// twice, so its fields are derived from the BIP341 ones.
+struct PrecomputedTransactionData {
+  PrecomputedTransactionData() = default;
+
+  // Precomputes the hashes needed by the transaction's inputs: none for a transaction without
+  // witnesses, and those of BIP341 only if one of the spent outputs, given in input order, is
+  // Taproot.
+  PrecomputedTransactionData(TransactionConstView tx, std::span<const SpentOutput> spent_outputs);
+
+  bool segwit_ready = false;   // The BIP143 fields and the first three BIP341 fields are set.
+  bool taproot_ready = false;  // All BIP341 fields are set.
+
+  // BIP341 single SHA-256 hashes.
+  crypto::bytes32_t sha_prevouts = {};
+  crypto::bytes32_t sha_sequences = {};
+  crypto::bytes32_t sha_outputs = {};
+  crypto::bytes32_t sha_amounts = {};
+  crypto::bytes32_t sha_scriptpubkeys = {};
+
+  // BIP143 double SHA-256 hashes.
+  crypto::bytes32_t hash_prevouts = {};
+  crypto::bytes32_t hash_sequence = {};
+  crypto::bytes32_t hash_outputs = {};
+};
+
+inline PrecomputedTransactionData::PrecomputedTransactionData(const TransactionConstView tx,
+                                                              std::span<const SpentOutput> spent_outputs) {
+  if (!tx.IsWitness()) return;
+  encoding::Writer prevouts, sequences, outputs;
+  for (const Input& input : tx.Inputs()) {
+    input.previous_output.Serialize(prevouts);
+    sequences.WriteLE4(input.sequence);
+  }
+  for (int i = 0; i < tx.OutputCount(); ++i) {
+    outputs.WriteLE8(tx.Output(i).value);
+    outputs.WriteVarInt(tx.PkScript(i).size());
+    outputs.WriteBytes(tx.PkScript(i));
+  }
+  sha_prevouts = crypto::Sha256(prevouts.Buffer());
+  sha_sequences = crypto::Sha256(sequences.Buffer());
+  sha_outputs = crypto::Sha256(outputs.Buffer());
+  hash_prevouts = crypto::Sha256(sha_prevouts);
+  hash_sequence = crypto::Sha256(sha_sequences);
+  hash_outputs = crypto::Sha256(sha_outputs);
+  segwit_ready = true;
+
+  if (std::ssize(spent_outputs) != tx.InputCount() ||
+      std::none_of(spent_outputs.begin(), spent_outputs.end(),
+                   [](const SpentOutput& spent) { return IsPayToTaproot(spent.pk_script); }))
+    return;
+  encoding::Writer amounts, scripts;
+  for (const SpentOutput& spent : spent_outputs) {
+    amounts.WriteLE8(spent.amount);
+    scripts.WriteVarInt(spent.pk_script.size());
+    scripts.WriteBytes(spent.pk_script);
+  }
+  sha_amounts = crypto::Sha256(amounts.Buffer());
+  sha_scriptpubkeys = crypto::Sha256(scripts.Buffer());
+  taproot_ready = true;
+}
+
+// A transaction's precomputed data, built by the first signature check that needs it, so that a
+// transaction whose scripts are never checked, or only by legacy sighash, doesn't pay for hashing.
+// Get may be called concurrently by the checks of the transaction's inputs.
+class LazyPrecomputedTransactionData {
+ public:
+  // The spent outputs, in input order, must outlive this object.
+  LazyPrecomputedTransactionData(TransactionConstView tx, std::span<const SpentOutput> spent_outputs)
+      : tx_(tx), spent_outputs_(spent_outputs) {}
+
+  const PrecomputedTransactionData& Get() const {
+    std::call_once(once_, [this] { data_ = {tx_, spent_outputs_}; });
+    return data_;
+  }
+
+ private:
+  const TransactionConstView tx_;
+  const std::span<const SpentOutput> spent_outputs_;
+  mutable std::once_flag once_;
+  mutable PrecomputedTransactionData data_;
+};
+
+namespace detail {
+
+inline void WriteOutput(encoding::Writer& writer, const TransactionConstView tx, int index) {
+  writer.WriteLE8(tx.Output(index).value);
+  writer.WriteVarInt(tx.PkScript(index).size());
+  writer.WriteBytes(tx.PkScript(index));
+}
+
+}  // namespace detail
+
+// Returns the original signature hash of a non-witness input, given the script code with any
+// signature pushes already removed. As in consensus, SIGHASH_SINGLE without a corresponding output
+// signs the value one rather than failing. This hash is quadratic in the transaction size, so it
+// does not use precomputed data.
+inline crypto::bytes32_t LegacySighash(const TransactionConstView tx, int input, std::span<const uint8_t> script_code,
+                                       uint32_t hash_type) {
+  const bool anyone_can_pay = hash_type & sighash::kAnyoneCanPay;
+  const uint32_t base_type = hash_type & 0x1f;
+  const bool single = base_type == sighash::kSingle;
+  const bool none = base_type == sighash::kNone;
+  if (single && input >= tx.OutputCount()) return crypto::bytes32_t{1};
+
+  // OP_CODESEPARATORs are not signed.
+  std::vector<uint8_t> code;
+  code.reserve(script_code.size());
+  Parser parser{script_code};
+  int copied = 0;
+  while (const auto instruction = parser.Next()) {
+    if (instruction->opcode != lang::Op::CodeSeparator) continue;
+    code.insert(code.end(), script_code.begin() + copied, script_code.begin() + instruction->offset);
+    copied = instruction->offset + 1;
+  }
+  code.insert(code.end(), script_code.begin() + copied, script_code.end());
+
+  encoding::Writer writer;
+  writer.WriteLE4(tx.Version());
+  const int first_input = anyone_can_pay ? input : 0;
+  const int end_input = anyone_can_pay ? input + 1 : tx.InputCount();
+  writer.WriteVarInt(end_input - first_input);
+  for (int i = first_input; i < end_input; ++i) {
+    tx.Input(i).previous_output.Serialize(writer);
+    // Only the signed input carries a script, and only it commits to its sequence under
+    // SIGHASH_NONE or SIGHASH_SINGLE.
+    if (i == input) {
+      writer.WriteVarInt(code.size());
+      writer.WriteBytes(code);
+    } else {
+      writer.WriteVarInt(0);
+    }
+    writer.WriteLE4(i != input && (single || none) ? 0 : tx.Input(i).sequence);
+  }
+  const int output_count = none ? 0 : single ? input + 1 : tx.OutputCount();
+  writer.WriteVarInt(output_count);
+  for (int i = 0; i < output_count; ++i) {
+    if (single && i != input) {
+      // A null output: a value of -1 and an empty script.
+      writer.WriteLE4(0xffffffff);
+      writer.WriteLE4(0xffffffff);
+      writer.WriteVarInt(0);
+    } else {
+      detail::WriteOutput(writer, tx, i);
+    }
+  }
+  writer.WriteLE4(tx.LockTime());
+  writer.WriteLE4(hash_type);
+  return crypto::DoubleSha256(writer.Buffer());
+}
+
+// Returns the BIP143 signature hash of a segwit v0 input, given the script code and the amount of
+// the spent output. The hash type is the full value committed to, normally the signature's last byte.
+inline crypto::bytes32_t SegwitV0Sighash(const TransactionConstView tx, const PrecomputedTransactionData& precomputed,
+                                         int input, std::span<const uint8_t> script_code, int64_t amount,
+                                         uint32_t hash_type) {
+  const bool anyone_can_pay = hash_type & sighash::kAnyoneCanPay;
+  const uint32_t base_type = hash_type & 0x1f;
+  const bool commit_all_outputs = base_type != sighash::kSingle && base_type != sighash::kNone;
+  constexpr crypto::bytes32_t kZero = {};
+
+  encoding::Writer writer;
+  writer.WriteLE4(tx.Version());
+  writer.WriteBytes(anyone_can_pay ? kZero : precomputed.hash_prevouts);
+  writer.WriteBytes(!anyone_can_pay && commit_all_outputs ? precomputed.hash_sequence : kZero);
+  tx.Input(input).previous_output.Serialize(writer);
+  writer.WriteVarInt(script_code.size());
+  writer.WriteBytes(script_code);
+  writer.WriteLE8(amount);
+  writer.WriteLE4(tx.Input(input).sequence);
+  if (commit_all_outputs) {
+    writer.WriteBytes(precomputed.hash_outputs);
+  } else if (base_type == sighash::kSingle && input < tx.OutputCount()) {
+    encoding::Writer output;
+    detail::WriteOutput(output, tx, input);
+    writer.WriteBytes(crypto::DoubleSha256(output.Buffer()));
+  } else {
+    writer.WriteBytes(kZero);
+  }
+  writer.WriteLE4(tx.LockTime());
+  writer.WriteLE4(hash_type);
+  return crypto::DoubleSha256(writer.Buffer());
+}
+
+// The BIP342 extension to the Taproot signature message, for script-path spends.
+struct TapscriptExtension {
+  crypto::bytes32_t tapleaf_hash;
+  uint32_t codesep_position = 0xffffffff;
+};
+
+// Returns the BIP341 signature hash of a Taproot input, or nullopt if the hash type is invalid or
+// is SIGHASH_SINGLE without a corresponding output. The annex, if present, includes its 0x50 prefix.
+inline std::optional<crypto::bytes32_t> TaprootSighash(const TransactionConstView tx,
+                                                       const PrecomputedTransactionData& precomputed,
+                                                       int input, const SpentOutput& spent, uint8_t hash_type,
+                                                       std::optional<std::span<const uint8_t>> annex = std::nullopt,
+                                                       const TapscriptExtension* extension = nullptr) {
+  if (!(hash_type <= sighash::kSingle || (hash_type >= 0x81 && hash_type <= 0x83))) return std::nullopt;
+  const uint8_t output_type = hash_type == sighash::kDefault ? sighash::kAll : (hash_type & 0x03);
+  const bool anyone_can_pay = hash_type & sighash::kAnyoneCanPay;
+  if (output_type == sighash::kSingle && input >= tx.OutputCount()) return std::nullopt;
+
+  encoding::Writer writer;
+  writer.WriteByte(0x00);  // Epoch.
+  writer.WriteByte(hash_type);
+  writer.WriteLE4(tx.Version());
+  writer.WriteLE4(tx.LockTime());
+  if (!anyone_can_pay) {
+    writer.WriteBytes(precomputed.sha_prevouts);
+    writer.WriteBytes(precomputed.sha_amounts);
+    writer.WriteBytes(precomputed.sha_scriptpubkeys);
+    writer.WriteBytes(precomputed.sha_sequences);
+  }
+  if (output_type == sighash::kAll) writer.WriteBytes(precomputed.sha_outputs);
+  writer.WriteByte((extension ? 2 : 0) | (annex ? 1 : 0));  // The spend type.
+  if (anyone_can_pay) {
+    tx.Input(input).previous_output.Serialize(writer);
+    writer.WriteLE8(spent.amount);
+    writer.WriteVarInt(spent.pk_script.size());
+    writer.WriteBytes(spent.pk_script);
+    writer.WriteLE4(tx.Input(input).sequence);
+  } else {
+    writer.WriteLE4(input);
+  }
+  if (annex) {
+    encoding::Writer serialized;
+    serialized.WriteVarInt(annex->size());
+    serialized.WriteBytes(*annex);
+    writer.WriteBytes(crypto::Sha256(serialized.Buffer()));
+  }
+  if (output_type == sighash::kSingle) {
+    encoding::Writer output;
+    detail::WriteOutput(output, tx, input);
+    writer.WriteBytes(crypto::Sha256(output.Buffer()));
+  }
+  if (extension) {
+    writer.WriteBytes(extension->tapleaf_hash);
+    writer.WriteByte(0x00);  // The key version.
+    writer.WriteLE4(extension->codesep_position);
+  }
+  return crypto::TaggedHash("TapSighash", writer.Buffer());
+}
+
+}  // namespace hornet::protocol::script
@@ -0,0 +1,169 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+// Fast paths for spends of the standard output templates that make up the great majority of
+// inputs. Each verifier reproduces exactly the outcome, including the error, of running the same
+// spend through the interpreter, but without parsing, a stack, or any allocation.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "hornetlib/crypto/hash.h"
+#include "hornetlib/protocol/script/lang/op.h"
+#include "hornetlib/protocol/script/lang/types.h"
+#include "hornetlib/protocol/script/runtime/decode.h"
+#include "hornetlib/protocol/script/runtime/engine.h"
+#include "hornetlib/protocol/script/runtime/signature.h"
+#include "hornetlib/protocol/script/sighash.h"
+#include "hornetlib/protocol/script/verify.h"
+#include "hornetlib/util/assert.h"
+#include "hornetlib/util/throw.h"
+
+namespace hornet::protocol::script {
+
+enum class Template {
+  NonStandard,                       // Anything else, verified by the interpreter.
+  PayToPubKeyHash,                   // <sig> <pubkey> | DUP HASH160 <20> EQUALVERIFY CHECKSIG
+  PayToWitnessPubKeyHash,            // [<sig> <pubkey>] | 0 <20>
+  PayToScriptHashWitnessPubKeyHash,  // [<sig> <pubkey>] <0 <20>> | HASH160 <20> EQUAL
+  PayToTaprootKeyPath                // [<sig> <annex>?] | 1 <32>
+};
+
+namespace detail {
+
+constexpr int kMaxWitnessItemSize = 520;
+
+inline bool IsPayToPubKeyHash(lang::Bytes script) {
+  return script.size() == 25 && script[0] == uint8_t(lang::Op::Duplicate) &&
+         script[1] == uint8_t(lang::Op::Hash160) && script[2] == 20 &&
+         script[23] == uint8_t(lang::Op::EqualVerify) && script[24] == uint8_t(lang::Op::CheckSig);
+}
+
+inline bool IsPayToWitnessPubKeyHash(lang::Bytes script) {
+  return script.size() == 22 && script[0] == uint8_t(lang::Op::PushConst0) && script[1] == 20;
+}
+
+// Returns the data of the two direct pushes (of 1 to 75 bytes) that make up a script, if they do.
+inline std::optional<std::array<lang::Bytes, 2>> SplitTwoPushes(lang::Bytes script) {
+  std::array<lang::Bytes, 2> data;
+  size_t offset = 0;
+  for (lang::Bytes& item : data) {
+    if (offset >= script.size()) return std::nullopt;
+    const uint8_t size = script[offset];
+    if (size < uint8_t(lang::Op::PushSize1) || size > uint8_t(lang::Op::PushSizeMax) ||
+        offset + 1 + size > script.size())
+      return std::nullopt;
+    item = script.subspan(offset + 1, size);
+    offset += 1 + size;
+  }
+  if (offset != script.size()) return std::nullopt;
+  return data;
+}
+
+inline bool HasAnnex(const WitnessView& witness) {
+  const int size = witness.Size();
+  return size >= 2 && !witness[size - 1].empty() && witness[size - 1][0] == 0x50;
+}
+
+// Checks a public key hash and signature as DUP HASH160 <hash> EQUALVERIFY CHECKSIG does, with the
+// given script code and execution version.
+inline std::optional<lang::Error> VerifyPubKeyHash(lang::Bytes signature, lang::Bytes public_key,
+                                                   lang::Bytes hash, lang::Bytes script_code,
+                                                   runtime::Version version, const runtime::Environment& env) {
+  if (!std::ranges::equal(crypto::Hash160(public_key), hash)) return lang::Error::EqualVerify;
+  if (env.strict_der && !signature.empty() && !runtime::IsValidSignatureEncoding(signature))
+    return lang::Error::SigDer;
+  Assert(env.checker != nullptr);
+  runtime::Environment versioned = env;
+  versioned.version = version;
+  if (!env.checker->CheckEcdsa(versioned, signature, public_key, script_code)) return lang::Error::EvalFalse;
+  return std::nullopt;
+}
+
+// Verifies a P2WPKH witness, once its witness program has been found on the stack.
+inline std::optional<lang::Error> VerifyWitnessPubKeyHash(lang::Bytes program, const WitnessView& witness,
+                                                          const runtime::Environment& env) {
+  // The program is left on top of the stack by the output (or redeem) script.
+  if (!runtime::DecodeBool(program)) return lang::Error::EvalFalse;
+  if (witness[0].size() > kMaxWitnessItemSize || witness[1].size() > kMaxWitnessItemSize)
+    return lang::Error::StackItemOverflow;
+  std::array<uint8_t, 25> script_code = {uint8_t(lang::Op::Duplicate), uint8_t(lang::Op::Hash160), 20};
+  std::copy(program.begin(), program.end(), script_code.begin() + 3);
+  script_code[23] = uint8_t(lang::Op::EqualVerify);
+  script_code[24] = uint8_t(lang::Op::CheckSig);
+  return VerifyPubKeyHash(witness[0], witness[1], program, script_code, runtime::Version::SegwitV0, env);
+}
+
+}  // namespace detail
+
+// Returns the template of a spend if it has a fast path under the given flags. Spends that differ
+// in any detail, such as a non-direct push or an extra witness item, are left to the interpreter.
+inline Template Classify(lang::Bytes sig_script, lang::Bytes pubkey_script, const WitnessView& witness,
+                         uint32_t flags) {
+  if (detail::IsPayToPubKeyHash(pubkey_script))
+    return witness.Size() == 0 && detail::SplitTwoPushes(sig_script) ? Template::PayToPubKeyHash
+                                                                     : Template::NonStandard;
+  if (!(flags & kVerifyWitness)) return Template::NonStandard;
+  if (detail::IsPayToWitnessPubKeyHash(pubkey_script) && sig_script.empty() && witness.Size() == 2)
+    return Template::PayToWitnessPubKeyHash;
+  if ((flags & kVerifyP2SH) && IsPayToScriptHash(pubkey_script) && sig_script.size() == 23 &&
+      sig_script[0] == 22 && detail::IsPayToWitnessPubKeyHash(sig_script.subspan(1)) && witness.Size() == 2)
+    return Template::PayToScriptHashWitnessPubKeyHash;
+  if ((flags & kVerifyTaproot) && IsPayToTaproot(pubkey_script) && sig_script.empty() &&
+      (witness.Size() == 1 || (witness.Size() == 2 && detail::HasAnnex(witness))))
+    return Template::PayToTaprootKeyPath;
+  return Template::NonStandard;
+}
+
+// Verifies a spend classified as one of the standard templates. Returns the reason for failure, or
+// nullopt.
+inline std::optional<lang::Error> VerifyTemplate(Template type, lang::Bytes sig_script, lang::Bytes pubkey_script,
+                                                 const WitnessView& witness, const runtime::Environment& env) {
+  switch (type) {
+    case Template::PayToPubKeyHash: {
+      const auto pushes = detail::SplitTwoPushes(sig_script);
+      Assert(pushes.has_value());
+      return detail::VerifyPubKeyHash((*pushes)[0], (*pushes)[1], pubkey_script.subspan(3, 20), pubkey_script,
+                                      runtime::Version::Legacy, env);
+    }
+    case Template::PayToWitnessPubKeyHash:
+      return detail::VerifyWitnessPubKeyHash(pubkey_script.subspan(2), witness, env);
+    case Template::PayToScriptHashWitnessPubKeyHash: {
+      // HASH160 <hash> EQUAL leaves false on the stack if the redeem script does not match.
+      const lang::Bytes redeem_script = sig_script.subspan(1);
+      if (!std::ranges::equal(crypto::Hash160(redeem_script), pubkey_script.subspan(2, 20)))
+        return lang::Error::EvalFalse;
+      return detail::VerifyWitnessPubKeyHash(redeem_script.subspan(2), witness, env);
+    }
+    case Template::PayToTaprootKeyPath: {
+      const lang::Bytes program = pubkey_script.subspan(2);
+      if (!runtime::DecodeBool(program)) return lang::Error::EvalFalse;
+      std::optional<lang::Bytes> annex;
+      if (witness.Size() == 2) annex = witness[1];
+      Assert(env.checker != nullptr);
+      if (!env.checker->CheckSchnorr(env, witness[0], program, annex)) return lang::Error::SchnorrSig;
+      return std::nullopt;
+    }
+    case Template::NonStandard:
+      break;
+  }
+  util::ThrowLogicError("Spend is not of a standard template.");
+}
+
+// Verifies a spend as VerifyScript does, taking the fast path for standard templates.
+inline std::optional<lang::Error> VerifyInput(lang::Bytes sig_script, lang::Bytes pubkey_script,
+                                              const WitnessView& witness, uint32_t flags,
+                                              const runtime::Environment& env) {
+  const Template type = Classify(sig_script, pubkey_script, witness, flags);
+  if (type == Template::NonStandard) return VerifyScript(sig_script, pubkey_script, witness, flags, env);
+  runtime::Environment flagged = env;
+  flagged.strict_der = flags & kVerifyDerSig;
+  return VerifyTemplate(type, sig_script, pubkey_script, witness, flagged);
+}
+
+}  // namespace hornet::protocol::script
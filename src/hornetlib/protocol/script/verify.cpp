@@ -0,0 +1,161 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetlib/protocol/script/verify.h"
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "hornetlib/crypto/hash.h"
+#include "hornetlib/protocol/script/parser.h"
+#include "hornetlib/protocol/script/runtime/stack.h"
+#include "hornetlib/protocol/script/runtime/throw.h"
+#include "hornetlib/protocol/script/writer.h"
+#include "hornetlib/util/throw.h"
+
+namespace hornet::protocol::script {
+
+namespace {
+
+constexpr int kMaxScriptSize = 10'000;
+constexpr uint8_t kAnnexTag = 0x50;
+
+// Minimal encoding of pushes and numbers is relay policy, not consensus.
+const runtime::Policy kConsensusPolicy{.require_minimal = false};
+
+// Executes a script on the given stack, throwing on failure.
+void EvalScript(runtime::Stack& stack, lang::Bytes script, const runtime::Environment& env) {
+  if (std::ssize(script) > kMaxScriptSize)
+    runtime::Throw(lang::Error::ScriptSize, "Script of ", script.size(), " bytes exceeds the size limit.");
+  Parser parser{script};
+  runtime::Machine machine{.stack = stack, .script = script, .policy = kConsensusPolicy};
+  while (const auto instruction = parser.Next()) runtime::StepExecution({env, machine, *instruction});
+  if (parser.IsTruncated()) runtime::Throw(lang::Error::BadOpcode, "Script ended within a push instruction.");
+}
+
+void RequireTrue(const runtime::Stack& stack) {
+  if (stack.Empty() || !stack.TopAsBool())
+    runtime::Throw(lang::Error::EvalFalse, "Script finished with an empty or false top-of-stack.");
+}
+
+bool IsPushOnly(lang::Bytes script) {
+  Parser parser{script};
+  while (const auto instruction = parser.Next())
+    if (!lang::IsPush(instruction->opcode)) return false;
+  return !parser.IsTruncated();
+}
+
+// Executes a segwit v0 witness script on a stack holding the remaining witness items.
+void ExecuteWitnessScript(runtime::Stack& stack, lang::Bytes script, const runtime::Environment& env) {
+  runtime::Environment v0 = env;
+  v0.version = runtime::Version::SegwitV0;
+  EvalScript(stack, script, v0);
+  if (stack.Size() != 1)
+    runtime::Throw(lang::Error::CleanStack, "Witness script left ", stack.Size(), " items on the stack.");
+  RequireTrue(stack);
+}
+
+void VerifyWitnessProgram(runtime::Stack& stack, const WitnessView& witness, const WitnessProgram& program,
+                          bool is_p2sh, uint32_t flags, const runtime::Environment& env) {
+  stack.Clear();
+  const int size = witness.Size();
+  if (program.version == 0) {
+    if (program.program.size() == 32) {
+      // P2WSH: the last witness item is the script, committed to by its hash.
+      if (size == 0) runtime::Throw(lang::Error::WitnessProgramWitnessEmpty, "P2WSH spent with an empty witness.");
+      const lang::Bytes script = witness[size - 1];
+      if (!std::ranges::equal(crypto::Sha256(script), program.program))
+        runtime::Throw(lang::Error::WitnessProgramMismatch, "P2WSH witness script does not match its hash.");
+      for (int i = 0; i < size - 1; ++i) stack.Push(witness[i]);
+      ExecuteWitnessScript(stack, script, env);
+    } else if (program.program.size() == 20) {
+      // P2WPKH: the witness is a signature and public key, checked as by a P2PKH script.
+      if (size != 2) runtime::Throw(lang::Error::WitnessProgramMismatch, "P2WPKH witness has ", size, " items.");
+      std::array<uint8_t, 25> script = {uint8_t(lang::Op::Duplicate), uint8_t(lang::Op::Hash160), 20};
+      std::copy(program.program.begin(), program.program.end(), script.begin() + 3);
+      script[23] = uint8_t(lang::Op::EqualVerify);
+      script[24] = uint8_t(lang::Op::CheckSig);
+      stack.Push(witness[0]).Push(witness[1]);
+      ExecuteWitnessScript(stack, script, env);
+    } else {
+      runtime::Throw(lang::Error::WitnessProgramWrongLength, "Witness v0 program of ", program.program.size(),
+                     " bytes.");
+    }
+  } else if (program.version == 1 && program.program.size() == 32 && !is_p2sh) {
+    if (!(flags & kVerifyTaproot)) return;
+    if (size == 0) runtime::Throw(lang::Error::WitnessProgramWitnessEmpty, "Taproot spent with an empty witness.");
+    // An annex is identified by its tag, and only if there are at least two witness items.
+    std::optional<lang::Bytes> annex;
+    int items = size;
+    if (size >= 2 && !witness[size - 1].empty() && witness[size - 1][0] == kAnnexTag) annex = witness[--items];
+    if (items != 1) util::ThrowLogicError("Taproot script-path spends not yet implemented.");
+    if (env.checker == nullptr) util::ThrowLogicError("No signature checker in the script environment.");
+    if (!env.checker->CheckSchnorr(env, witness[0], program.program, annex))
+      runtime::Throw(lang::Error::SchnorrSig, "Invalid Taproot key-path signature.");
+  }
+  // Other versions and lengths are left for future soft forks, and so succeed.
+}
+
+}  // namespace
+
+std::optional<lang::Error> VerifyScript(lang::Bytes sig_script, lang::Bytes pubkey_script,
+                                        const WitnessView& witness, uint32_t flags,
+                                        const runtime::Environment& base) {
+  runtime::Environment env = base;
+  env.strict_der = flags & kVerifyDerSig;
+  try {
+    runtime::Environment legacy = env;
+    legacy.version = runtime::Version::Legacy;
+    runtime::Stack stack;
+    EvalScript(stack, sig_script, legacy);
+    std::optional<runtime::Stack> p2sh_stack;
+    if (flags & kVerifyP2SH) p2sh_stack = stack;
+    EvalScript(stack, pubkey_script, legacy);
+    RequireTrue(stack);
+
+    bool had_witness = false;
+    if (flags & kVerifyWitness) {
+      if (const auto program = ParseWitnessProgram(pubkey_script)) {
+        had_witness = true;
+        if (!sig_script.empty())
+          runtime::Throw(lang::Error::WitnessMalleated, "Native witness program spent with a signature script.");
+        VerifyWitnessProgram(stack, witness, *program, false, flags, env);
+      }
+    }
+
+    if ((flags & kVerifyP2SH) && IsPayToScriptHash(pubkey_script)) {
+      if (!IsPushOnly(sig_script))
+        runtime::Throw(lang::Error::SigPushOnly, "P2SH signature script is not push-only.");
+      // Executes the redeem script, which is the last item pushed, on the items pushed before it.
+      stack = std::move(*p2sh_stack);
+      const lang::Bytes top = stack.Top();
+      const std::vector<uint8_t> redeem_script{top.begin(), top.end()};
+      stack.Pop();
+      EvalScript(stack, redeem_script, legacy);
+      RequireTrue(stack);
+
+      if (flags & kVerifyWitness) {
+        if (const auto program = ParseWitnessProgram(redeem_script)) {
+          had_witness = true;
+          Writer push;
+          push.PushData(redeem_script);
+          if (!std::ranges::equal(sig_script, lang::Bytes{push}))
+            runtime::Throw(lang::Error::WitnessMalleatedP2SH,
+                           "P2SH witness program has a signature script other than its push.");
+          VerifyWitnessProgram(stack, witness, *program, true, flags, env);
+        }
+      }
+    }
+
+    if ((flags & kVerifyWitness) && !had_witness && witness.Size() > 0)
+      runtime::Throw(lang::Error::WitnessUnexpected, "Witness given for an input without a witness program.");
+    return std::nullopt;
+  } catch (const runtime::Exception& e) {
+    return e.GetError();
+  }
+}
+
+}  // namespace hornet::protocol::script
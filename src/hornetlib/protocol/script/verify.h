@@ -0,0 +1,69 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "hornetlib/protocol/script/lang/types.h"
+#include "hornetlib/protocol/script/runtime/engine.h"
+#include "hornetlib/protocol/transaction.h"
+
+namespace hornet::protocol::script {
+
+// The script validation rules in force, which depend on the soft forks active at the spending height.
+enum VerifyFlags : uint32_t {
+  kVerifyNone = 0,
+  kVerifyP2SH = 1 << 0,     // BIP16.
+  kVerifyWitness = 1 << 1,  // BIP141 and BIP143.
+  kVerifyTaproot = 1 << 2,  // BIP341 and BIP342.
+  kVerifyDerSig = 1 << 3,   // BIP66.
+};
+
+// The witness stack of a transaction input, bottom item first.
+class WitnessView {
+ public:
+  WitnessView(const TransactionConstView tx, int input) : tx_(tx), input_(input) {}
+
+  int Size() const {
+    return input_ < tx_.WitnessCount() ? tx_.Witness(input_).Size() : 0;
+  }
+  lang::Bytes operator[](int index) const {
+    return tx_.WitnessScript(input_, index);
+  }
+
+ private:
+  const TransactionConstView tx_;
+  const int input_;
+};
+
+// A witness program: a version and a program of 2 to 40 bytes.
+struct WitnessProgram {
+  int version;
+  lang::Bytes program;
+};
+
+// Returns the witness program of an output script, if it has one.
+inline std::optional<WitnessProgram> ParseWitnessProgram(lang::Bytes script) {
+  if (script.size() < 4 || script.size() > 42 || script[1] + 2u != script.size()) return std::nullopt;
+  if (script[0] == uint8_t(lang::Op::PushConst0)) return WitnessProgram{0, script.subspan(2)};
+  if (lang::Op(script[0]) < lang::Op::PushConst1 || lang::Op(script[0]) > lang::Op::PushConst16) return std::nullopt;
+  return WitnessProgram{script[0] - uint8_t(lang::Op::PushConst1) + 1, script.subspan(2)};
+}
+
+// Returns true if the script is a P2SH output: OP_HASH160 <20 bytes> OP_EQUAL.
+inline bool IsPayToScriptHash(lang::Bytes script) {
+  return script.size() == 23 && script[0] == uint8_t(lang::Op::Hash160) && script[1] == 20 &&
+         script[22] == uint8_t(lang::Op::Equal);
+}
+
+// Verifies that an input's signature script and witness satisfy the output script it spends, by
+// running them, and any P2SH redeem script or witness program, through the interpreter. The
+// environment supplies the signature checker. Returns the reason for failure, or nullopt.
+std::optional<lang::Error> VerifyScript(lang::Bytes sig_script, lang::Bytes pubkey_script,
+                                        const WitnessView& witness, uint32_t flags,
+                                        const runtime::Environment& env);
+
+}  // namespace hornet::protocol::script
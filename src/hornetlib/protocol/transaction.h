@@ -15,6 +15,7 @@
 #include "hornetlib/encoding/reader.h"
 #include "hornetlib/encoding/writer.h"
 #include "hornetlib/protocol/hash.h"
+#include "hornetlib/protocol/transaction_scanner.h"
 #include "hornetlib/util/log.h"
 #include "hornetlib/util/subarray.h"
 #include "hornetlib/util/big_uint.h"
@@ -36,7 +37,8 @@ struct OutPoint {
     return !hash && index == kNullIndex;
   }
 
-  void Serialize(encoding::Writer& writer) const {
+  template <typename WriterT>
+  void Serialize(WriterT& writer) const {
     writer.WriteBytes(hash);
     writer.WriteLE4(index);
   }
@@ -51,6 +53,70 @@ using ScriptArray = util::SubArray<uint8_t>;
 using Component = ScriptArray;
 using Witness = util::SubArray<Component>;
 
+// The script bytes of one or more transactions. These are either owned, or else borrowed from a
+// shared, immutable payload such as a received block, in which case each script is indexed in place
+// rather than copied. Mutable access to borrowed bytes first copies them, so that the payload is
+// never modified.
+class ScriptBytes {
+ public:
+  using Payload = std::shared_ptr<const std::vector<uint8_t>>;
+  using value_type = uint8_t;
+
+  // Borrows the bytes of the payload, replacing any bytes held before.
+  void Borrow(Payload payload) {
+    owned_ = {};
+    payload_ = std::move(payload);
+  }
+  bool IsBorrowed() const {
+    return payload_ != nullptr;
+  }
+
+  size_t size() const {
+    return IsBorrowed() ? payload_->size() : owned_.size();
+  }
+  // Returns the number of bytes allocated, including those of a borrowed payload, which is kept alive.
+  size_t capacity() const {
+    return IsBorrowed() ? payload_->capacity() : owned_.capacity();
+  }
+  void resize(size_t size) {
+    Own();
+    owned_.resize(size);
+  }
+  void reserve(size_t size) {
+    if (!IsBorrowed()) owned_.reserve(size);
+  }
+
+  std::span<const uint8_t> Span() const {
+    return IsBorrowed() ? std::span<const uint8_t>{*payload_} : std::span<const uint8_t>{owned_};
+  }
+  std::span<uint8_t> Span() {
+    Own();
+    return owned_;
+  }
+
+  void Write(std::ostream& os) const {
+    const auto bytes = Span();
+    util::Write(os, static_cast<uint64_t>(bytes.size()));
+    os.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    if (!os) util::ThrowRuntimeError("File write error.");
+  }
+  void Read(std::istream& is) {
+    payload_.reset();
+    util::Read(is, owned_);
+  }
+
+ private:
+  // Takes a private copy of borrowed bytes.
+  void Own() {
+    if (!IsBorrowed()) return;
+    owned_.assign(payload_->begin(), payload_->end());
+    payload_.reset();
+  }
+
+  std::vector<uint8_t> owned_;
+  Payload payload_;
+};
+
 struct Input;
 struct Output;
 
@@ -63,7 +129,7 @@ struct TransactionData {
   std::vector<Output> outputs;
   std::vector<Witness> witnesses;
   std::vector<Component> components;
-  std::vector<uint8_t> scripts;
+  ScriptBytes scripts;
 
   void ResizeInputs(util::SubArray<Input>& subarray, int size) {
     subarray = ResizeVector(inputs, subarray, size);
@@ -82,6 +148,50 @@ struct TransactionData {
   }
   int SizeBytes() const;
 
+  // Returns the number of bytes allocated beyond those in use.
+  int UnusedBytes() const;
+
+  // Allocates room for the given numbers of further elements, e.g. counted by a TransactionScanner,
+  // so that they can be appended without reallocation.
+  void Reserve(const TransactionCounts& counts) {
+    ReserveVector(inputs, inputs.size() + counts.inputs);
+    ReserveVector(outputs, outputs.size() + counts.outputs);
+    ReserveVector(witnesses, witnesses.size() + counts.witnesses);
+    ReserveVector(components, components.size() + counts.components);
+    if (!scripts.IsBorrowed()) ReserveVector(scripts, scripts.size() + counts.script_bytes);
+  }
+
+  // Returns true if the given numbers of further elements can be appended without reallocation.
+  bool HasRoom(const TransactionCounts& counts) const {
+    return inputs.size() + counts.inputs <= inputs.capacity() &&
+           outputs.size() + counts.outputs <= outputs.capacity() &&
+           witnesses.size() + counts.witnesses <= witnesses.capacity() &&
+           components.size() + counts.components <= components.capacity() &&
+           (scripts.IsBorrowed() || scripts.size() + counts.script_bytes <= scripts.capacity());
+  }
+
+  // Returns the number of times an array holding elements was reallocated to grow, and the bytes
+  // that those reallocations copied, which presizing the arrays avoids.
+  int GetReallocations() const {
+    return reallocations_;
+  }
+  int64_t GetReallocatedBytes() const {
+    return reallocated_bytes_;
+  }
+
+  // Reads a length-prefixed script. Borrowed script bytes are indexed in place, in which case the
+  // reader must be reading the borrowed payload itself; otherwise the bytes are copied.
+  void ReadScript(encoding::Reader& reader, ScriptArray& script) {
+    const int size = reader.ReadVarInt<int>();
+    if (scripts.IsBorrowed()) {
+      script = {static_cast<int>(reader.GetPos()), size};
+      reader.ReadBytes(size);
+    } else {
+      ResizeScriptBytes(script, size);
+      reader.ReadBytes(script.Span(scripts));
+    }
+  }
+
   // Returns the size in bytes of the serialized witness data.
   int GetWitnessBytes() const {
     return witness_bytes_;
@@ -93,24 +203,40 @@ struct TransactionData {
   void Write(std::ostream& os) const {
     std::apply([&](const auto&... arrs) {
       (util::Write(os, arrs), ...);
-    }, std::tie(inputs, outputs, witnesses, components, scripts));
+    }, std::tie(inputs, outputs, witnesses, components));
+    scripts.Write(os);
     util::Write(os, witness_bytes_);
   }
 
   void Read(std::istream& is) {
     std::apply([&](auto&... arrs) {
       (util::Read(is, arrs), ...);
-    }, std::tie(inputs, outputs, witnesses, components, scripts));
+    }, std::tie(inputs, outputs, witnesses, components));
+    scripts.Read(is);
     witness_bytes_ = util::Read<int>(is);
   }
 
  private:
   int witness_bytes_ = 0;
+  int reallocations_ = 0;
+  int64_t reallocated_bytes_ = 0;
+
+  // Records the copy made when an array holding elements must grow beyond its capacity.
+  template <typename Vector>
+  void CountReallocation(const Vector& vec, size_t size) {
+    if (size <= vec.capacity() || vec.size() == 0) return;
+    ++reallocations_;
+    reallocated_bytes_ += vec.size() * sizeof(typename Vector::value_type);
+  }
 
-  template <typename T, std::integral Count>
-  static util::SubArray<T, Count> ResizeVector(std::vector<T>& vec,
-                                               const util::SubArray<T, Count>& subarray,
-                                               Count size) {
+  template <typename Vector>
+  void ReserveVector(Vector& vec, size_t size) {
+    CountReallocation(vec, size);
+    vec.reserve(size);
+  }
+
+  template <typename Vector, typename T, std::integral Count>
+  util::SubArray<T, Count> ResizeVector(Vector& vec, const util::SubArray<T, Count>& subarray, Count size) {
     const int length = std::ssize(vec);
     const int start = subarray.StartIndex();
     const int end = subarray.EndIndex();
@@ -118,6 +244,7 @@ struct TransactionData {
 
     if (end == length) {
       // Rewind if the old subarray was the tail
+      CountReallocation(vec, start + size);
       vec.resize(start + size);
       return {start, size};
     } else if (start + size <= end) {
@@ -128,6 +255,7 @@ struct TransactionData {
         // Can't recover space from previous allocation -- burn and log.
         LogWarn() << "Overwriting transaction data cost " << (end - start) << " bytes of memory.";
       }
+      CountReallocation(vec, length + size);
       vec.resize(length + size);
       return {length, size};
     }
@@ -139,7 +267,8 @@ struct Input {
   ScriptArray signature_script = {};
   uint32_t sequence = 0;
 
-  void Serialize(encoding::Writer& writer, const TransactionData& data) const {
+  template <typename WriterT>
+  void Serialize(WriterT& writer, const TransactionData& data) const {
     previous_output.Serialize(writer);
     writer.WriteVarInt(signature_script.Size());
     writer.WriteBytes(signature_script.Span(data.scripts));
@@ -148,8 +277,7 @@ struct Input {
 
   void Deserialize(encoding::Reader& reader, TransactionData& data) {
     previous_output.Deserialize(reader);
-    data.ResizeScriptBytes(signature_script, reader.ReadVarInt<int>());
-    reader.ReadBytes(signature_script.Span(data.scripts));
+    data.ReadScript(reader, signature_script);
     reader.ReadLE4(sequence);
   }
 };
@@ -158,7 +286,8 @@ struct Output {
   int64_t value = 0;
   ScriptArray pk_script;
 
-  void Serialize(encoding::Writer& writer, const TransactionData& data) const {
+  template <typename WriterT>
+  void Serialize(WriterT& writer, const TransactionData& data) const {
     writer.WriteLE8(value);
     writer.WriteVarInt(pk_script.Size());
     writer.WriteBytes(pk_script.Span(data.scripts));
@@ -166,11 +295,20 @@ struct Output {
 
   void Deserialize(encoding::Reader& reader, TransactionData& data) {
     reader.ReadLE8(value);
-    data.ResizeScriptBytes(pk_script, reader.ReadVarInt<int>());
-    reader.ReadBytes(pk_script.Span(data.scripts));
+    data.ReadScript(reader, pk_script);
   }
 };
 
+inline int TransactionData::UnusedBytes() const {
+  size_t size = 0;
+  size += (inputs.capacity() - inputs.size()) * sizeof(Input);
+  size += (outputs.capacity() - outputs.size()) * sizeof(Output);
+  size += (witnesses.capacity() - witnesses.size()) * sizeof(Witness);
+  size += (components.capacity() - components.size()) * sizeof(Component);
+  size += scripts.capacity() - scripts.size();
+  return static_cast<int>(size);
+}
+
 inline int TransactionData::SizeBytes() const {
   size_t size = sizeof(*this);
   size += inputs.capacity() * sizeof(Input);
@@ -211,7 +349,15 @@ class TransactionDetail {
     return *wtxid;
   }
 
-  void Serialize(encoding::Writer& writer, const TransactionData& data, bool include_witness = true) const {
+  // Caches the txid and wtxid when they have been computed elsewhere, e.g. for a whole block.
+  void SetHashes(const protocol::Hash& tx_hash, const protocol::Hash& witness_hash) const {
+    txid = tx_hash;
+    wtxid = witness_hash;
+  }
+
+  // Serializes to any writer derived from encoding::WriterBase.
+  template <typename WriterT>
+  void Serialize(WriterT& writer, const TransactionData& data, bool include_witness = true) const {
     if (inputs.Size() == 0)
       util::ThrowOutOfRange("Transaction has zero inputs and can't be serialized.");
 
@@ -280,10 +426,8 @@ class TransactionDetail {
       data.ResizeWitnesses(witnesses, inputs.Size());
       for (Witness& witness : witnesses.Span(data.witnesses)) {
         data.ResizeComponents(witness, reader.ReadVarInt<int>());
-        for (Component& component : witness.Span(data.components)) {
-          data.ResizeScriptBytes(component, reader.ReadVarInt<int>());
-          reader.ReadBytes(component.Span(data.scripts));
-        }
+        for (Component& component : witness.Span(data.components))
+          data.ReadScript(reader, component);
       }
       const int witness_bytes = reader.GetPos() - witness_start;
       witness_size_bytes += witness_bytes;
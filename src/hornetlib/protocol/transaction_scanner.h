@@ -0,0 +1,104 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace hornet::protocol {
+
+// The numbers of variable-sized elements in one or more serialized transactions, as stored in
+// TransactionData.
+struct TransactionCounts {
+  int64_t inputs = 0;
+  int64_t outputs = 0;
+  int64_t witnesses = 0;
+  int64_t components = 0;
+  int64_t script_bytes = 0;
+};
+
+// Walks the structure of serialized transactions without decoding or storing them, to find where
+// each ends in a buffer that may hold only part of it, and to count its elements.
+class TransactionScanner {
+ public:
+  explicit TransactionScanner(std::span<const uint8_t> buffer) : buffer_(buffer) {}
+
+  // Returns the serialized size of the next transaction in the buffer, and adds its elements to
+  // the counts, or returns nullopt if the buffer ends before the transaction does. Values are not
+  // validated, which is left to deserialization.
+  std::optional<int> Scan() {
+    const size_t start = pos_;
+    const TransactionCounts counts = counts_;
+    if (const auto size = ScanNext()) return size;
+    pos_ = start;
+    counts_ = counts;
+    return std::nullopt;
+  }
+
+  // Returns the element counts of the transactions scanned so far.
+  const TransactionCounts& Counts() const {
+    return counts_;
+  }
+
+ private:
+  std::optional<int> ScanNext() {
+    const size_t start = pos_;
+    uint64_t inputs, outputs;
+    if (!Skip(4)) return std::nullopt;  // Version
+    if (pos_ >= buffer_.size()) return std::nullopt;
+    const bool witness = buffer_[pos_] == 0;
+    if (witness && !Skip(2)) return std::nullopt;  // Witness flag
+    if (!ReadVarInt(inputs)) return std::nullopt;
+    for (uint64_t i = 0; i < inputs; ++i)
+      if (!Skip(36) || !SkipScript() || !Skip(4)) return std::nullopt;
+    if (!ReadVarInt(outputs)) return std::nullopt;
+    for (uint64_t i = 0; i < outputs; ++i)
+      if (!Skip(8) || !SkipScript()) return std::nullopt;
+    if (witness) {
+      for (uint64_t i = 0; i < inputs; ++i) {
+        uint64_t components;
+        if (!ReadVarInt(components)) return std::nullopt;
+        for (uint64_t j = 0; j < components; ++j)
+          if (!SkipScript()) return std::nullopt;
+        counts_.components += components;
+      }
+      counts_.witnesses += inputs;
+    }
+    if (!Skip(4)) return std::nullopt;  // Lock time
+    counts_.inputs += inputs;
+    counts_.outputs += outputs;
+    return static_cast<int>(pos_ - start);
+  }
+
+  bool Skip(uint64_t bytes) {
+    if (bytes > buffer_.size() - pos_) return false;
+    pos_ += bytes;
+    return true;
+  }
+
+  bool ReadVarInt(uint64_t& value) {
+    if (pos_ >= buffer_.size()) return false;
+    const uint8_t prefix = buffer_[pos_];
+    const int width = prefix < 0xFD ? 0 : prefix == 0xFD ? 2 : prefix == 0xFE ? 4 : 8;
+    if (!Skip(1 + width)) return false;
+    value = width == 0 ? prefix : 0;
+    for (int i = 0; i < width; ++i) value |= uint64_t{buffer_[pos_ - width + i]} << (8 * i);
+    return true;
+  }
+
+  bool SkipScript() {
+    uint64_t length;
+    if (!ReadVarInt(length) || !Skip(length)) return false;
+    counts_.script_bytes += length;
+    return true;
+  }
+
+  std::span<const uint8_t> buffer_;
+  size_t pos_ = 0;
+  TransactionCounts counts_;
+};
+
+}  // namespace hornet::protocol
@@ -4,8 +4,7 @@
 // For licensing or usage inquiries, contact: ask@hornetnode.com.
 #pragma once
 
-#include "hornetlib/crypto/hash.h"
-#include "hornetlib/encoding/writer.h"
+#include "hornetlib/encoding/hash_writer.h"
 #include "hornetlib/protocol/transaction.h"
 
 namespace hornet::protocol {
@@ -13,11 +12,18 @@ namespace hornet::protocol {
 // Computes the txid/wtxid, which is the double-SHA256 hash of the serialized transaction,
 // excluding/including any witness data during the serialization.
 inline protocol::Hash ComputeTxid(const TransactionDetail& detail, const TransactionData& data, bool include_witness) {
-  // TODO: Create a HashWriter class that processes 64 bytes at a time for hashing.
-  encoding::Writer writer;
+  encoding::HashWriter writer;
   detail.Serialize(writer, data, include_witness);
-  const auto& buffer = writer.Buffer();
-  return crypto::DoubleSha256(buffer.begin(), buffer.end());
+  return writer.GetDoubleHash();
+}
+
+// Computes the inner, single SHA256 hash of the txid/wtxid, so that the outer hashes of many
+// transactions can be computed together.
+inline protocol::Hash ComputeTxidInnerHash(const TransactionDetail& detail, const TransactionData& data,
+                                           bool include_witness) {
+  encoding::HashWriter writer;
+  detail.Serialize(writer, data, include_witness);
+  return writer.GetHash();
 }
 
 }  // namespace hornet::protocol
@@ -4,6 +4,7 @@
 // For licensing or usage inquiries, contact: ask@hornetnode.com.
 #pragma once
 
+#include <cstdint>
 #include <ostream>
 
 #include "hornetlib/util/big_uint.h"
@@ -37,6 +38,9 @@ class Work {
   constexpr Work operator-(const Work& rhs) const {
     return value_ - rhs.value_;
   }
+  constexpr Work operator*(uint64_t rhs) const {
+    return value_ * rhs;
+  }
   constexpr Work& operator+=(const Work& rhs) {
     value_ += rhs.value_;
     return *this;
@@ -0,0 +1,102 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+#include "hornetlib/util/worker_pool.h"
+
+namespace hornet::util {
+
+// Returns the number of chunks into which ParallelChunks will split the given count.
+inline int GetChunkCount(int count, int min_chunk, int max_chunks = GetHardwareConcurrency()) {
+  return std::clamp(count / std::max(1, min_chunk), 1, std::max(1, max_chunks));
+}
+
+// Splits [0, count) into contiguous, ordered chunks of at least min_chunk items, and calls
+// fn(chunk, begin, end) for each chunk on the shared worker pool, returning when all are done.
+// The calling thread claims chunks too, so nested calls from pool threads cannot deadlock. Small
+// counts run inline as one chunk. The first exception thrown by fn is rethrown here.
+template <typename Fn>
+inline void ParallelChunks(int count, int min_chunk, Fn&& fn, int max_chunks = GetHardwareConcurrency()) {
+  const int chunks = GetChunkCount(count, min_chunk, max_chunks);
+  if (chunks == 1) {
+    fn(0, 0, count);
+    return;
+  }
+  const int size = (count + chunks - 1) / chunks;
+
+  // Shared with the helper jobs, which may start after this call has returned.
+  struct State {
+    std::atomic<int> next = 0;
+    std::atomic<int> done = 0;
+    std::mutex mutex;
+    std::exception_ptr error;
+  };
+  const auto state = std::make_shared<State>();
+  const auto run = [&fn, size, count, chunks](State& state) {
+    for (int chunk; (chunk = state.next.fetch_add(1)) < chunks;) {
+      try {
+        fn(chunk, chunk * size, std::min(count, (chunk + 1) * size));
+      } catch (...) {
+        std::lock_guard lock(state.mutex);
+        if (!state.error) state.error = std::current_exception();
+      }
+      if (state.done.fetch_add(1) + 1 == chunks) state.done.notify_all();
+    }
+  };
+  auto& pool = WorkerPool::Shared();
+  for (int i = 1; i < std::min(chunks, pool.ThreadCount() + 1); ++i)
+    pool.Post([state, run] { run(*state); });  // A job that starts late finds no chunks left.
+  run(*state);
+  for (int done; (done = state->done.load()) < chunks;) state->done.wait(done);
+  if (state->error) std::rethrow_exception(state->error);
+}
+
+// Calls fn(i) for each i in [begin, end) on the shared worker pool, in chunks of at least
+// min_chunk items.
+template <typename T, typename Fn>
+inline void ParallelFor(T begin, T end, Fn&& fn, int min_chunk = 1) {
+  ParallelChunks(static_cast<int>(end - begin), min_chunk, [&](int, int first, int last) {
+    for (int i = first; i < last; ++i) fn(static_cast<T>(begin + i));
+  });
+}
+
+// Returns initial plus the sum of fn(element) over the collection, evaluated in parallel.
+template <typename T, typename Collection, typename Fn>
+inline T ParallelSum(const Collection& collection, const T& initial, Fn&& fn) {
+  std::vector<T> partials(std::size(collection));
+  ParallelFor<size_t>(0, partials.size(), [&](size_t i) { partials[i] = fn(collection[i]); });
+  return std::accumulate(partials.begin(), partials.end(), initial);
+}
+
+// Sorts [begin, end) by sorting chunks in parallel and then merging pairs of runs in parallel.
+template <typename Iter>
+inline void ParallelSort(Iter begin, Iter end, int min_chunk = 1 << 14, int max_chunks = GetHardwareConcurrency()) {
+  const int count = static_cast<int>(end - begin);
+  const int chunks = GetChunkCount(count, min_chunk, max_chunks);
+  if (chunks == 1) {
+    std::sort(begin, end);
+    return;
+  }
+  ParallelChunks(count, min_chunk, [&](int, int first, int last) { std::sort(begin + first, begin + last); }, chunks);
+  for (int width = (count + chunks - 1) / chunks; width < count; width *= 2) {
+    ParallelFor(0, (count + 2 * width - 1) / (2 * width), [&](int pair) {
+      const int first = pair * 2 * width;
+      const int middle = std::min(count, first + width);
+      const int last = std::min(count, first + 2 * width);
+      if (middle < last) std::inplace_merge(begin + first, begin + middle, begin + last);
+    });
+  }
+}
+
+}  // namespace hornet::util
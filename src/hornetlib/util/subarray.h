@@ -48,6 +48,13 @@ class SubArray {
     return std::span<const T>{data}.subspan(start_, count_);
   }
 
+  // Returns the range within storage other than a vector, which exposes its elements via Span().
+  template <typename Storage>
+    requires requires(Storage& storage) { storage.Span(); }
+  auto Span(Storage& data) const {
+    return data.Span().subspan(start_, count_);
+  }
+
  private:
   int start_;
   Count count_;
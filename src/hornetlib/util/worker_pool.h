@@ -0,0 +1,77 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "hornetlib/util/thread_safe_queue.h"
+
+namespace hornet::util {
+
+inline int GetHardwareConcurrency() {
+  return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+// A fixed set of threads that run submitted jobs in submission order, each job's result or
+// exception being delivered through a future. Jobs still queued at destruction are abandoned,
+// and their futures report a broken promise.
+class WorkerPool {
+ public:
+  explicit WorkerPool(int threads = GetHardwareConcurrency()) {
+    for (int i = 0; i < std::max(1, threads); ++i)
+      workers_.emplace_back([this] { WorkerLoop(); });
+  }
+
+  ~WorkerPool() {
+    jobs_.Stop();
+    for (auto& t : workers_)
+      if (t.joinable()) t.join();
+  }
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  int ThreadCount() const {
+    return std::ssize(workers_);
+  }
+
+  // Returns the process-wide pool behind ParallelChunks. Its callers also run chunks themselves,
+  // so it has one thread fewer than the hardware.
+  static WorkerPool& Shared() {
+    static WorkerPool pool{GetHardwareConcurrency() - 1};
+    return pool;
+  }
+
+  // Queues a job with no result. The job must not throw.
+  void Post(std::function<void()> job) {
+    jobs_.Push(std::move(job));
+  }
+
+  template <typename Fn>
+  std::future<std::invoke_result_t<Fn>> Submit(Fn fn) {
+    using Result = std::invoke_result_t<Fn>;
+    // The task is shared so that the job can be held in a copyable std::function.
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::move(fn));
+    auto future = task->get_future();
+    Post([task] { (*task)(); });
+    return future;
+  }
+
+ private:
+  void WorkerLoop() {
+    while (auto job = jobs_.WaitPop()) (*job)();
+  }
+
+  ThreadSafeQueue<std::function<void()>> jobs_;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace hornet::util
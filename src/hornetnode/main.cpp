@@ -2,6 +2,7 @@
 //
 // This file is part of the Hornet Node project. All rights reserved.
 // For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include <algorithm>
 #include <iostream>
 #include <csignal>
 #include <memory>
@@ -30,6 +31,12 @@ int main(int argc, char** argv) {
   util::CommandLineParser parser("Hornet Node", "0.0.1");
   parser.AddOption("connect", &options.connect, "Connect to a specific peer");
   parser.AddOption("notifytcp", &options.notify_tcp_port, "Send notifications over TCP to the specified port");
+  parser.AddOption("datadir", &options.datadir, "Folder for on-disk data, including the UTXO database", std::string{"hornet_data"});
+  parser.AddFlag("validatespends", &options.validate_spends, "Validate spends against a UTXO database in the data folder");
+  parser.AddFlag("resetutxo", &options.reset_utxo, "Delete a UTXO database left in the data folder by a previous run");
+  parser.AddOption("pipeline", &options.pipeline_depth, "Number of blocks validated concurrently", 8);
+  parser.AddOption("sigcachesize", &options.signature_cache_mib, "Memory budget of the signature cache in MiB", 32);
+  parser.AddOption("assumevalid", &options.assume_valid, "Hash of a block whose ancestors' scripts are assumed valid");
 
   if (!parser.Parse(argc, argv))
     return 1;
@@ -38,6 +45,19 @@ int main(int argc, char** argv) {
     Controller controller;
     if (!options.connect.host.empty())
       controller.SetConnectAddress(options.connect);
+    controller.SetDataDirectory(options.datadir);
+    controller.SetSpendValidation(options.validate_spends);
+    controller.SetResetUtxo(options.reset_utxo);
+    controller.SetPipelineDepth(std::max(1, options.pipeline_depth));
+    controller.SetSignatureCacheSize(size_t(std::max(0, options.signature_cache_mib)) << 20);
+    if (!options.assume_valid.empty()) {
+      const auto hash = hornet::protocol::Hash::FromHex(options.assume_valid);
+      if (!hash) {
+        std::cerr << "Invalid block hash for --assumevalid: " << options.assume_valid << std::endl;
+        return 1;
+      }
+      controller.SetAssumeValid(*hash);
+    }
     if (options.notify_tcp_port > 0) {
       try {
         tcp_sink = std::make_unique<net::TcpNotificationSink>(net::kLocalhost, options.notify_tcp_port);
@@ -48,7 +68,13 @@ int main(int argc, char** argv) {
         return -1;
       }
     }
-    controller.Initialize();
+    try {
+      controller.Initialize();
+    } catch (const std::exception& e) {
+      std::cerr << "Could not initialize the node:" << std::endl;
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
     controller.Run([&]() { 
       return is_abort.load(); 
     });
@@ -7,4 +7,10 @@
 struct Options {
    hornet::node::net::PeerAddress connect;  // Peer address to connect to, e.g. 127.0.0.1:8333.
    uint16_t notify_tcp_port;  // TCP port number for sending notifications.
+   std::string datadir;  // Folder for on-disk data, including the UTXO database.
+   bool validate_spends;  // Whether to validate spends against a UTXO database.
+   bool reset_utxo;  // Whether to delete a UTXO database left by a previous run.
+   int pipeline_depth;  // Number of blocks validated concurrently.
+   int signature_cache_mib;  // Memory budget of the signature cache, in MiB.
+   std::string assume_valid;  // Hash of a block whose ancestors' scripts are not verified, if any.
 };
@@ -4,6 +4,11 @@
 // For licensing or usage inquiries, contact: ask@hornetnode.com.
 #include "hornetnodelib/controller.h"
 
+#include <iterator>
+
+#include "hornetlib/util/log.h"
+#include "hornetlib/util/throw.h"
+
 namespace hornet::node {
 
 Controller::Controller()
@@ -19,6 +24,23 @@ Controller::~Controller() {
 }
 
 void Controller::Initialize() {
+  if (spend_validation_) {
+    if (data_directory_.empty()) util::ThrowInvalidArgument("Spend validation requires a data directory.");
+    // The UTXO index is held in memory and rebuilt from genesis, so a table left on disk by a
+    // previous run is inconsistent with it. It is deleted only when a reset was asked for.
+    const auto folder = data_directory_ / "utxo";
+    if (std::filesystem::exists(folder) && !std::filesystem::is_empty(folder)) {
+      if (!reset_utxo_)
+        util::ThrowRuntimeError("UTXO folder ", folder.string(), " holds data from a previous run and must be reset.");
+      const auto entries = std::distance(std::filesystem::directory_iterator{folder}, {});
+      LogWarn() << "Deleting " << entries << " entries from UTXO folder " << folder << " left by a previous run.";
+      std::filesystem::remove_all(folder);
+    }
+    std::filesystem::create_directories(folder);
+    database_ = std::make_unique<data::utxo::Database>(folder);
+    sync_manager_.EnableSpendValidation(*database_, pipeline_depth_);
+    if (assume_valid_) sync_manager_.SetAssumeValid(*assume_valid_);
+  }
   if (!connect_address_.host.empty())
     message_loop_.AddOutboundPeer(connect_address_.host, connect_address_.port);
 }
@@ -5,11 +5,17 @@
 #pragma once
 
 #include <atomic>
+#include <filesystem>
+#include <memory>
+#include <optional>
 #include <thread>
 
+#include "hornetlib/crypto/secp256k1/signature_cache.h"
 #include "hornetlib/data/keyframe_sidecar.h"
 #include "hornetlib/data/sidecar_binding.h"
 #include "hornetlib/data/timechain.h"
+#include "hornetlib/data/utxo/database.h"
+#include "hornetlib/protocol/hash.h"
 #include "hornetnodelib/dispatch/peer_negotiator.h"
 #include "hornetnodelib/dispatch/protocol_loop.h"
 #include "hornetnodelib/net/peer_address.h"
@@ -31,6 +37,38 @@ class Controller {
     connect_address_ = address;
   }
 
+  // Sets the folder for on-disk data, such as the UTXO database used by spend validation.
+  void SetDataDirectory(const std::filesystem::path& path) {
+    data_directory_ = path;
+  }
+
+  // Enables full validation of blocks' spends against a UTXO database in the data directory, in
+  // place of structural and contextual validation alone.
+  void SetSpendValidation(bool enable) {
+    spend_validation_ = enable;
+  }
+
+  // Allows Initialize to delete a UTXO database left in the data directory by a previous run.
+  void SetResetUtxo(bool reset) {
+    reset_utxo_ = reset;
+  }
+
+  // Sets the number of blocks that may be validated concurrently.
+  void SetPipelineDepth(int depth) {
+    pipeline_depth_ = depth;
+  }
+
+  // Sets a block whose ancestors need not have their spends and scripts validated, once it is
+  // buried in the best header chain.
+  void SetAssumeValid(const protocol::Hash& hash) {
+    assume_valid_ = hash;
+  }
+
+  // Sets the memory budget of the process-wide signature cache, discarding its entries.
+  void SetSignatureCacheSize(size_t bytes) {
+    crypto::secp256k1::SignatureCache::Global().Resize(bytes);
+  }
+
   // Initialize the controller, setting up necessary components.
   void Initialize();
 
@@ -54,7 +92,14 @@ class Controller {
   net::PeerManager peer_manager_;             // Manages network peers.
   dispatch::PeerNegotiator peer_negotiator_;  // Negotiates peer connections.
   net::PeerAddress connect_address_;          // Address to connect to if specified.
-  
+
+  std::filesystem::path data_directory_;          // Folder for on-disk data, if specified.
+  bool spend_validation_ = false;                 // Whether spends are validated.
+  bool reset_utxo_ = false;                       // Whether a previous UTXO database may be deleted.
+  int pipeline_depth_ = 8;                        // Blocks validated concurrently.
+  std::optional<protocol::Hash> assume_valid_;    // Block assumed valid, if specified.
+  std::unique_ptr<data::utxo::Database> database_;  // The UTXO database, which outlives sync_manager_.
+
   sync::SyncManager sync_manager_;  // Handles initial synchronization of the timechain with peers.
 };
 
@@ -4,6 +4,7 @@
 // For licensing or usage inquiries, contact: ask@hornetnode.com.
 #include <atomic>
 #include <chrono>
+#include <future>
 #include <queue>
 #include <span>
 #include <thread>
@@ -12,6 +13,7 @@
 #include "hornetlib/data/timechain.h"
 #include "hornetlib/protocol/constants.h"
 #include "hornetlib/protocol/framer.h"
+#include "hornetlib/protocol/message/block.h"
 #include "hornetlib/protocol/message_factory.h"
 #include "hornetlib/protocol/parser.h"
 #include "hornetlib/util/log.h"
@@ -83,7 +85,8 @@ net::PeerManager::PollResult ProtocolLoop::PollReadWrite() {
 
   // If we already have pending input or output to process, don't block on poll;
   // instead, iterate immediately to reduce latency. This is expected during normal operation.
-  const int timeout_ms = backlog ? 0 : kMaxPollTimeoutMs;
+  // While messages are decoding, block only briefly, to collect them soon after they complete.
+  const int timeout_ms = backlog ? 0 : !decoding_.empty() ? kDecodePollTimeoutMs : kMaxPollTimeoutMs;
 
   // TODO: Note that we have some work to do in being resilient to DoS attacks which could keep
   // us spinning with a permanent backlog. We may want to track backlog into a metric over time,
@@ -122,8 +125,11 @@ void ProtocolLoop::ReadToInbox(std::span<net::SharedPeer> read) {
   // Read from sockets.
   ReadSocketsToBuffers(read, peers_for_parsing_);
 
-  // Parse and deserialize messages.
-  ParseBuffersToMessages(peers_for_parsing_, inbox_);
+  // Parse messages, deserializing the small ones.
+  ParseBuffersToMessages();
+
+  // Collect the large messages deserialized by the decoder threads.
+  CollectDecodedMessages();
 }
 
 void ProtocolLoop::WriteFromOutbox(std::span<net::SharedPeer> write) {
@@ -176,57 +182,78 @@ void ProtocolLoop::NotifyLoop() {
 }
 
 // Visit each peer buffer with new data recently arrived, and look to see whether
-// there exists one or more whole messages ready for parsing. If so, parse and store
-// the message in a queue, then eat the bytes in the peer buffer.
-/* static */ void ProtocolLoop::ParseBuffersToMessages(std::queue<net::WeakPeer>& peers_for_parsing,
-                                                       Inbox& inbox) {
+// there exists one or more whole messages ready for parsing. If so, unframe the message, then
+// either decode it inline and store it in a queue, or for a large message, copy its payload to
+// a decoder thread. Then eat the bytes in the peer buffer. A block message whose payload is still
+// arriving is parsed incrementally instead.
+void ProtocolLoop::ParseBuffersToMessages() {
   protocol::Parser parser;
-  while (!peers_for_parsing.empty()) {
-    const net::SharedPeer peer = peers_for_parsing.front().lock();
-    peers_for_parsing.pop();
+  while (!peers_for_parsing_.empty()) {
+    const net::SharedPeer peer = peers_for_parsing_.front().lock();
+    peers_for_parsing_.pop();
     if (!peer || peer->IsDropped()) 
       continue;
 
     try {
-      const auto& factory = protocol::MessageFactory::Default();
       bool continue_later = true;
       // Limit the number of messages parsed per peer per frame to prevent monopolization by noisy
       // peers.
       for (size_t count = 0; count < kMaxParsedMessagesPerFrame; ++count) {
         const auto unparsed = peer->GetConnection().PeekBufferedData();
-        if (!parser.IsCompleteMessage(unparsed)) {
+
+        const bool streaming = streaming_.contains(peer->GetId()) || IsPartialBlock(parser, unparsed);
+        if (!streaming && !parser.IsCompleteMessage(unparsed)) {
           // There are no more complete messages to be parsed for this peer.
           continue_later = false;
           break;
         }
 
-        // Parse the message, validating the header data.
-        const auto parsed = parser.Parse(unparsed);
-
-        // Eat the parsed bytes from the peer buffer.
-        peer->GetConnection().ConsumeBufferedData(protocol::kHeaderLength + parsed.payload.size());
-
-        // Instantiate a protocol::Message object of the correct derived type.
-        if (auto msg = factory.Create(parsed.header.command)) {
-          // Deserialize the message from the payload.
-          encoding::Reader reader{parsed.payload};
-          msg->Deserialize(reader);
+        // Leave further messages, including the rest of a streamed block, in the buffer while this
+        // peer has too many still decoding.
+        const auto decoding = decoding_.find(peer->GetId());
+        if (decoding != decoding_.end() && std::ssize(decoding->second) >= kMaxDecodingMessagesPerPeer)
+          break;
 
-          // Writes the metadata into the message.
-          msg->SetEnvelope({.direction = protocol::Message::Direction::Inbound,
-                            .peer_id = peer->GetId(),
-                            .timestamp = std::chrono::system_clock::now()});
+        // Parse a block message incrementally while its payload is still arriving.
+        if (streaming) {
+          if (!StreamBlock(parser, *peer)) {
+            // The rest of the block has yet to arrive.
+            continue_later = false;
+            break;
+          }
+          continue;
+        }
 
+        // Unframe the message, validating the header data.
+        const auto parsed = parser.Unframe(unparsed);
+        const protocol::Message::Envelope envelope{.direction = protocol::Message::Direction::Inbound,
+                                                   .peer_id = peer->GetId(),
+                                                   .timestamp = std::chrono::system_clock::now()};
+
+        if (std::ssize(parsed.payload) >= kMinDecodeOffloadBytes) {
+          // Hand a copy of the payload to a decoder thread, since the peer buffer will be reused.
+          // The message may keep the shared copy to reference in place, rather than copy again.
+          decoding_[peer->GetId()].push_back(decoders_.Submit(
+              [header = parsed.header,
+               payload = std::make_shared<const std::vector<uint8_t>>(parsed.payload.begin(), parsed.payload.end()),
+               envelope] { return DecodeMessage({header, *payload}, envelope, payload); }));
+        } else if (decoding != decoding_.end() && !decoding->second.empty()) {
+          // Decode inline, but queue the message behind this peer's earlier messages.
+          std::promise<std::unique_ptr<protocol::Message>> decoded;
+          decoded.set_value(DecodeMessage(parsed, envelope));
+          decoding->second.push_back(decoded.get_future());
+        } else if (auto msg = DecodeMessage(parsed, envelope)) {
           // Add the deserialized message to the queue for dispatch and processing.
-          inbox.push(std::move(msg));
-        } else {
-          // Unrecognized message command.
+          inbox_.push(std::move(msg));
         }
+
+        // Eat the parsed bytes from the peer buffer.
+        peer->GetConnection().ConsumeBufferedData(protocol::kHeaderLength + parsed.payload.size());
       }
       // Allow the connection's input buffer to be trimmed
       peer->GetConnection().TrimBufferedData();
       // Peer may have more complete messages — requeue for next frame
-      if (continue_later) peers_for_parsing.push(peer);
+      if (continue_later) peers_for_parsing_.push(peer);
     } catch (std::exception& e) {
       // If any peer-specific behavior throws, we will defensively drop the connection,
       // marking the peer for removal. This also clears the connection's read buffer,
@@ -238,6 +265,92 @@ void ProtocolLoop::NotifyLoop() {
   }
 }
 
+// Returns true if the buffer starts with the header of a block message whose payload has only
+// partly arrived.
+/* static */ bool ProtocolLoop::IsPartialBlock(const protocol::Parser& parser,
+                                               std::span<const uint8_t> unparsed) {
+  return unparsed.size() >= protocol::kHeaderLength && !parser.IsCompleteMessage(unparsed) &&
+         protocol::Parser::ReadHeader(unparsed).command == "block";
+}
+
+// Parses the block message at the front of a peer's buffer as far as its payload has arrived,
+// moving the payload bytes out of the buffer into the block. Returns true once the whole block has
+// been parsed and queued for dispatch.
+bool ProtocolLoop::StreamBlock(const protocol::Parser& parser, net::Peer& peer) {
+  auto& connection = peer.GetConnection();
+  auto it = streaming_.find(peer.GetId());
+  if (it == streaming_.end()) {
+    const auto header = parser.UnframeHeader(connection.PeekBufferedData());
+    connection.ConsumeBufferedData(protocol::kHeaderLength);
+    const protocol::Message::Envelope envelope{.direction = protocol::Message::Direction::Inbound,
+                                               .peer_id = peer.GetId(),
+                                               .timestamp = std::chrono::system_clock::now()};
+    it = streaming_.emplace(peer.GetId(), StreamingBlock{protocol::BlockParser{header}, envelope}).first;
+  }
+
+  auto& block_parser = it->second.parser;
+  connection.ConsumeBufferedData(block_parser.Parse(connection.PeekBufferedData()));
+  if (!block_parser.IsComplete()) return false;
+
+  // Verifies the checksum and hashes the transactions on a decoder thread, in this peer's order.
+  decoding_[peer.GetId()].push_back(decoders_.Submit(
+      [streaming = std::move(it->second)]() mutable -> std::unique_ptr<protocol::Message> {
+        auto msg = std::make_unique<protocol::message::Block>();
+        msg->SetBlock(streaming.parser.Finish());
+        msg->SetEnvelope(streaming.envelope);
+        return msg;
+      }));
+  streaming_.erase(it);
+  return true;
+}
+
+// Moves the messages whose decoding has completed to the inbox, stopping at each peer's first
+// message still decoding, so that every peer's messages reach the inbox in arrival order.
+void ProtocolLoop::CollectDecodedMessages() {
+  for (auto it = decoding_.begin(); it != decoding_.end();) {
+    auto& queue = it->second;
+    try {
+      while (!queue.empty() &&
+             queue.front().wait_for(std::chrono::seconds{0}) == std::future_status::ready) {
+        auto msg = queue.front().get();
+        queue.pop_front();
+        if (msg) inbox_.push(std::move(msg));
+      }
+    } catch (std::exception& e) {
+      // A checksum or deserialization failure drops the peer, along with its later messages.
+      const auto peer = peers_.GetRegistry().FromId(it->first);
+      LogWarn() << "ProtocolLoop::CollectDecodedMessages dropping peer " << it->first << ": \""
+        << e.what() << "\".";
+      if (peer) peer->Drop();
+      queue.clear();
+    }
+    it = queue.empty() ? decoding_.erase(it) : std::next(it);
+  }
+}
+
+// Verifies the checksum of an unframed message, then instantiates and deserializes a
+// protocol::Message object of the correct derived type. Returns null for an unrecognized command.
+// If given, shared holds the payload. Runs on the loop thread or a decoder thread.
+/* static */ std::unique_ptr<protocol::Message> ProtocolLoop::DecodeMessage(
+    const protocol::Parser::ParsedMessage& parsed, const protocol::Message::Envelope& envelope,
+    std::shared_ptr<const std::vector<uint8_t>> shared /* = nullptr */) {
+  protocol::Parser::VerifyChecksum(parsed);
+  auto msg = protocol::MessageFactory::Default().Create(parsed.header.command);
+  if (!msg) return nullptr;  // Unrecognized message command.
+
+  // Deserialize the message from the payload.
+  if (shared) {
+    msg->DeserializeShared(std::move(shared));
+  } else {
+    encoding::Reader reader{parsed.payload};
+    msg->Deserialize(reader);
+  }
+
+  // Writes the metadata into the message.
+  msg->SetEnvelope(envelope);
+  return msg;
+}
+
 // Pull messages from the inbound queue and dispatch each one in turn to the processor.
 // OPT: A future optimization could be to distribute work over parallel threads where each
 // concurrent thread represents a different peer.
@@ -303,6 +416,8 @@ void ProtocolLoop::Cleanup() {
     if (!peer->IsDropped())
       continue;
     outbox_.erase(peer);
+    decoding_.erase(peer->GetId());
+    streaming_.erase(peer->GetId());
     handshake_complete_.erase(peer->GetId());
     for (EventHandler* handler : event_handlers_)
       handler->OnPeerDisconnect(peer);
@@ -6,14 +6,19 @@
 
 #include <atomic>
 #include <deque>
+#include <future>
+#include <map>
 #include <optional>
 #include <queue>
 #include <unordered_set>
 #include <vector>
 
 #include "hornetlib/data/timechain.h"
+#include "hornetlib/protocol/block_parser.h"
 #include "hornetlib/protocol/constants.h"
+#include "hornetlib/protocol/parser.h"
 #include "hornetlib/util/timeout.h"
+#include "hornetlib/util/worker_pool.h"
 #include "hornetnodelib/dispatch/broadcaster.h"
 #include "hornetnodelib/dispatch/event_handler.h"
 #include "hornetnodelib/dispatch/serialization_memo.h"
@@ -32,7 +37,7 @@ class ProtocolLoop : public Broadcaster {
   };
   using BreakCondition = std::function<bool()>;
  
-  ProtocolLoop(net::PeerManager& peers) : peers_(peers) {}
+  ProtocolLoop(net::PeerManager& peers) : peers_(peers), decoders_(kDecoderThreads) {}
 
   void AddEventHandler(EventHandler* handler) {
     Assert(handler != nullptr);
@@ -59,6 +64,13 @@ class ProtocolLoop : public Broadcaster {
   using OutboxKey = std::weak_ptr<net::Peer>;
   using OutboxCompare = std::owner_less<OutboxKey>;
   using Outbox = std::map<OutboxKey, OutboundMessageQueue, OutboxCompare>;
+  // Messages of one peer still decoding, or else waiting behind one that is, in arrival order.
+  using DecodeQueue = std::deque<std::future<std::unique_ptr<protocol::Message>>>;
+  // A block message being parsed as its payload arrives.
+  struct StreamingBlock {
+    protocol::BlockParser parser;
+    protocol::Message::Envelope envelope;
+  };
 
   net::PeerManager::PollResult PollReadWrite();
   void ReadToInbox(std::span<net::SharedPeer> read);
@@ -67,7 +79,13 @@ class ProtocolLoop : public Broadcaster {
   void NotifyHandshake();
   void NotifyLoop();
   static void ReadSocketsToBuffers(std::span<net::SharedPeer> read, std::queue<net::WeakPeer>& peers_for_parsing);
-  static void ParseBuffersToMessages(std::queue<net::WeakPeer>& peers_for_parsing, Inbox& inbox);
+  void ParseBuffersToMessages();
+  void CollectDecodedMessages();
+  bool StreamBlock(const protocol::Parser& parser, net::Peer& peer);
+  static bool IsPartialBlock(const protocol::Parser& parser, std::span<const uint8_t> unparsed);
+  static std::unique_ptr<protocol::Message> DecodeMessage(
+      const protocol::Parser::ParsedMessage& parsed, const protocol::Message::Envelope& envelope,
+      std::shared_ptr<const std::vector<uint8_t>> shared = nullptr);
   void ProcessMessages();
   static void FrameMessagesToBuffers(Outbox& outbox);
   static int WriteBuffersToSockets(std::span<net::SharedPeer> write);
@@ -80,6 +98,9 @@ class ProtocolLoop : public Broadcaster {
   Outbox outbox_;
   std::vector<EventHandler*> event_handlers_;
   std::unordered_set<net::PeerId> handshake_complete_;
+  util::WorkerPool decoders_;
+  std::map<net::PeerId, DecodeQueue> decoding_;
+  std::map<net::PeerId, StreamingBlock> streaming_;
 
   // Loop tuning parameters — control per-peer and per-frame limits
 
@@ -91,6 +112,17 @@ class ProtocolLoop : public Broadcaster {
   // Prevents noisy peers from overwhelming the parser with many tiny messages.
   static constexpr int kMaxParsedMessagesPerFrame = 5;
 
+  // Minimum payload size whose checksum and deserialization are offloaded to the decoder threads.
+  // Smaller messages are decoded inline, where the handoff would cost more than it saves.
+  static constexpr int kMinDecodeOffloadBytes = 64 * 1024;  // 64 KiB
+
+  // Number of threads decoding large messages, e.g. blocks, off the loop thread.
+  static constexpr int kDecoderThreads = 2;
+
+  // Maximum number of messages per peer queued behind or in the decoder threads.
+  // Stops a peer streaming large messages from queuing unbounded decoded data.
+  static constexpr int kMaxDecodingMessagesPerPeer = 8;
+
   // Maximum processing time allowed per frame across all peers.
   // Prevents processing inbound messages from starving timely responses.
   static constexpr int kMaxProcessMsPerFrame = 50;
@@ -102,6 +134,10 @@ class ProtocolLoop : public Broadcaster {
   // Maximum time to block when polling if we don't have any messages queued already.
   // Balances between allowing idle time and being responsive to aborts. 
   static constexpr int kMaxPollTimeoutMs = 100;
+
+  // Maximum time to block when polling while messages are being decoded off the loop thread.
+  // Bounds the delay between a decode completing and its message being dispatched.
+  static constexpr int kDecodePollTimeoutMs = 1;
 };
 
 }  // namespace hornet::node::dispatch
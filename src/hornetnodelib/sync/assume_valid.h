@@ -0,0 +1,77 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include "hornetlib/data/header_timechain.h"
+#include "hornetlib/protocol/hash.h"
+#include "hornetlib/protocol/work.h"
+
+namespace hornet::node::sync {
+
+// Decides which blocks may skip the validation of their spends and scripts, given a block that the
+// operator assumes valid. A block qualifies if it is the assumed-valid block or one of its ancestors,
+// and the assumed-valid block is in the best header chain, buried under enough work. Structural and
+// contextual validation, and UTXO accounting, still apply to every block.
+class AssumeValid {
+ public:
+  // The default burial, in blocks' worth of work at the tip's difficulty: two weeks of blocks.
+  static constexpr int kDefaultBurialBlocks = 2016;
+
+  explicit AssumeValid(const protocol::Hash& hash, int burial_blocks = kDefaultBurialBlocks)
+      : hash_(hash), burial_blocks_(burial_blocks) {}
+
+  // Returns true if the block with the given key may skip spend validation. Requires a read lock
+  // on the headers.
+  bool Covers(const data::HeaderTimechain& headers, int height, const protocol::Hash& hash);
+
+ private:
+  struct Anchor {
+    int height;
+    protocol::Work total_work;
+  };
+
+  // Returns the position of the assumed-valid block in the header chain, once it has been found.
+  std::optional<Anchor> Resolve(const data::HeaderTimechain& headers);
+
+  const protocol::Hash hash_;
+  const int burial_blocks_;
+  std::mutex mutex_;
+  std::optional<Anchor> anchor_;  // Fixed once found, since a block's total work is fixed by its ancestry.
+  int searched_length_ = 0;       // The chain length already searched.
+  protocol::Hash searched_tip_;   // The chain tip already searched, to detect a reorg.
+};
+
+inline bool AssumeValid::Covers(const data::HeaderTimechain& headers, int height,
+                                const protocol::Hash& hash) {
+  const auto anchor = Resolve(headers);
+  if (!anchor || height > anchor->height || anchor->height >= headers.ChainLength()) return false;
+  // Both blocks must be in the best chain, which guarantees the ancestry.
+  if (headers.GetChainHash(anchor->height) != hash_ || headers.GetChainHash(height) != hash) return false;
+  const auto tip = headers.ChainTip();
+  return tip->total_work - anchor->total_work >= tip->local_work * burial_blocks_;
+}
+
+inline std::optional<AssumeValid::Anchor> AssumeValid::Resolve(const data::HeaderTimechain& headers) {
+  std::lock_guard lock(mutex_);
+  if (anchor_) return anchor_;
+
+  // Searches only the headers added since the last search, unless the chain has since reorged.
+  const int length = headers.ChainLength();
+  if (searched_length_ > length ||
+      (searched_length_ > 0 && headers.GetChainHash(searched_length_ - 1) != searched_tip_))
+    searched_length_ = 0;
+  for (auto it = headers.ChainTip(); it && it->height >= searched_length_; ++it) {
+    if (it->hash == hash_) return anchor_ = Anchor{it->height, it->total_work};
+  }
+  searched_length_ = length;
+  searched_tip_ = length > 0 ? headers.GetChainHash(length - 1) : protocol::Hash{};
+  return std::nullopt;
+}
+
+}  // namespace hornet::node::sync
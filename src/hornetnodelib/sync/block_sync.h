@@ -5,24 +5,34 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <format>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <semaphore>
 #include <thread>
 #include <variant>
 
 #include "hornetlib/consensus/types.h"
 #include "hornetlib/consensus/validate_api.h"
+#include "hornetlib/crypto/secp256k1/signature_cache.h"
 #include "hornetlib/data/sidecar_binding.h"
 #include "hornetlib/data/timechain.h"
+#include "hornetlib/data/utxo/database.h"
 #include "hornetlib/protocol/message/block.h"
 #include "hornetlib/protocol/message/getdata.h"
 #include "hornetlib/util/notify.h"
 #include "hornetlib/util/thread_safe_queue.h"
 #include "hornetlib/util/throw.h"
+#include "hornetlib/util/timeout.h"
 #include "hornetnodelib/net/peer.h"
+#include "hornetnodelib/sync/assume_valid.h"
 #include "hornetnodelib/sync/sync_handler.h"
 #include "hornetnodelib/sync/types.h"
+#include "hornetnodelib/sync/validation_pipeline.h"
 
 namespace hornet::node::sync {
 
@@ -36,6 +46,19 @@ class BlockSync {
     max_queue_bytes_ = max_queue_bytes;
   }
 
+  // Routes downloaded blocks through a ValidationPipeline with full spend validation against the
+  // given UTXO database, in place of structural and contextual validation alone. Blocks retire in
+  // height order and are then marked Validated in the sidecar. Must be called before StartSync.
+  void EnableSpendValidation(data::utxo::Database& db, int pipeline_depth);
+
+  // Skips spend and script validation for the given block and its ancestors, once it is buried
+  // under enough work in the best header chain. Such blocks are marked AssumedValid in the sidecar,
+  // rather than Validated, so that they can later be re-checked. Must be called before StartSync.
+  void SetAssumeValid(const protocol::Hash& hash) {
+    Assert(!request_active_.test());
+    assume_valid_ = std::make_unique<AssumeValid>(hash);
+  }
+
   // Begins downloading and validating blocks from a given peer.
   void StartSync(net::WeakPeer peer);
 
@@ -46,12 +69,30 @@ class BlockSync {
     net::WeakPeer peer;
     data::Key id;
     std::shared_ptr<const protocol::Block> block;
+    bool assumed_valid = false;  // Whether spend validation was skipped.
+    bool completes_sync = false;  // Whether no more blocks were requested after this one.
   };
 
+  // A block that failed in the validation pipeline, pending handling on the sync thread.
+  struct Failure {
+    Item item;
+    consensus::Error error;
+  };
+
+  // How long the sync thread waits for a pipeline slot or a queued block before checking for failures.
+  static constexpr std::chrono::milliseconds kPipelinePoll{50};
+
   static int SizeInBytes(const Item& item) {
     return sizeof(Item) + item.block->SizeBytes();
   }
 
+  // Publishes the queue accounting for a received block, including the bytes allocated to it but
+  // unused, which presized deserialization keeps near zero.
+  void NotifyQueued(const protocol::Block& block) const;
+
+  // Publishes the progress metrics after the block at the given height is validated.
+  static void NotifyValidated(int height);
+
   enum class RequestState { Active, Deferred, Disconnected, End };
 
   // Validates queued blocks, and adds them to the timechain.
@@ -66,6 +107,16 @@ class BlockSync {
   consensus::Result ValidateItem(const Item& item);
   void HandleError(const Item& item, consensus::Error error);
 
+  // Submits a block to the validation pipeline, waiting for a free pipeline slot.
+  void SubmitItem(Item item);
+  // Called by the validation pipeline as each block retires, in height order.
+  void OnValidated(int height, consensus::Result result);
+  // Reports and recovers from a pipeline failure, if any. Called only on the sync thread.
+  void HandleFailure();
+  // Discards the pipeline and the database state from the given failed height onwards.
+  void ResetPipeline(int height);
+  std::unique_ptr<ValidationPipeline> MakePipeline(int start_height);
+
   data::Timechain& timechain_;
   BlockValidationBinding validation_;
   SyncHandler& handler_;
@@ -87,6 +138,16 @@ class BlockSync {
   // simultaneous in-flight requests.
 
   data::Key request_;
+
+  // Spend validation state, used when EnableSpendValidation has been called.
+  data::utxo::Database* db_ = nullptr;
+  int pipeline_depth_ = 0;
+  std::unique_ptr<std::counting_semaphore<>> pipeline_slots_;  // Bounds the blocks in flight.
+  std::mutex submitted_mutex_;
+  std::map<int, Item> submitted_;     // Blocks in the pipeline, by height.
+  std::optional<Failure> failure_;     // Lowest block that failed, pending a pipeline reset.
+  std::unique_ptr<AssumeValid> assume_valid_;  // Set when spend validation may be skipped.
+  std::unique_ptr<ValidationPipeline> pipeline_;  // Declared last, so destroyed first.
 };
 
 inline BlockSync::BlockSync(data::Timechain& timechain, BlockValidationBinding validation,
@@ -99,6 +160,24 @@ inline BlockSync::BlockSync(data::Timechain& timechain, BlockValidationBinding v
 inline BlockSync::~BlockSync() {
   queue_.Stop();
   worker_thread_.join();
+  pipeline_.reset();
+}
+
+inline void BlockSync::EnableSpendValidation(data::utxo::Database& db, int pipeline_depth) {
+  Assert(!request_active_.test());
+  db_ = &db;
+  pipeline_depth_ = pipeline_depth;
+  pipeline_slots_ = std::make_unique<std::counting_semaphore<>>(2 * pipeline_depth);
+  pipeline_ = MakePipeline(db.GetContiguousLength());
+}
+
+inline std::unique_ptr<ValidationPipeline> BlockSync::MakePipeline(int start_height) {
+  return std::make_unique<ValidationPipeline>(
+      timechain_, *db_,
+      [this](const std::shared_ptr<const protocol::Block>&, int height, consensus::Result result) {
+        OnValidated(height, result);
+      },
+      pipeline_depth_, start_height);
 }
 
 // Returns the next block key to request from a peer.
@@ -186,6 +265,7 @@ inline void BlockSync::OnBlock(net::SharedPeer peer, const protocol::message::Bl
   // Pushes work onto the thread-safe async work queue.
   Item item{peer, expected, block};
   queue_bytes_ += SizeInBytes(item);
+  NotifyQueued(*block);
   queue_.Push(std::move(item));
 
   // Now we have queued the block, free up one request slot for another download.
@@ -195,6 +275,13 @@ inline void BlockSync::OnBlock(net::SharedPeer peer, const protocol::message::Bl
   RequestNextBlock(peer);
 }
 
+inline void BlockSync::NotifyQueued(const protocol::Block& block) const {
+  util::NotifyMetric("sync/queue", {{"queue_bytes", int64_t(queue_bytes_)},
+                                    {"block_bytes", int64_t(block.SizeBytes())},
+                                    {"reallocations", int64_t(block.GetReallocations())},
+                                    {"reallocated_bytes", block.GetReallocatedBytes()}});
+}
+
 inline consensus::Result BlockSync::ValidateItem(const Item& item) {
   // Validates the block.
   return consensus::ValidateStructural(*item.block).AndThen([&] {
@@ -216,12 +303,23 @@ inline consensus::Result BlockSync::ValidateItem(const Item& item) {
 }
 
 inline void BlockSync::Process() {
-  for (std::optional<Item> item; (item = queue_.WaitPop());) {
+  // With a pipeline, wake periodically so that failures are handled even when no blocks arrive.
+  const auto wait = [&] { return pipeline_ ? util::Timeout{kPipelinePoll} : util::Timeout::Infinite(); };
+  for (std::optional<Item> item; (item = queue_.WaitPop(wait())) || !queue_.IsStopped();) {
+    if (pipeline_) HandleFailure();
+    if (!item) continue;
     queue_bytes_ -= SizeInBytes(*item);
 
     // As soon as we pop from the queue, we can consider filling the empty queue slot.
     const auto request_state = RequestNextBlock(item->peer);
 
+    if (pipeline_) {
+      // Completion is reported once the last block has been validated by the pipeline.
+      item->completes_sync = request_state == RequestState::End;
+      SubmitItem(std::move(*item));
+      continue;
+    }
+
     // Validates the block.
     const auto result = ValidateItem(*item);
 
@@ -233,7 +331,7 @@ inline void BlockSync::Process() {
     }
 
     // Sets the validation status flag into the metadata sidecar.
-    util::NotifyMetric("sync/blocks", {{"blocks_validated", item->id.height + 1}});
+    NotifyValidated(item->id.height);
     LogDebug() << "Block height " << item->id.height << " validated, " << item->block->SizeBytes()
                << " bytes.";
     validation_.Set(item->id, BlockValidationStatus::StructureValid);
@@ -248,6 +346,99 @@ inline void BlockSync::Process() {
   }
 }
 
+inline void BlockSync::SubmitItem(Item item) {
+  // A failed pipeline may hold its slots while waiting for heights that will never arrive, so the
+  // wait is bounded and any failure is handled before trying again.
+  while (!pipeline_slots_->try_acquire_for(kPipelinePoll)) {
+    if (queue_.IsStopped()) return;
+    HandleFailure();
+  }
+  HandleFailure();
+
+  const int height = item.id.height;
+  if (db_->GetContiguousLength() > height) {
+    pipeline_slots_->release();  // Already in the database, e.g. a stale request after a reset.
+    if (item.completes_sync) handler_.OnComplete(item.peer);
+    return;
+  }
+  if (assume_valid_) {
+    const auto headers = timechain_.ReadHeaders();
+    item.assumed_valid = assume_valid_->Covers(headers, height, item.id.hash);
+  }
+  auto block = item.block;
+  const bool assumed_valid = item.assumed_valid;
+  {
+    std::lock_guard lock(submitted_mutex_);
+    const auto [it, inserted] = submitted_.try_emplace(height, std::move(item));
+    if (!inserted) {
+      // The height is already in the pipeline, e.g. a block received twice, so this copy is dropped.
+      LogWarn() << "Ignoring duplicate block at height " << height << ".";
+      it->second.completes_sync |= item.completes_sync;
+      pipeline_slots_->release();
+      return;
+    }
+  }
+  pipeline_->Submit(std::move(block), height, assumed_valid);
+}
+
+inline void BlockSync::OnValidated(int height, consensus::Result result) {
+  std::optional<Item> item;
+  {
+    std::lock_guard lock(submitted_mutex_);
+    const auto it = submitted_.find(height);
+    if (it == submitted_.end()) return;
+    item = std::move(it->second);
+    submitted_.erase(it);
+    // Blocks retiring after a failure were validated against state that includes the failed block.
+    if (failure_ && height > failure_->item.id.height) item.reset();
+    else if (!result) failure_ = Failure{*item, result.Error()};
+  }
+  pipeline_slots_->release();
+  if (!item || !result) return;  // Failures are handled on the sync thread.
+
+  NotifyValidated(height);
+  LogDebug() << "Block height " << height << " validated, " << item->block->SizeBytes() << " bytes.";
+  validation_.Set(item->id, item->assumed_valid ? BlockValidationStatus::AssumedValid
+                                                : BlockValidationStatus::Validated);
+  if (item->completes_sync) handler_.OnComplete(item->peer);
+}
+
+inline void BlockSync::NotifyValidated(int height) {
+  util::NotifyMetric("sync/blocks", {{"blocks_validated", height + 1}});
+  const auto stats = crypto::secp256k1::SignatureCache::Global().GetStats();
+  util::NotifyMetric("sync/signature_cache", {{"lookups", int64_t(stats.lookups)},
+                                              {"hits", int64_t(stats.hits)},
+                                              {"hit_rate", stats.HitRate()}});
+}
+
+inline void BlockSync::HandleFailure() {
+  std::optional<Failure> failure;
+  {
+    std::lock_guard lock(submitted_mutex_);
+    failure = failure_;  // Left in place until the reset, so later retirements are still discarded.
+  }
+  if (!failure) return;
+  HandleError(failure->item, failure->error);
+  ResetPipeline(failure->item.id.height);
+}
+
+// The pipeline has already appended the failed block and possibly its successors to the database.
+// Rather than drain blocks that may be waiting on heights that will never arrive, the pipeline is
+// cancelled, the database rewound, and a fresh pipeline started at the failed height.
+inline void BlockSync::ResetPipeline(int height) {
+  pipeline_.reset();
+  int dropped = 0;
+  {
+    std::lock_guard lock(submitted_mutex_);
+    dropped = std::ssize(submitted_);
+    submitted_.clear();
+    failure_.reset();
+  }
+  pipeline_slots_->release(dropped);
+  db_->EraseSince(height);
+  pipeline_ = MakePipeline(height);
+}
+
 inline void BlockSync::HandleError(const Item& item, consensus::Error error) {
   const auto msg = std::format("Validation error code {}.", static_cast<int>(error));
 
@@ -5,11 +5,13 @@
 #pragma once
 
 #include <optional>
+#include <span>
 #include <thread>
 #include <variant>
 
 #include "hornetlib/consensus/rules/validate.h"
 #include "hornetlib/consensus/types.h"
+#include "hornetlib/consensus/validate_api.h"
 #include "hornetlib/data/timechain.h"
 #include "hornetlib/model/header_context.h"
 #include "hornetlib/protocol/block_header.h"
@@ -17,6 +19,7 @@
 #include "hornetlib/protocol/message/getheaders.h"
 #include "hornetlib/protocol/message/headers.h"
 #include "hornetlib/util/notify.h"
+#include "hornetlib/util/parallel_chunks.h"
 #include "hornetlib/util/thread_safe_queue.h"
 #include "hornetnodelib/net/peer.h"
 #include "hornetnodelib/sync/sync_handler.h"
@@ -54,9 +57,18 @@ class HeaderSync {
     Batch batch;
   };
 
+  // The hashes of a batch of headers, and the results of the rules that need no ancestry.
+  struct CheckedBatch {
+    std::vector<protocol::Hash> hashes;
+    std::vector<consensus::Result> results;
+  };
+
   // Validates queued headers, and adds them to the headers timechain.
   void Process();
 
+  // Hashes a batch and validates the rules that need no ancestry, in parallel and without locks.
+  static CheckedBatch CheckBatch(std::span<const protocol::BlockHeader> batch);
+
   // Requests more headers via the callback supplied in RegisterPeer.
   bool RequestHeadersFrom(net::WeakPeer id);
 
@@ -137,6 +149,10 @@ inline void HeaderSync::Process() {
       // As soon as we pop from the queue, request new headers if appropriate.
       RequestHeadersFrom(item->weak_peer);
 
+      // Hashes the batch and runs the rules that need no ancestry before taking the lock, so that
+      // readers of the timechain are blocked only while the contextual rules run.
+      const CheckedBatch checked = CheckBatch(item->batch);
+
       // Locates the parent of this header in the timechain.
       auto headers = timechain_.WriteHeaders();
       data::HeaderTimechain::ConstIterator parent = headers->Search(item->batch[0].GetPreviousBlockHash());
@@ -149,13 +165,15 @@ inline void HeaderSync::Process() {
       const std::unique_ptr<data::HeaderTimechain::ValidationView> view =
           headers->GetValidationView(parent);
 
-      for (const auto& header : item->batch) {
+      for (int i = 0; i < std::ssize(item->batch); ++i) {
+        const auto& header = item->batch[i];
         const int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
                                 std::chrono::system_clock::now().time_since_epoch())
                                 .count();
 
-        // Validates the header against consensus rules.
-        const auto validated = consensus::ValidateHeader(header, parent->data, *view, now);
+        // Validates the header against the remaining consensus rules.
+        const auto validated = checked.results[i].AndThen(
+            [&] { return consensus::ValidateHeaderContextual(header, parent->data, *view, now); });
 
         // Handles consensus failures, breaking out of this batch.
         if (!validated) {
@@ -165,7 +183,7 @@ inline void HeaderSync::Process() {
         }
 
         // Adds the validated header to the headers timechain.
-        view->SetTip(parent = timechain_.AddHeader(parent, parent->Extend(header)));
+        view->SetTip(parent = timechain_.AddHeader(parent, parent->Extend(header, checked.hashes[i])));
       }
     }
 
@@ -179,6 +197,24 @@ inline void HeaderSync::Process() {
   }
 }
 
+inline HeaderSync::CheckedBatch HeaderSync::CheckBatch(std::span<const protocol::BlockHeader> batch) {
+  constexpr int kMinChunk = 256;
+  const int count = std::ssize(batch);
+  CheckedBatch checked{std::vector<protocol::Hash>(count), std::vector<consensus::Result>(count)};
+  // One pass hashes and checks each header. A chunk re-hashes the header before it, rather than
+  // waiting for the neighbouring chunk. The first header is linked to the parent it names, which is
+  // then located in the timechain.
+  util::ParallelChunks(count, kMinChunk, [&](int, int begin, int end) {
+    protocol::Hash parent_hash = begin > 0 ? batch[begin - 1].ComputeHash() : batch[0].GetPreviousBlockHash();
+    for (int i = begin; i < end; ++i) {
+      checked.hashes[i] = batch[i].ComputeHash();
+      checked.results[i] = consensus::ValidateHeaderStructure(batch[i], checked.hashes[i], parent_hash);
+      parent_hash = checked.hashes[i];
+    }
+  });
+  return checked;
+}
+
 // Calls error handler and deletes peer's other queued items.
 inline void HeaderSync::HandleError(const Item& item, const protocol::BlockHeader&,
                                     consensus::Error error) {
@@ -9,6 +9,7 @@
 
 #include "hornetlib/data/sidecar_binding.h"
 #include "hornetlib/data/timechain.h"
+#include "hornetlib/data/utxo/database.h"
 #include "hornetlib/protocol/constants.h"
 #include "hornetlib/protocol/message/getheaders.h"
 #include "hornetlib/protocol/message/headers.h"
@@ -64,6 +65,17 @@ class SyncManager : public dispatch::EventHandler {
     block_sync_.OnBlock(GetSync(), block);
   }
 
+  // Enables full spend validation of downloaded blocks against the given UTXO database, using a
+  // validation pipeline that processes up to pipeline_depth blocks concurrently.
+  void EnableSpendValidation(data::utxo::Database& db, int pipeline_depth) {
+    block_sync_.EnableSpendValidation(db, pipeline_depth);
+  }
+
+  // Skips spend and script validation for the ancestors of the given block. See BlockSync.
+  void SetAssumeValid(const protocol::Hash& hash) {
+    block_sync_.SetAssumeValid(hash);
+  }
+
   const HeaderSync& GetHeaderSync() const {
     return header_sync_;
   }
@@ -3,9 +3,12 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <queue>
+#include <set>
 #include <thread>
 #include <vector>
 
@@ -16,7 +19,7 @@
 #include "hornetlib/data/utxo/joiner.h"
 #include "hornetlib/data/utxo/spend_pipeline.h"
 #include "hornetlib/protocol/block.h"
-#include "hornetlib/util/thread_safe_queue.h"
+#include "hornetlib/util/log.h"
 #include "hornetlib/util/throw.h"
 #include "hornetlib/util/timeout.h"
 
@@ -30,29 +33,51 @@ class ValidationPipeline {
   // Constructs the validation pipeline.
   // pipeline_depth: The number of blocks that can be processed concurrently.
   // This determines the number of threads in both the validation and spend pipelines.
+  // start_height: The first height to be submitted and retired, e.g. when resuming after EraseSince.
   ValidationPipeline(data::Timechain& timechain, data::utxo::Database& db,
-                     CompleteCallback callback, int pipeline_depth = 8)
-      : timechain_(timechain), on_complete_(std::move(callback)), spend_pipeline_(db, pipeline_depth) {
+                     CompleteCallback callback, int pipeline_depth = 8, int start_height = 1)
+      : timechain_(timechain), on_complete_(std::move(callback)), spend_pipeline_(db, pipeline_depth),
+        next_complete_height_(start_height) {
     for (int i = 0; i < pipeline_depth; ++i) {
       workers_.emplace_back([this] { WorkerLoop(); });
     }
   }
 
   ~ValidationPipeline() {
-    queue_.Stop();
+    {
+      std::lock_guard lock{ready_mutex_};
+      stopped_ = true;
+    }
+    ready_cv_.notify_all();
     spend_pipeline_.Stop();
     for (auto& t : workers_)
       if (t.joinable()) t.join();
   }
 
-  // Submits a block for validation. Can be out of height order.
-  void Submit(std::shared_ptr<const protocol::Block> block, int height) {
+  // Submits a block for validation. Can be out of height order. A block assumed valid skips the
+  // validation of its spends and scripts, and so the fetch of its spent outputs, but is otherwise
+  // validated and accounted as any other. Returns false, and ignores the block, if a block at the
+  // same height is already in flight, since its spends would otherwise be appended twice.
+  bool Submit(std::shared_ptr<const protocol::Block> block, int height, bool assumed_valid = false) {
     if (height == 0)
       util::ThrowInvalidArgument(
           "ValidationPipeline::Submit: Genesis block should not be submitted.");
+    {
+      std::lock_guard lock{ready_mutex_};
+      if (!in_flight_.insert(height).second) {
+        LogWarn() << "ValidationPipeline::Submit: Ignoring duplicate block at height " << height << ".";
+        return false;
+      }
+    }
     ++active_count_;
-    auto joiner = spend_pipeline_.Add(block, height);
-    queue_.Push({height, std::move(block), std::move(joiner)});
+    auto joiner = spend_pipeline_.Add(block, height, !assumed_valid);
+    {
+      std::lock_guard lock{ready_mutex_};
+      pending_.emplace(height, Job{height, std::move(block), joiner, assumed_valid});
+    }
+    // The job becomes ready for validation once its spent outputs have been fetched.
+    joiner->OnFetchReleased([this, height] { MakeReady(height); });
+    return true;
   }
 
   bool Wait(const util::Timeout& timeout) {
@@ -71,6 +96,10 @@ class ValidationPipeline {
     int height;
     std::shared_ptr<const protocol::Block> block;
     std::shared_ptr<data::utxo::SpendJoiner> joiner;
+    bool assumed_valid;
+
+    // Lesser priority is given to the greater height.
+    bool operator<(const Job& rhs) const { return height > rhs.height; }
   };
 
   struct JobResult {
@@ -82,17 +111,31 @@ class ValidationPipeline {
     bool operator<(const JobResult& rhs) const { return height > rhs.height; }
   };
 
+  // Moves a pending job to the ready queue. Called by its joiner, on a spend pipeline thread.
+  void MakeReady(int height) {
+    {
+      std::lock_guard lock{ready_mutex_};
+      auto node = pending_.extract(height);
+      Assert(!node.empty());
+      ready_.push(std::move(node.mapped()));
+    }
+    ready_cv_.notify_one();
+  }
+
+  // Waits for the lowest ready job, or returns nullopt when the pipeline is stopped.
+  std::optional<Job> WaitReady() {
+    std::unique_lock lock{ready_mutex_};
+    ready_cv_.wait(lock, [this] { return stopped_ || !ready_.empty(); });
+    if (stopped_) return std::nullopt;
+    Job job = ready_.top();
+    ready_.pop();
+    return job;
+  }
+
   void WorkerLoop() {
     std::optional<Job> job;
-    while ((job = queue_.WaitPop())) {
+    while ((job = WaitReady())) {
       try {
-        // If this validation job doesn't yet have all its dependencies ready, and there is other
-        // work to be done, defer this job until later in preference of a more productive work item.
-        if (!job->joiner->IsJoinReady() && !queue_.Empty()) {
-          queue_.Push(std::move(*job));
-          continue;
-        }
-
         // Perform consensus validation for the current job, and store the result.
         const auto result = Validate(*job);
         {
@@ -118,6 +161,8 @@ class ValidationPipeline {
         headers->FindStable(job.height - 1, block.Header().GetPreviousBlockHash());
     const auto ancestry_view = headers->GetValidationView(parent_it);
     const data::utxo::DatabaseView utxo{job.joiner};
+    if (job.assumed_valid)
+      return consensus::ValidateBlockAssumedValid(block, *parent_it, *ancestry_view, GetCurrentTime(), utxo);
     return consensus::ValidateBlock(block, *parent_it, *ancestry_view, GetCurrentTime(), utxo);
   }
 
@@ -130,6 +175,10 @@ class ValidationPipeline {
          ++next_complete_height_) {
       const auto item = std::move(completed_.top());
       completed_.pop();
+      {
+        std::lock_guard ready_lock{ready_mutex_};
+        in_flight_.erase(item.height);
+      }
 
       lock.unlock();
       on_complete_(item.block, item.height, item.result);
@@ -152,11 +201,17 @@ class ValidationPipeline {
   CompleteCallback on_complete_;
   data::utxo::SpendPipeline spend_pipeline_;
 
-  util::ThreadSafeQueue<Job> queue_;
+  // Jobs wait in pending_ until their spends are fetched, then in ready_ until a worker takes them.
+  std::mutex ready_mutex_;
+  std::condition_variable ready_cv_;
+  std::set<int> in_flight_;  // The heights submitted and not yet retired.
+  std::map<int, Job> pending_;
+  std::priority_queue<Job> ready_;
+  bool stopped_ = false;
   std::vector<std::thread> workers_;
 
   std::mutex retire_mutex_;
-  int next_complete_height_ = 1;  // Genesis is never validated.
+  int next_complete_height_;  // Genesis is never validated.
   std::priority_queue<JobResult, std::vector<JobResult>> completed_;
 
   std::atomic<int> active_count_ = 0;
@@ -4,6 +4,7 @@
 // For licensing or usage inquiries, contact: ask@hornetnode.com.
 #include "hornetlib/consensus/validate_api.h"
 
+#include "hornetlib/consensus/rule.h"
 #include "hornetlib/consensus/types.h"
 #include "hornetlib/protocol/block.h"
 #include "hornetlib/protocol/hash.h"
@@ -22,6 +23,36 @@ using hornet::protocol::OutPoint;
 using hornet::protocol::Transaction;
 using test::RoundTrip;
 
+TEST(ValidatorTest, ValidateEachReturnsLowestFailure) {
+  // Split into eight chunks regardless of the host, with failures in several chunks.
+  constexpr int kMinChunk = 1'000;
+  constexpr int kMaxChunks = 8;
+  const auto fn = [](int i) -> Result {
+    if (i == 7'500) return Error::Transaction_EmptyInputs;
+    if (i == 5'100 || i == 6'000) return Error::Transaction_DuplicatedInput;
+    if (i == 2'345) return Error::Transaction_EmptyOutputs;
+    return {};
+  };
+  EXPECT_EQ(ValidateEach(8'000, fn, kMinChunk, kMaxChunks), Error::Transaction_EmptyOutputs);
+  EXPECT_EQ(ValidateEach(8'000, [&](int i) { return i == 2'345 ? Result{} : fn(i); }, kMinChunk, kMaxChunks),
+            Error::Transaction_DuplicatedInput);
+  EXPECT_EQ(ValidateEach(2'000, fn, kMinChunk, kMaxChunks), Result{});
+  EXPECT_EQ(ValidateEach(0, fn, kMinChunk, kMaxChunks), Result{});
+  EXPECT_EQ(ValidateEach(8'000, fn), Error::Transaction_EmptyOutputs);
+}
+
+TEST(ValidatorTest, ValidateHeaderStructureChecksLinkAndProofOfWork) {
+  BlockHeader header = Block::Genesis().Header();
+  const Hash parent_hash = header.GetPreviousBlockHash();
+  EXPECT_EQ(ValidateHeaderStructure(header, header.ComputeHash(), parent_hash), Result{});
+  EXPECT_EQ(ValidateHeaderStructure(header, header.ComputeHash(), header.ComputeHash()),
+            Error::Header_ParentNotFound);
+
+  header.SetNonce(header.GetNonce() + 1);
+  EXPECT_EQ(ValidateHeaderStructure(header, header.ComputeHash(), parent_hash),
+            Error::Header_InvalidProofOfWork);
+}
+
 TEST(ValidatorTest, DetectsInvalidMerkleRoot) {
   Block block;
 
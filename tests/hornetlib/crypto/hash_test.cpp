@@ -7,6 +7,7 @@
 #include <array>
 #include <cstring>
 #include <iostream>
+#include <string_view>
 
 #include "hornetlib/crypto/sha256.h"
 #include "hornetlib/util/big_uint.h"
@@ -33,6 +34,25 @@ TEST(HashTest, DoubleSha256HashOfKnownString) {
   EXPECT_EQ(oss.str(), expected);
 }
 
+TEST(HashTest, Ripemd160OfKnownStrings) {
+  const auto hash = [](std::string_view input) {
+    return RIPEMD160::Hash({reinterpret_cast<const uint8_t*>(input.data()), input.size()});
+  };
+  EXPECT_EQ(hash(""), "9c1185a5c5e9fc54612808977ee8f548b2258d31"_bytes);
+  EXPECT_EQ(hash("abc"), "8eb208f7e05d987a9b044a8e98c6b087f15a0bfc"_bytes);
+  EXPECT_EQ(hash("message digest"), "5d0689ef49d2fae572b881b123a85ffa21595f36"_bytes);
+  // Lengths that need a second padding block, and more than one message block.
+  EXPECT_EQ(hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+            "12a053384a9c0c88e405a06c27dcf49ada62eb2b"_bytes);
+  EXPECT_EQ(hash("12345678901234567890123456789012345678901234567890123456789012345678901234567890"),
+            "9b752e45573d4b39f4dbd3323cab82bf63326bfb"_bytes);
+}
+
+TEST(HashTest, Hash160OfGeneratorPublicKey) {
+  const auto public_key = "0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"_bytes;
+  EXPECT_EQ(Hash160(public_key), "751e76e8199196d454941c45d1b3a323f1433bd6"_bytes);
+}
+
 TEST(HashTest, ValidHexDigits) {
   using namespace hornet::util;
   EXPECT_EQ(HexValue<'0'>(), 0);
@@ -0,0 +1,61 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetlib/crypto/muhash.h"
+
+#include <array>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+namespace hornet::crypto {
+namespace {
+
+std::array<uint8_t, 32> Element(uint8_t i) {
+  return {i};
+}
+
+MuHash3072 FromInt(uint8_t i) {
+  return MuHash3072{}.Insert(Element(i));
+}
+
+// Bitcoin Core's crypto_tests vector, whose uint256 hex is displayed byte-reversed.
+TEST(MuHashTest, MatchesReferenceVector) {
+  MuHash3072 acc = FromInt(0);
+  acc *= FromInt(1);
+  acc /= FromInt(2);
+  const bytes32_t expected = {0x63, 0x58, 0x7d, 0x60, 0x2a, 0x00, 0x10, 0x5f, 0x62, 0xd2, 0x68,
+                              0x36, 0x10, 0xff, 0xfc, 0x82, 0x34, 0x0d, 0xe4, 0x46, 0x66, 0x4a,
+                              0x02, 0xda, 0x2a, 0xd3, 0xcb, 0x00, 0xb1, 0x12, 0xd3, 0x10};
+  EXPECT_EQ(acc.Finalize(), expected);
+
+  MuHash3072 acc2 = FromInt(0);
+  acc2.Insert(Element(1)).Remove(Element(2));
+  EXPECT_EQ(acc2.Finalize(), expected);
+}
+
+TEST(MuHashTest, OrderIndependentAndInvertible) {
+  MuHash3072 forward, backward;
+  for (int i = 0; i < 8; ++i) forward.Insert(Element(i));
+  for (int i = 7; i >= 0; --i) backward.Insert(Element(i));
+  EXPECT_EQ(forward.Finalize(), backward.Finalize());
+
+  forward.Insert(Element(100)).Remove(Element(3));
+  backward.Remove(Element(3)).Insert(Element(100));
+  EXPECT_EQ(forward.Finalize(), backward.Finalize());
+
+  MuHash3072 empty;
+  forward /= forward;
+  EXPECT_EQ(forward.Finalize(), empty.Finalize());
+}
+
+TEST(MuHashTest, InverseOfGroupElement) {
+  Num3072 x = MuHash3072::ToNum3072(Element(42));
+  Num3072 product = x;
+  product.Multiply(x.GetInverse());
+  EXPECT_EQ(product.ToBytes(), Num3072{}.ToBytes());
+}
+
+}  // namespace
+}  // namespace hornet::crypto
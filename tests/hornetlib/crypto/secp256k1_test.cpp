@@ -0,0 +1,262 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hornetlib/crypto/secp256k1/ecdsa.h"
+#include "hornetlib/crypto/secp256k1/schnorr.h"
+#include "hornetlib/util/hex.h"
+
+namespace hornet::crypto::secp256k1 {
+namespace {
+
+struct SchnorrVector {
+  std::array<uint8_t, 32> public_key;
+  std::array<uint8_t, 32> message;
+  std::array<uint8_t, 64> signature;
+};
+
+// BIP340 test vector 0, followed by signatures made with the BIP340 reference code.
+const SchnorrVector kSchnorrVectors[] = {
+    {"F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9"_bytes,
+     "0000000000000000000000000000000000000000000000000000000000000000"_bytes,
+     "E907831F80848D1069A5371B402410364BDF1C5F8307B0084C55F1CE2DCA8215"
+     "25F66A4A85EA8B71E482A74F382D2CE5EBEEE8FDB2172F477DF4900D310536C0"_bytes},
+    {"AD89A1EC08A7DFB1EC15C2CB1687C66ABA5DD14FDAE91B1C50DE18EBAA27E06D"_bytes,
+     "D24FA1FF5FA33C2718937FFA6E1B3A81B2DBACABD4EE6496ECC96B1EDB2E76D7"_bytes,
+     "059D565085AF677A56AE7FFF218C25CE5A8F15496089F10FB5857DA619B6F6EA"
+     "8160BBE93269FA0C83360C913DBA9F694C4EBEEE7C5E0942CB88399E4BA53AAB"_bytes},
+    {"C61428BD885E7466D5FCEBCFBC712114C432B609FEEE038335BA5A5206B67296"_bytes,
+     "FB1064569D97535CC0307EEC283DAA067001FB0445DBECB8FE9D384CA2D1F894"_bytes,
+     "2E4B9165C420250F995F25AAB23732A58E0575CB951F1311A8AFD5E2E94F5E14"
+     "6DD214E2E21DB6E08240ED9C7CE998E659309B6D4495EA00CD0F18D96545B80B"_bytes},
+    {"5A19D416F27F214FE4F3E8B14CD5836188F6D3AFA41BFB5435333B565A48B658"_bytes,
+     "008BB2C25B1AEA80608B8C3BAE84C071A028CC7145AFAA682006559670ABCAAF"_bytes,
+     "B2B1F5ACBA02F2F522739A041F39F4570839AA8004DAD7FCDEE952DC2FE65410"
+     "A0F34B4361E3BC2FA260B617351B2CF72C9200102E84851E814D8D14599FEC6C"_bytes},
+    {"822D2F9D3AB0C328EABB930F562B2013B8DC6ED1506B0A11F644DA4D411E0047"_bytes,
+     "4011DB1A958118A4A1F2AA90BDA2E8D367E17B76A9A53097D38E742A412A00E8"_bytes,
+     "1A691AFD718129F9CF426DD83042D403E041D6535CBC6E2D8CA21699676D8A8E"
+     "B0AAB07635C03A88F4A1FEAF4D571D2AFAE3EC49746E7984D72E761E19B85B5D"_bytes},
+    {"F1DDA7D64A562C9508EF7B1DCE7373667EF9291712F950940F7A5A31D6C2D00E"_bytes,
+     "C2BF020B72A08591E6A8142E04A6089BE4FEA8A3BA78A133B2ECC6D693612C4A"_bytes,
+     "56C48387395EB63F27A8B46D7011F459BB7B701A8A01776D2B167B19767C2ACA"
+     "BD092EAA4B7095E7A9ABDDEDDA6D16FF21F47CD8BD6615C051F3B52E71A2DBA9"_bytes},
+    {"C7276CE1F81436D3117A9763BCC464F7D09A3FD062B8CD9EAEEB13D7502CC8BE"_bytes,
+     "61961F934CFE30C1FC03893D7806806E187ACE89C37E7BD48AF2B3AC6603456C"_bytes,
+     "E46E916316849D64B6283630B81FDDBB12AB9CAE2478BFC91A90FDEB5861E8FA"
+     "0754330E68E1B129E3BF150F48DF582059C0A85D9D467F4547FF3B39E3F7AF23"_bytes},
+    {"2277FB396B1FCB4568EFF81AB68B6DFB5A9136059928093390D34FA34C1A1F2E"_bytes,
+     "6B44DC2D32C59A83266AC2277FB9AD70D94F9D8222C699D139347DA3F25AFC88"_bytes,
+     "D28FF89DD38811C076E7394765F84407AF6FB17C667B17BD18450670449F55E6"
+     "7DA56EE2E5D5BF427C2C3FFBFCAE77ABFDCF0B0DB48899651C48E0EE7C38AD47"_bytes},
+};
+
+template <size_t N>
+std::vector<uint8_t> Bytes(const std::array<uint8_t, N>& bytes) {
+  return {bytes.begin(), bytes.end()};
+}
+
+AffinePoint Point(const std::array<uint8_t, 32>& x, const std::array<uint8_t, 32>& y) {
+  return {*FieldElement::FromBytes(x), *FieldElement::FromBytes(y)};
+}
+
+TEST(Secp256k1Test, FieldInverseAndSqrt) {
+  const FieldElement a = AffinePoint::Generator().x;
+  EXPECT_EQ(a * a.Inverse(), FieldElement{1});
+  const auto root = a.Square().Sqrt();
+  ASSERT_TRUE(root);
+  EXPECT_TRUE(*root == a || *root == a.Negate());
+
+  std::array<FieldElement, 3> values = {a, a.Square(), FieldElement{7}};
+  FieldElement::InverseAll(values);
+  EXPECT_EQ(values[0], a.Inverse());
+  EXPECT_EQ(values[1], a.Square().Inverse());
+  EXPECT_EQ(values[2] * FieldElement{7}, FieldElement{1});
+
+  // p itself is rejected, and p - 1 = -1 is not a square since p = 3 mod 4.
+  EXPECT_FALSE(FieldElement::FromBytes(
+      "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F"_bytes));
+  EXPECT_FALSE(FieldElement{1}.Negate().Sqrt());
+}
+
+TEST(Secp256k1Test, ScalarSplitRecombines) {
+  const Scalar k = Scalar::FromBytes(
+      "AA5E28D6A97A2479A65527F7290311A3624D4CC0FA1578598EE3C2613BF99522"_bytes);
+  const auto [k1, k2] = Scalar::SplitLambda(k);
+  // Either each half or its negation fits in 128 bits.
+  for (const Scalar& half : {k1, k2}) {
+    const auto bytes = (half.IsHigh() ? half.Negate() : half).ToBytes();
+    EXPECT_TRUE(std::all_of(bytes.begin(), bytes.begin() + 16, [](uint8_t b) { return b == 0; }));
+  }
+  // k1 * G + k2 * (lambda * G) == k * G.
+  const AffinePoint lambda_g = AffinePoint::Generator().MulLambda();
+  const AffinePoint expected = MultiplyAdd(k, {}, {}).ToAffine();
+  const AffinePoint actual = MultiplyAdd(k1, {&lambda_g, 1}, {&k2, 1}).ToAffine();
+  EXPECT_EQ(actual.x, expected.x);
+  EXPECT_EQ(actual.y, expected.y);
+}
+
+TEST(Secp256k1Test, MultiplyMatchesReference) {
+  const struct {
+    std::array<uint8_t, 32> k, x, y;
+  } kCases[] = {
+      {"0000000000000000000000000000000000000000000000000000000000000002"_bytes,
+       "C6047F9441ED7D6D3045406E95C07CD85C778E4B8CEF3CA7ABAC09B95C709EE5"_bytes,
+       "1AE168FEA63DC339A3C58419466CEAEEF7F632653266D0E1236431A950CFE52A"_bytes},
+      {"AA5E28D6A97A2479A65527F7290311A3624D4CC0FA1578598EE3C2613BF99522"_bytes,
+       "34F9460F0E4F08393D192B3C5133A6BA099AA0AD9FD54EBCCFACDFA239FF49C6"_bytes,
+       "0B71EA9BD730FD8923F6D25A7A91E7DD7728A960686CB5A901BB419E0F2CA232"_bytes},
+      {"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364140"_bytes,
+       "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798"_bytes,
+       "B7C52588D95C3B9AA25B0403F1EEF75702E84BB7597AABE663B82F6F04EF2777"_bytes},
+  };
+  const AffinePoint generator = AffinePoint::Generator();
+  for (const auto& c : kCases) {
+    const Scalar k = Scalar::FromBytes(c.k);
+    const AffinePoint expected = Point(c.x, c.y);
+    // Through the generator tables, and through the per-point tables.
+    for (const AffinePoint& actual : {MultiplyAdd(k, {}, {}).ToAffine(),
+                                      MultiplyAdd(Scalar{}, {&generator, 1}, {&k, 1}).ToAffine()}) {
+      EXPECT_TRUE(actual.IsOnCurve());
+      EXPECT_EQ(actual.x, expected.x);
+      EXPECT_EQ(actual.y, expected.y);
+    }
+  }
+  // k * G + (n - k) * G is the point at infinity.
+  const Scalar k = Scalar::FromBytes(kCases[1].k);
+  const Scalar minus_k = k.Negate();
+  EXPECT_TRUE(MultiplyAdd(k, {&generator, 1}, {&minus_k, 1}).IsInfinity());
+}
+
+TEST(Secp256k1Test, ParsePublicKey) {
+  const auto compressed =
+      "022EDB326D11431A69E1CFE4437B3F0ACC0F383B0AE8C0FE9A749DE07A442EA49F"_bytes;
+  const auto point = ParsePublicKey(compressed);
+  ASSERT_TRUE(point);
+  EXPECT_TRUE(point->IsOnCurve());
+  EXPECT_FALSE(point->y.IsOdd());
+
+  auto odd = compressed;
+  odd[0] = 0x03;
+  EXPECT_EQ(ParsePublicKey(odd)->y, point->y.Negate());
+
+  auto bad_prefix = compressed;
+  bad_prefix[0] = 0x05;
+  EXPECT_FALSE(ParsePublicKey(bad_prefix));
+  EXPECT_FALSE(ParsePublicKey(std::span{compressed}.first(32)));
+}
+
+TEST(Secp256k1Test, ParseDerSignature) {
+  // Strict DER: no negative or padded integers, and exact lengths.
+  EXPECT_TRUE(ParseDerSignature("3006020101020101"_bytes));
+  EXPECT_FALSE(ParseDerSignature("3006020181020101"_bytes));
+  EXPECT_FALSE(ParseDerSignature("300702020001020101"_bytes));
+  EXPECT_FALSE(ParseDerSignature("3007020101020101"_bytes));
+  EXPECT_FALSE(ParseDerSignature("300602010102010100"_bytes));
+  EXPECT_FALSE(ParseDerSignature("3106020101020101"_bytes));
+}
+
+TEST(Secp256k1Test, VerifyEcdsa) {
+  const struct {
+    std::vector<uint8_t> public_key;
+    std::array<uint8_t, 32> digest;
+    std::vector<uint8_t> der;
+  } kVectors[] = {
+      {Bytes("022EDB326D11431A69E1CFE4437B3F0ACC0F383B0AE8C0FE9A749DE07A442EA49F"_bytes),
+       "6E340B9CFFB37A989CA544E6BB780A2C78901D3FB33738768511A30617AFA01D"_bytes,
+       Bytes("3045022100E4896BBB94A5DF1E333636F72792945F2847DCA1E679AB5987126D4F0D94FC56"
+                      "022023A3E4496E333B19CAF879CFA886E9D6F3F653948ED29DB747A6F53439F1AD07"_bytes)},
+      // An uncompressed key, and a high value of s.
+      {Bytes("044447046A144DFE53AA1C8FFF42D66F31EC94389596EF44A6AFD32165C4BAD495"
+                      "107800F266528E048D09EE8831D60CA5D23E8E6CBA1F013DEB6370B354CE541E"_bytes),
+       "4BF5122F344554C53BDE2EBB8CD2B7E3D1600AD631C385A5D7CCE23C7785459A"_bytes,
+       Bytes("3045022042D9A928A4F852527C3C1881FB9B962AC4932E209C1F87AD7E8248090024EAAC"
+                      "022100C42D4D4E7C75B0B56659325463E5F50DE1C7266DFFCB5FB32B3D1721DDAE4199"_bytes)},
+      {Bytes("03A6DEA7D6FFFFA3F63E2D4E94DA33F00EFC0258B201004C2B0696AB48D724F7DC"_bytes),
+       "DBC1B4C900FFE48D575B5DA5C638040125F65DB0FE3E24494B76EA986457D986"_bytes,
+       Bytes("30460221009390C328188AC70FBA4FC4E8077F6C63372CD84574612197DF951D0F69460AF4"
+                      "022100872AE93DDD26C8BB9279AFD6B51975FD7DB5BE8225090FA6FF163899ADB89826"_bytes)},
+      {Bytes("041668040359F1EB9F30B890391F9BEF5C2565B897E84CEA3CD045E942603DA939"
+                      "8224C45AA9CC3B51C89AF70F23EC053A674BF7FF1026D3A7D8C423D24050DCD3"_bytes),
+       "084FED08B978AF4D7D196A7446A86B58009E636B611DB16211B65A9AADFF29C5"_bytes,
+       Bytes("3045022056B358ABBA024FFF4FC1D37DCB123833E57F9BD30EC03B8735E6DE4EBBA5EDB9"
+                      "022100ACE4DEA5E44B840EF0F7C6F4F86C38027ADEB1F1563FEBAC2FE27DDC7F9F9AAC"_bytes)},
+  };
+  for (const auto& v : kVectors) {
+    EXPECT_TRUE(VerifyEcdsa(v.public_key, v.digest, v.der));
+
+    auto digest = v.digest;
+    digest[31] ^= 1;
+    EXPECT_FALSE(VerifyEcdsa(v.public_key, digest, v.der));
+
+    auto der = v.der;
+    der.back() ^= 1;
+    EXPECT_FALSE(VerifyEcdsa(v.public_key, v.digest, der));
+  }
+  // Another key's signature.
+  EXPECT_FALSE(VerifyEcdsa(kVectors[0].public_key, kVectors[1].digest, kVectors[1].der));
+}
+
+TEST(Secp256k1Test, VerifySchnorr) {
+  for (const SchnorrVector& v : kSchnorrVectors) {
+    EXPECT_TRUE(VerifySchnorr(v.public_key, v.message, v.signature));
+
+    auto message = v.message;
+    message[0] ^= 1;
+    EXPECT_FALSE(VerifySchnorr(v.public_key, message, v.signature));
+
+    auto signature = v.signature;
+    signature[63] ^= 1;
+    EXPECT_FALSE(VerifySchnorr(v.public_key, v.message, signature));
+
+    // s = n is out of range.
+    const auto order = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141"_bytes;
+    std::copy(order.begin(), order.end(), signature.begin() + 32);
+    EXPECT_FALSE(VerifySchnorr(v.public_key, v.message, signature));
+  }
+  // BIP340 test vector 5: the public key is not on the curve.
+  const auto& v = kSchnorrVectors[0];
+  EXPECT_FALSE(VerifySchnorr(
+      "EEFDEA4CDB677750A420FEE807EACF21EB9898AE79B9768766E4FAA04A2D4A34"_bytes, v.message,
+      v.signature));
+}
+
+TEST(Secp256k1Test, SchnorrBatch) {
+  SchnorrBatch batch;
+  EXPECT_TRUE(batch.Verify());
+
+  // Enough signatures to span several chunks.
+  constexpr int kRepeats = 40;
+  for (int i = 0; i < kRepeats; ++i)
+    for (const SchnorrVector& v : kSchnorrVectors)
+      EXPECT_TRUE(batch.Add(v.public_key, v.message, v.signature));
+  EXPECT_EQ(batch.Size(), kRepeats * std::size(kSchnorrVectors));
+  EXPECT_TRUE(batch.Verify());
+
+  // One bad signature fails the whole batch.
+  auto signature = kSchnorrVectors[3].signature;
+  signature[40] ^= 0x10;
+  EXPECT_TRUE(batch.Add(kSchnorrVectors[3].public_key, kSchnorrVectors[3].message, signature));
+  EXPECT_FALSE(batch.Verify());
+
+  // As does a signature that does not parse, here because R is not on the curve.
+  batch.Clear();
+  EXPECT_TRUE(batch.Add(kSchnorrVectors[0].public_key, kSchnorrVectors[0].message,
+                        kSchnorrVectors[0].signature));
+  EXPECT_TRUE(batch.Verify());
+  signature = kSchnorrVectors[0].signature;
+  const auto off_curve = "EEFDEA4CDB677750A420FEE807EACF21EB9898AE79B9768766E4FAA04A2D4A34"_bytes;
+  std::copy(off_curve.begin(), off_curve.end(), signature.begin());
+  EXPECT_FALSE(batch.Add(kSchnorrVectors[0].public_key, kSchnorrVectors[0].message, signature));
+  EXPECT_FALSE(batch.Verify());
+}
+
+}  // namespace
+}  // namespace hornet::crypto::secp256k1
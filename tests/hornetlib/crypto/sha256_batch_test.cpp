@@ -0,0 +1,96 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetlib/crypto/sha256_batch.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hornetlib/crypto/hash.h"
+
+namespace hornet::crypto {
+namespace {
+
+using SHA256::BatchKernel;
+
+constexpr BatchKernel kKernels[] = {BatchKernel::Scalar, BatchKernel::Sse41, BatchKernel::Avx2,
+                                    BatchKernel::Avx512};
+
+std::vector<uint8_t> MakeMessages(int count, int stride) {
+  std::vector<uint8_t> messages(count * stride);
+  for (size_t i = 0; i < messages.size(); ++i) messages[i] = uint8_t(i * 131 + (i >> 7));
+  return messages;
+}
+
+bytes32_t ScalarDoubleHash(const uint8_t* message) {
+  return DoubleSha256(message, message + 64);
+}
+
+TEST(Sha256BatchTest, KnownDigestOfZeroMessage) {
+  // The double SHA-256 of 64 zero bytes, as hashed for a Merkle node with two zero children.
+  const std::vector<uint8_t> message(64);
+  for (const BatchKernel kernel : kKernels) {
+    if (!SHA256::IsSupported(kernel)) continue;
+    bytes32_t digest;
+    SHA256::DoubleHash64(message.data(), 64, 1, digest.data(), 32, kernel);
+    EXPECT_EQ(digest, ScalarDoubleHash(message.data()));
+  }
+  std::ostringstream oss;
+  oss << DoubleSha256(message);
+  EXPECT_EQ(oss.str(), "e2f61c3f71d1defd3fa999dfa36953755c690689799962b48bebd836974e8cf9");
+}
+
+TEST(Sha256BatchTest, MatchesScalarForEveryKernel) {
+  for (const BatchKernel kernel : kKernels) {
+    if (!SHA256::IsSupported(kernel)) continue;
+    // Covers counts that leave remainders for each narrower kernel, and a padded stride.
+    for (const int stride : {64, 80}) {
+      for (int count = 0; count <= 40; ++count) {
+        const auto messages = MakeMessages(count, stride);
+        std::vector<uint8_t> digests(count * 48);
+        SHA256::DoubleHash64(messages.data(), stride, count, digests.data(), 48, kernel);
+        for (int i = 0; i < count; ++i) {
+          const bytes32_t expected = ScalarDoubleHash(&messages[i * stride]);
+          EXPECT_TRUE(std::equal(expected.begin(), expected.end(), &digests[i * 48]))
+              << "kernel " << int(kernel) << ", stride " << stride << ", count " << count << ", i " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(Sha256BatchTest, HashesInPlace) {
+  for (const BatchKernel kernel : kKernels) {
+    if (!SHA256::IsSupported(kernel)) continue;
+    const int count = 37;
+    auto buffer = MakeMessages(count, 64);
+    const auto messages = buffer;
+    SHA256::DoubleHash64(buffer.data(), 64, count, buffer.data(), 32, kernel);
+    for (int i = 0; i < count; ++i) {
+      const bytes32_t expected = ScalarDoubleHash(&messages[i * 64]);
+      EXPECT_TRUE(std::equal(expected.begin(), expected.end(), &buffer[i * 32])) << int(kernel) << ", " << i;
+    }
+  }
+}
+
+TEST(Sha256BatchTest, Hash32MatchesScalarForEveryKernel) {
+  for (const BatchKernel kernel : kKernels) {
+    if (!SHA256::IsSupported(kernel)) continue;
+    for (int count = 0; count <= 40; ++count) {
+      auto buffer = MakeMessages(count, 32);
+      const auto messages = buffer;
+      SHA256::Hash32(buffer.data(), 32, count, buffer.data(), 32, kernel);
+      for (int i = 0; i < count; ++i) {
+        const bytes32_t expected = Sha256(&messages[i * 32], &messages[(i + 1) * 32]);
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), &buffer[i * 32]))
+            << "kernel " << int(kernel) << ", count " << count << ", i " << i;
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace hornet::crypto
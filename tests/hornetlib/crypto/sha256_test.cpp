@@ -0,0 +1,74 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetlib/crypto/sha256.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hornetlib/util/hex.h"
+
+namespace hornet::crypto {
+namespace {
+
+using SHA256::Kernel;
+
+constexpr Kernel kKernels[] = {Kernel::Scalar, Kernel::ShaNi, Kernel::ArmV8};
+
+std::span<const uint8_t> AsBytes(std::string_view s) {
+  return {reinterpret_cast<const uint8_t*>(s.data()), s.size()};
+}
+
+SHA256::hash256_t HashWith(Kernel kernel, std::span<const uint8_t> bytes) {
+  return SHA256::Context{kernel}.Update(bytes).Final();
+}
+
+TEST(Sha256Test, KnownVectorsForEveryKernel) {
+  const std::string million(1'000'000, 'a');
+  for (const Kernel kernel : kKernels) {
+    if (!SHA256::IsSupported(kernel)) continue;
+    EXPECT_EQ(HashWith(kernel, AsBytes("")),
+              "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"_bytes);
+    EXPECT_EQ(HashWith(kernel, AsBytes("abc")),
+              "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"_bytes);
+    EXPECT_EQ(HashWith(kernel, AsBytes("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")),
+              "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"_bytes);
+    EXPECT_EQ(HashWith(kernel, AsBytes(million)),
+              "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"_bytes);
+  }
+}
+
+TEST(Sha256Test, KernelsAgreeOnAllPaddingLengths) {
+  std::vector<uint8_t> bytes(300);
+  for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = uint8_t(i * 7 + 3);
+  for (size_t size = 0; size <= bytes.size(); ++size) {
+    const auto expected = HashWith(Kernel::Scalar, {bytes.data(), size});
+    EXPECT_EQ(SHA256::Hash({bytes.data(), size}), expected) << size;
+    for (const Kernel kernel : kKernels)
+      if (SHA256::IsSupported(kernel)) EXPECT_EQ(HashWith(kernel, {bytes.data(), size}), expected) << size;
+  }
+}
+
+TEST(Sha256Test, StreamsAcrossSplits) {
+  std::vector<uint8_t> bytes(200);
+  for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = uint8_t(i);
+  const auto expected = SHA256::Hash(bytes);
+  const std::span<const uint8_t> all{bytes};
+  SHA256::Context context;
+  for (size_t split = 0; split <= bytes.size(); ++split) {
+    context.Init();
+    EXPECT_EQ(context.Update(all.first(split)).Update(all.subspan(split)).Final(), expected) << split;
+  }
+  // Byte at a time.
+  context.Init();
+  for (const uint8_t byte : bytes) context.Update({&byte, 1});
+  EXPECT_EQ(context.Final(), expected);
+}
+
+}  // namespace
+}  // namespace hornet::crypto
@@ -0,0 +1,115 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetlib/crypto/secp256k1/signature_cache.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hornetlib/protocol/script/runtime/signature.h"
+#include "hornetlib/util/hex.h"
+
+namespace hornet::crypto::secp256k1 {
+namespace {
+
+using Scheme = SignatureCache::Scheme;
+
+SignatureCache::Key MakeKey(const SignatureCache& cache, int i, Scheme scheme = Scheme::Schnorr) {
+  std::array<uint8_t, 32> message = {};
+  for (int b = 0; b < 4; ++b) message[b] = static_cast<uint8_t>(i >> (8 * b));
+  const std::array<uint8_t, 32> public_key = {1};
+  const std::array<uint8_t, 64> signature = {2};
+  return cache.MakeKey(scheme, message, public_key, signature);
+}
+
+TEST(SignatureCacheTest, InsertThenContains) {
+  SignatureCache cache{1 << 16};
+  EXPECT_EQ(cache.SizeBytes(), size_t{1} << 16);
+  const auto key = MakeKey(cache, 7);
+  EXPECT_FALSE(cache.Contains(key));
+  cache.Insert(key);
+  EXPECT_TRUE(cache.Contains(key));
+  EXPECT_FALSE(cache.Contains(MakeKey(cache, 8)));
+  EXPECT_FALSE(cache.Contains(MakeKey(cache, 7, Scheme::Ecdsa)));
+
+  const auto stats = cache.GetStats();
+  EXPECT_EQ(stats.lookups, 4);
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.inserts, 1);
+  EXPECT_DOUBLE_EQ(stats.HitRate(), 0.25);
+
+  // Each cache has its own salt.
+  SignatureCache other{1 << 16};
+  EXPECT_NE(MakeKey(other, 7).lo, key.lo);
+}
+
+TEST(SignatureCacheTest, FillsAndEvicts) {
+  constexpr int kSlots = 1024;
+  SignatureCache cache{kSlots * 16};
+  for (int i = 0; i < kSlots / 2; ++i) cache.Insert(MakeKey(cache, i));
+  // At half load, cuckoo displacement keeps every entry.
+  for (int i = 0; i < kSlots / 2; ++i) EXPECT_TRUE(cache.Contains(MakeKey(cache, i)));
+
+  // Overfilling evicts entries, but never reports one that was not inserted.
+  for (int i = kSlots / 2; i < 4 * kSlots; ++i) cache.Insert(MakeKey(cache, i));
+  int present = 0;
+  for (int i = 0; i < 4 * kSlots; ++i) present += cache.Contains(MakeKey(cache, i));
+  EXPECT_LE(present, kSlots);
+  EXPECT_GT(present, kSlots / 2);
+  for (int i = 4 * kSlots; i < 8 * kSlots; ++i) EXPECT_FALSE(cache.Contains(MakeKey(cache, i)));
+}
+
+TEST(SignatureCacheTest, ConcurrentInsertAndLookup) {
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 4096;
+  SignatureCache cache{1 << 20};
+  std::atomic<int> false_positives = 0;
+  {
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&, t] {
+        for (int i = 0; i < kPerThread; ++i) {
+          const int id = t * kPerThread + i;
+          cache.Insert(MakeKey(cache, id));
+          // Keys above the inserted range are never inserted by any thread.
+          if (cache.Contains(MakeKey(cache, kThreads * kPerThread + id))) ++false_positives;
+        }
+      });
+    }
+  }
+  EXPECT_EQ(false_positives, 0);
+  for (int id = 0; id < kThreads * kPerThread; ++id) EXPECT_TRUE(cache.Contains(MakeKey(cache, id)));
+}
+
+TEST(SignatureCacheTest, RuntimeConsultsCache) {
+  // BIP340 test vector 0.
+  const auto public_key = "F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9"_bytes;
+  const auto message = "0000000000000000000000000000000000000000000000000000000000000000"_bytes;
+  auto signature =
+      "E907831F80848D1069A5371B402410364BDF1C5F8307B0084C55F1CE2DCA8215"
+      "25F66A4A85EA8B71E482A74F382D2CE5EBEEE8FDB2172F477DF4900D310536C0"_bytes;
+
+  SignatureCache cache{1 << 16};
+  protocol::script::runtime::Environment env;
+  env.signature_cache = &cache;
+  EXPECT_TRUE(protocol::script::runtime::CheckSchnorrSignature(env, public_key, signature, message));
+  EXPECT_EQ(cache.GetStats().inserts, 1);
+  EXPECT_TRUE(protocol::script::runtime::CheckSchnorrSignature(env, public_key, signature, message));
+  EXPECT_EQ(cache.GetStats().hits, 1);
+
+  // Invalid signatures are not cached.
+  signature[63] ^= 1;
+  EXPECT_FALSE(protocol::script::runtime::CheckSchnorrSignature(env, public_key, signature, message));
+  EXPECT_FALSE(protocol::script::runtime::CheckSchnorrSignature(env, public_key, signature, message));
+  EXPECT_EQ(cache.GetStats().inserts, 1);
+  EXPECT_EQ(cache.GetStats().hits, 1);
+}
+
+}  // namespace
+}  // namespace hornet::crypto::secp256k1
@@ -112,6 +112,24 @@ TEST(HeaderTimechainTest, ValidationViewProvidesTimestamps) {
   EXPECT_EQ(stamps[1], 1u);
 }
 
+TEST(HeaderTimechainTest, ValidationViewTakesMedianTimePastFromContext) {
+  HeaderTimechain tc{};
+  BlockHeader genesis{};
+  genesis.SetTimestamp(1000);
+  HeaderTimechain::ConstIterator tip = tc.Add(HeaderContext::Genesis(genesis)).it;
+  for (uint32_t i = 1; i < 20; ++i) {
+    BlockHeader header{};
+    header.SetPreviousBlockHash(tip->hash);
+    header.SetTimestamp(1000 + (i * 7919) % 101);
+    tip = tc.Add(tip, tip->Extend(header)).it;
+
+    ASSERT_TRUE(tip->MedianTimePast().has_value());
+    const auto from_context = tc.GetValidationView(tip);
+    const auto from_ancestors = tc.GetValidationView(HeaderTimechain::BaseConstIterator{tip});
+    EXPECT_EQ(from_context->MedianTimePast(), from_ancestors->MedianTimePast()) << i;
+  }
+}
+
 TEST(HeaderTimechainTest, PreventsHeaderMutation) {
   HeaderTimechain timechain;
 
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <chrono>
+#include <map>
 #include <random>
 #include <span>
 #include <thread>
@@ -10,11 +11,14 @@
 #include <gtest/gtest.h>
 
 #include "testutil/blockchain.h"
+#include "hornetlib/crypto/hash.h"
+#include "hornetlib/crypto/muhash.h"
 #include "hornetlib/data/utxo/sort.h"
 #include "hornetlib/protocol/block.h"
 #include "hornetlib/protocol/script/writer.h"
 #include "hornetlib/protocol/transaction.h"
 #include "hornetlib/util/log.h"
+#include "hornetlib/util/parallel_chunks.h"
 #include "testutil/temp_folder.h"
 
 namespace hornet::data::utxo {
@@ -437,7 +441,7 @@ TEST(DatabaseTest, TestAppendGeneratedParallel) {
   Database database{dir.Path()};
 
   // Appends the blocks to the database.
-  ParallelFor(1, chain.Length(), [&](int i) {
+  util::ParallelFor(1, chain.Length(), [&](int i) {
     database.Append(*chain[i], i);
   });
 }
@@ -540,5 +544,133 @@ TEST(DatabaseTest, TestPartialQueryAndFetch) {
   EXPECT_FALSE(outputs[1].header.IsNull());
 }
 
+
+TEST(DatabaseTest, TestQueryScripts) {
+  constexpr int kLength = 30;
+  constexpr int kErased = 5;
+
+  test::TempFolder dir;
+  Database database{dir.Path(), true};
+  ASSERT_TRUE(database.HasScriptIndex());
+
+  // Appends blocks, recording the expected unspent set after each height.
+  test::Blockchain chain;
+  std::vector<std::vector<OutputKey>> unspent(kLength);
+  for (int height = 1; height < kLength; ++height) {
+    auto block = chain.Sample(10);
+    database.Append(block, height);
+    chain.Append(std::move(block));
+    for (int i = 0; i < chain.UnspentSize(); ++i) unspent[height].push_back(chain.Unspent(i).prevout);
+    std::sort(unspent[height].begin(), unspent[height].end());
+  }
+
+  // The test chain pays every output to the same script.
+  const protocol::Hash script_hash = crypto::Sha256(chain[1]->Transaction(0).PkScript(0));
+  const protocol::Hash other_hash = crypto::Sha256(std::array<uint8_t, 1>{0x51});
+  const auto query = [&](int before) {
+    std::vector<OutputKey> keys;
+    for (const ScriptKV& kv : database.QueryScripts(std::array{other_hash, script_hash}, before)) {
+      EXPECT_EQ(kv.key.hash, script_hash);
+      EXPECT_NE(kv.rid, kNullOutputId);
+      keys.push_back(kv.key.outpoint);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+  };
+  EXPECT_EQ(query(kLength), unspent[kLength - 1]);
+  EXPECT_EQ(query(kLength / 2), unspent[kLength / 2 - 1]);
+  EXPECT_TRUE(database.QueryScripts(std::array{other_hash}, kLength).empty());
+
+  // Rewinds both indexes together.
+  database.EraseSince(kLength - kErased);
+  EXPECT_EQ(query(kLength), unspent[kLength - kErased - 1]);
+}
+
+TEST(DatabaseTest, TestQueryScriptsDropsSpends) {
+  constexpr int kLength = 100;  // Enough heights to merge runs holding both funding and spend.
+  constexpr int kScripts = 4;
+
+  test::TempFolder dir;
+  Database database{dir.Path(), true};
+  test::Blockchain chain;
+  std::map<OutputKey, protocol::Hash> script_of;
+  for (int height = 1; height < kLength; ++height) {
+    auto block = chain.Sample(10, 2, 4, kScripts);
+    for (const auto tx : block.Transactions())
+      for (int i = 0; i < tx.OutputCount(); ++i)
+        script_of[{tx.GetHash(), static_cast<uint32_t>(i)}] = crypto::Sha256(tx.PkScript(i));
+    chain.Append(std::move(block));
+  }
+  // Appends in swapped pairs, so that some heights wait for their predecessors.
+  for (int height = 1; height < kLength - 1; height += 2) {
+    database.Append(*chain[height + 1], height + 1);
+    database.Append(*chain[height], height);
+  }
+  database.Append(*chain[kLength - 1], kLength - 1);
+
+  // Groups the unspent outputs by script.
+  std::map<protocol::Hash, std::vector<OutputKey>> expected;
+  for (int i = 0; i < chain.UnspentSize(); ++i) {
+    const auto& prevout = chain.Unspent(i).prevout;
+    expected[script_of.at(prevout)].push_back(prevout);
+  }
+  ASSERT_EQ(std::ssize(expected), kScripts);
+  ASSERT_GT(chain.SpentSize(), 0);
+  for (auto& [hash, keys] : expected) {
+    std::sort(keys.begin(), keys.end());
+    std::vector<OutputKey> found;
+    for (const ScriptKV& kv : database.QueryScripts(std::array{hash}, kLength)) {
+      EXPECT_TRUE(kv.IsAdd());
+      found.push_back(kv.key.outpoint);
+    }
+    EXPECT_EQ(found, keys);
+  }
+}
+
+TEST(DatabaseTest, TestUtxoHash) {
+  constexpr int kLength = 20;
+  constexpr int kErased = 6;
+
+  // Records the expected digest of the unspent outpoint set after each height.
+  test::Blockchain chain;
+  const auto digest = [&] {
+    crypto::MuHash3072 muhash;
+    for (int i = 0; i < chain.UnspentSize(); ++i) {
+      const auto& prevout = chain.Unspent(i).prevout;
+      std::array<uint8_t, 36> element = {};
+      std::copy(prevout.hash.begin(), prevout.hash.end(), element.begin());
+      for (int b = 0; b < 4; ++b) element[32 + b] = static_cast<uint8_t>(prevout.index >> (8 * b));
+      muhash.Insert(element);
+    }
+    return protocol::Hash{muhash.Finalize()};
+  };
+  std::vector<protocol::Hash> expected = {digest()};
+  for (int height = 1; height < kLength; ++height) {
+    chain.Append(chain.Sample(10));
+    expected.push_back(digest());
+  }
+
+  test::TempFolder dir;
+  Database database{dir.Path()};
+  EXPECT_EQ(database.GetUtxoHash(0), expected[0]);
+
+  // Appends in pairs out of order; a height is only queryable once its predecessors arrive.
+  for (int height = 1; height + 1 < kLength; height += 2) {
+    database.Append(*chain[height + 1], height + 1);
+    EXPECT_EQ(database.GetUtxoHash(height + 1), std::nullopt);
+    database.Append(*chain[height], height);
+  }
+  for (int height = 0; height < kLength - 1; ++height) EXPECT_EQ(database.GetUtxoHash(height), expected[height]);
+  EXPECT_EQ(database.GetUtxoHash(kLength), std::nullopt);
+
+  // Rewinds and re-appends the tip.
+  const int erase = kLength - 1 - kErased;
+  database.EraseSince(erase);
+  EXPECT_EQ(database.GetUtxoHash(erase), std::nullopt);
+  EXPECT_EQ(database.GetUtxoHash(erase - 1), expected[erase - 1]);
+  for (int height = erase; height < kLength - 1; ++height) database.Append(*chain[height], height);
+  EXPECT_EQ(database.GetUtxoHash(kLength - 2), expected[kLength - 2]);
+}
+
 }  // namespace
 }  // namespace hornet::data::utxo
@@ -0,0 +1,127 @@
+#include "hornetlib/data/utxo/epoch.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hornetlib/data/utxo/atomic_vector.h"
+#include "hornetlib/data/utxo/single_writer.h"
+
+namespace hornet::data::utxo {
+namespace {
+
+// Counts live instances so tests can observe when a retired version is destroyed.
+struct Tracked {
+  static inline std::atomic<int> live = 0;
+  int value;
+  explicit Tracked(int v) : value(v) { ++live; }
+  Tracked(const Tracked& rhs) : value(rhs.value) { ++live; }
+  ~Tracked() { --live; }
+};
+
+TEST(EpochTest, RetireWithoutReadersReclaimsImmediately) {
+  auto& epoch = Epoch::Global();
+  epoch.Reclaim();
+  bool deleted = false;
+  epoch.Retire([&] { deleted = true; });
+  EXPECT_TRUE(deleted);
+}
+
+TEST(EpochTest, PinnedReaderDefersReclaim) {
+  auto& epoch = Epoch::Global();
+  bool deleted = false;
+  {
+    const auto guard = epoch.Pin();
+    epoch.Retire([&] { deleted = true; });
+    EXPECT_FALSE(deleted);
+    epoch.Reclaim();
+    EXPECT_FALSE(deleted);
+  }
+  epoch.Reclaim();
+  EXPECT_TRUE(deleted);
+}
+
+TEST(EpochTest, NestedGuardsUnpinOnOutermost) {
+  auto& epoch = Epoch::Global();
+  bool deleted = false;
+  {
+    const auto outer = epoch.Pin();
+    {
+      const auto inner = epoch.Pin();
+      epoch.Retire([&] { deleted = true; });
+    }
+    epoch.Reclaim();
+    EXPECT_FALSE(deleted);
+  }
+  epoch.Reclaim();
+  EXPECT_TRUE(deleted);
+}
+
+TEST(EpochTest, ReaderOnOtherThreadDefersReclaim) {
+  auto& epoch = Epoch::Global();
+  std::atomic<int> stage = 0;
+  std::thread reader([&] {
+    const auto guard = epoch.Pin();
+    stage = 1;
+    stage.notify_all();
+    stage.wait(1);
+  });
+  stage.wait(0);
+
+  bool deleted = false;
+  epoch.Retire([&] { deleted = true; });
+  EXPECT_FALSE(deleted);
+
+  stage = 2;
+  stage.notify_all();
+  reader.join();
+  epoch.Reclaim();
+  EXPECT_TRUE(deleted);
+}
+
+TEST(EpochTest, SnapshotKeepsSupersededVersionAlive) {
+  SingleWriter<Tracked> sw(1);
+  const int before = Tracked::live;
+  {
+    const auto snapshot = sw.Snapshot();
+    sw.Edit()->value = 2;
+    EXPECT_EQ(snapshot->value, 1);
+    EXPECT_EQ(sw->value, 2);
+    EXPECT_EQ(Tracked::live, before + 1);
+  }
+  Epoch::Global().Reclaim();
+  EXPECT_EQ(Tracked::live, before);
+}
+
+TEST(EpochTest, ConcurrentReadersAndWriter) {
+  AtomicVector<Tracked> vec;
+  vec.EmplaceBack(Tracked{0});
+
+  std::atomic<bool> stop = false;
+  std::atomic<int64_t> checksum = 0;
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 16; ++i) {
+    readers.emplace_back([&] {
+      int64_t sum = 0;
+      while (!stop) {
+        const auto snapshot = vec.Snapshot();
+        for (const auto& item : *snapshot) sum += item->value;
+      }
+      checksum += sum;
+    });
+  }
+  for (int i = 1; i <= 1'000; ++i) {
+    vec.EmplaceBack(Tracked{i});
+    if (vec.Size() > 8) vec.EraseFront(4);
+  }
+  stop = true;
+  for (auto& reader : readers) reader.join();
+  Epoch::Global().Reclaim();
+  EXPECT_EQ(Epoch::Global().PendingCount(), 0);
+  EXPECT_EQ(Tracked::live, vec.Size());
+}
+
+}  // namespace
+}  // namespace hornet::data::utxo
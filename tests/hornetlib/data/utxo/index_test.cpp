@@ -86,5 +86,51 @@ TEST(IndexTest, TestQuery) {
   EXPECT_EQ(query.spent, 0);
 }
 
+TEST(IndexTest, TestQueryBatchMatchesSeparateQueries) {
+  constexpr int kHeights = 24;
+  constexpr int kEntriesPerRun = 500;
+
+  // Each height funds new outputs and spends a few outputs funded at the previous height.
+  Index index;
+  std::vector<OutputKey> funded;
+  for (int height = 1; height < kHeights; ++height) {
+    auto entries = MakeEntries(index, kEntriesPerRun, height);
+    for (int i = 0; i < 50 && !funded.empty(); ++i) {
+      entries.PushBack(OutputKV::Spent(funded.back(), height));
+      funded.pop_back();
+    }
+    for (const OutputKV& kv : entries)
+      if (kv.IsAdd()) funded.push_back(kv.key);
+    index.SortEntries(&entries);
+    index.Append(std::move(entries), height);
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  // Requests with overlapping key sets and different height windows, as for consecutive blocks.
+  std::mt19937 rng{11};
+  struct Window { int since, before; };
+  const std::vector<Window> windows = {{0, 5}, {0, 12}, {0, kHeights}, {12, 20}, {20, kHeights}};
+  std::vector<std::vector<OutputKey>> keys(windows.size());
+  std::vector<std::vector<OutputId>> batched(windows.size()), separate(windows.size());
+  std::vector<QueryRequest> requests;
+  for (int i = 0; i < std::ssize(windows); ++i) {
+    for (int j = 0; j < 400; ++j) keys[i].push_back(funded[rng() % funded.size()]);
+    for (int j = 0; j < 100; ++j) keys[i].push_back(RandomAddKV(0).key);  // Not found.
+    std::sort(keys[i].begin(), keys[i].end());
+    batched[i].assign(keys[i].size(), kNullOutputId);
+    separate[i].assign(keys[i].size(), kNullOutputId);
+    requests.push_back({keys[i], batched[i], windows[i].since, windows[i].before});
+  }
+  index.QueryBatch(requests);
+
+  for (int i = 0; i < std::ssize(windows); ++i) {
+    const auto expected = index.Query(keys[i], separate[i], windows[i].since, windows[i].before);
+    EXPECT_EQ(requests[i].result.funded, expected.funded);
+    EXPECT_EQ(requests[i].result.spent, expected.spent);
+    EXPECT_EQ(batched[i], separate[i]);
+  }
+}
+
 }  // namespace
 }  // namespace hornet::data::utxo
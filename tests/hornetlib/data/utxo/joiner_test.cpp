@@ -22,6 +22,34 @@ TEST(SpendJoinerTest, TestConstruct) {
   EXPECT_TRUE(joiner.IsAdvanceReady());
 }
 
+TEST(SpendJoinerTest, TestOnFetchReleased) {
+  test::TempFolder dir;
+  Database db{dir.Path()};
+  test::Blockchain chain;
+
+  // A callback registered before the fetch fires once, on reaching Fetched.
+  const auto block = std::make_shared<protocol::Block>(chain.Sample());
+  SpendJoiner joiner{db, block, 1};
+  int calls = 0;
+  joiner.OnFetchReleased([&] { ++calls; });
+  while (joiner.IsAdvanceReady()) {
+    EXPECT_EQ(calls, 0);
+    joiner.Advance();
+  }
+  EXPECT_TRUE(joiner.IsJoinReady());
+  EXPECT_EQ(calls, 1);
+
+  // A callback registered after the release is called immediately.
+  joiner.OnFetchReleased([&] { ++calls; });
+  EXPECT_EQ(calls, 2);
+
+  // Cancellation also releases the fetch.
+  SpendJoiner cancelled{db, std::make_shared<protocol::Block>(chain.Sample()), 2};
+  cancelled.OnFetchReleased([&] { ++calls; });
+  cancelled.Cancel();
+  EXPECT_EQ(calls, 3);
+}
+
 TEST(SpendJoinerTest, TestPreemptiveSerial) {
   test::TempFolder dir;
   Database db{dir.Path()};
@@ -47,6 +75,7 @@ TEST(SpendJoinerTest, TestPreemptiveSerial) {
       int64_t total_spend = 0;
       const consensus::Result result = joiner.Join([&](const consensus::SpendRecord& spend) {
         EXPECT_LT(spend.funding_height, height);
+        EXPECT_NE(spend.precomputed, nullptr);
         EXPECT_GE(spend.amount, 0);
         total_spend += spend.amount;
         return consensus::Result{};
@@ -62,6 +91,34 @@ TEST(SpendJoinerTest, TestPreemptiveSerial) {
   }
 }
 
+TEST(SpendJoinerTest, TestQueryOnly) {
+  test::TempFolder dir;
+  Database db{dir.Path()};
+
+  // Without a fetch, the joiner still finds the prevouts unspent and releases its fetch.
+  constexpr int kLength = 30;
+  test::Blockchain chain;
+  for (int height = 1; height < kLength; ++height) {
+    auto block = std::make_shared<protocol::Block>(chain.Sample());
+    SpendJoiner joiner{db, block, height, false};
+    int calls = 0;
+    joiner.OnFetchReleased([&] { ++calls; });
+    while (joiner.IsAdvanceReady()) joiner.Advance();
+    EXPECT_TRUE(joiner.WaitForQuery());
+    EXPECT_TRUE(joiner.IsJoinReady());
+    EXPECT_EQ(calls, 1);
+    chain.Append(std::move(*block));
+  }
+
+  // A missing prevout still fails the query.
+  auto block = std::make_shared<protocol::Block>(chain.Sample());
+  block->Transaction(1).Input(0).previous_output.hash[0]++;  // Corrupts one prevout txid.
+  SpendJoiner joiner{db, block, kLength, false};
+  while (joiner.IsAdvanceReady()) joiner.Advance();
+  EXPECT_FALSE(joiner.WaitForQuery());
+  EXPECT_EQ(joiner.GetState(), SpendJoiner::State::Error);
+}
+
 TEST(SpendJoinerTest, TestPreemptiveInvalidBlock) {
   test::TempFolder dir;
   Database db{dir.Path()};
@@ -0,0 +1,74 @@
+#include "hornetlib/data/utxo/sort.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace hornet::data::utxo {
+namespace {
+
+// Generates keys where groups of inputs spend outputs of the same transaction, producing
+// runs of equal prefixes that must be resolved on the output index.
+std::vector<OutputKey> MakeKeys(int count, std::mt19937& rng) {
+  std::vector<OutputKey> keys;
+  while (std::ssize(keys) < count) {
+    protocol::Hash hash;
+    for (auto& byte : hash) byte = static_cast<uint8_t>(rng());
+    const int outputs = 1 + rng() % 4;
+    for (int i = 0; i < outputs && std::ssize(keys) < count; ++i)
+      keys.push_back({hash, static_cast<uint32_t>(rng() % 100)});
+  }
+  std::shuffle(keys.begin(), keys.end(), rng);
+  return keys;
+}
+
+TEST(SortTest, SortTogetherMatchesReferenceForKeys) {
+  std::mt19937 rng{42};
+  for (int size : {0, 1, 2, 17, 63, 64, 1'000, 10'000}) {
+    std::vector<OutputKey> keys = MakeKeys(size, rng);
+    const std::vector<OutputKey> original = keys;
+    std::vector<int> tags(size);
+    std::iota(tags.begin(), tags.end(), 0);
+
+    SortTogether(keys.begin(), keys.end(), tags.begin());
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    for (int i = 0; i < size; ++i) EXPECT_EQ(keys[i], original[tags[i]]);
+  }
+}
+
+TEST(SortTest, SortTogetherPermutesAllSecondaries) {
+  std::mt19937 rng{7};
+  constexpr int kSize = 5'000;
+  std::vector<OutputId> rids(kSize);
+  for (auto& rid : rids) rid = (uint64_t{rng()} << 32) | rng();
+  std::vector<InputHeader> inputs(kSize);
+  std::vector<OutputId> copies = rids;
+  for (int i = 0; i < kSize; ++i) inputs[i] = {i / 10, i % 10};
+
+  SortTogether(rids.begin(), rids.end(), inputs.begin(), copies.begin());
+  EXPECT_TRUE(std::is_sorted(rids.begin(), rids.end()));
+  EXPECT_EQ(rids, copies);
+
+  SortTogether(inputs.begin(), inputs.end(), rids.begin(), copies.begin());
+  EXPECT_TRUE(std::is_sorted(inputs.begin(), inputs.end()));
+  EXPECT_EQ(rids, copies);
+  for (int i = 0; i < kSize; ++i) EXPECT_EQ(inputs[i], (InputHeader{i / 10, i % 10}));
+}
+
+TEST(SortTest, SortPrefixOrdersSignedIntegers) {
+  std::mt19937 rng{3};
+  std::vector<int> values = {5, -1, 0, -300, 1 << 30, -(1 << 30), 7, 7, -1};
+  for (int i = 0; i < 1'000; ++i) values.push_back(static_cast<int>(rng()));
+  std::vector<int> expected = values;
+  std::sort(expected.begin(), expected.end());
+  std::vector<int> copies = values;
+  SortTogether(values.begin(), values.end(), copies.begin());
+  EXPECT_EQ(values, expected);
+  EXPECT_EQ(copies, expected);
+}
+
+}  // namespace
+}  // namespace hornet::data::utxo
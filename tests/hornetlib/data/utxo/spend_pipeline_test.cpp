@@ -90,6 +90,27 @@ TEST_F(SpendPipelineTest, ProcessBlocksOutOfOrder) {
   }
 }
 
+TEST_F(SpendPipelineTest, ProcessBlocksDeepPipeline) {
+  // Adding in reverse order leaves most joiners blocked on lower heights, then wakes them in turn.
+  constexpr int kBlocks = 96;
+  test::Blockchain chain;
+  while (chain.Length() <= kBlocks) chain.Append(chain.Sample());
+
+  SpendPipeline pipeline{*db_, 64};
+  std::vector<std::shared_ptr<SpendJoiner>> joiners(kBlocks + 1);
+  for (int height = kBlocks; height >= 1; --height)
+    joiners[height] = pipeline.Add(chain[height], height);
+
+  for (int height = 1; height <= kBlocks; ++height) {
+    EXPECT_TRUE(joiners[height]->WaitForFetch());
+    const consensus::Result result = joiners[height]->Join([height](const consensus::SpendRecord& spend) {
+        EXPECT_LT(spend.funding_height, height);
+        return consensus::Result{};
+    });
+    EXPECT_EQ(result, consensus::Result{});
+  }
+}
+
 TEST_F(SpendPipelineTest, ProcessInvalidBlock) {
   test::Blockchain chain;
   
@@ -42,4 +42,22 @@ TEST(TiledVectorTest, TestIterators)
   }
 }
 
+TEST(TiledVectorTest, TestEraseIfCompactsTiles)
+{
+  constexpr int kEntries = 100;
+  TiledVector<int> values(3);  // Eight entries per tile.
+  for (int i = 0; i < kEntries; ++i)
+    values.PushBack(i);
+
+  EXPECT_EQ(values.EraseIf([](int v) { return v % 3 == 0; }), 34u);
+  EXPECT_EQ(values.Size(), 66u);
+  int expected = 0;
+  for (int i = 0; i < static_cast<int>(values.Size()); ++i) {
+    if (++expected % 3 == 0) ++expected;
+    EXPECT_EQ(values[i], expected);
+  }
+  EXPECT_EQ(values.EraseIf([](int) { return true; }), 66u);
+  EXPECT_TRUE(values.Empty());
+}
+
 }  // namespace hornet::data::utxo
@@ -0,0 +1,76 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetlib/encoding/hash_writer.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hornetlib/crypto/hash.h"
+#include "hornetlib/encoding/writer.h"
+#include "hornetlib/protocol/transaction.h"
+#include "hornetlib/protocol/txid.h"
+
+namespace hornet::encoding {
+namespace {
+
+template <typename WriterT>
+void WriteFields(WriterT& writer) {
+  const std::vector<uint8_t> bytes(150, 0xAB);
+  writer.WriteLE4(0x01020304u);
+  writer.WriteVarInt(0xFDu);
+  writer.WriteBytes(bytes);
+  writer.WriteBool(true);
+  writer.WriteVarInt(0x12345678u);
+  writer.WriteBE2(0x1234);
+  writer.WriteVarString("hornet");
+  writer.WriteLE8(int64_t{-1});
+}
+
+TEST(HashWriterTest, HashesWhatWriterWrites) {
+  Writer writer;
+  WriteFields(writer);
+  HashWriter hash_writer;
+  WriteFields(hash_writer);
+  EXPECT_EQ(hash_writer.GetPos(), writer.GetPos());
+  EXPECT_EQ(hash_writer.GetDoubleHash(), crypto::DoubleSha256(writer.Buffer()));
+}
+
+// Fills a transaction with two inputs, and optionally their witnesses.
+void MakeTransaction(protocol::Transaction& tx, bool witness) {
+  tx.SetVersion(2);
+  tx.ResizeInputs(2);
+  tx.ResizeOutputs(1);
+  if (witness) tx.ResizeWitnesses(2);
+  for (int i = 0; i < 2; ++i) {
+    tx.Input(i).previous_output = {protocol::Hash{uint8_t(i + 1)}, uint32_t(i)};
+    tx.Input(i).sequence = 0xfffffffd;
+    if (!witness) continue;
+    tx.ResizeComponents(i, 2);
+    tx.SetWitnessScript(i, 0, std::vector<uint8_t>(72, uint8_t(i)));
+    tx.SetWitnessScript(i, 1, std::vector<uint8_t>(33, 0x02));
+  }
+  tx.Output(0).value = 12'345;
+  tx.SetPkScript(0, std::vector<uint8_t>(22, 0x14));
+  tx.SetLockTime(500'000);
+}
+
+TEST(HashWriterTest, ComputesTxidAndWtxid) {
+  protocol::Transaction tx, legacy;
+  MakeTransaction(tx, true);
+  MakeTransaction(legacy, false);
+
+  // The txid excludes the witness data, whereas the wtxid includes it.
+  Writer with_witness, without_witness;
+  tx.Serialize(with_witness);
+  legacy.Serialize(without_witness);
+  EXPECT_EQ(tx.GetWitnessHash(), crypto::DoubleSha256(with_witness.Buffer()));
+  EXPECT_EQ(tx.GetHash(), crypto::DoubleSha256(without_witness.Buffer()));
+  EXPECT_EQ(legacy.GetWitnessHash(), legacy.GetHash());
+}
+
+}  // namespace
+}  // namespace hornet::encoding
@@ -4,6 +4,10 @@
 // For licensing or usage inquiries, contact: ask@hornetnode.com.
 #include "hornetlib/model/header_context.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "hornetlib/protocol/block_header.h"
@@ -84,5 +88,26 @@ TEST(HeaderContextTest, RewindReturnsPreviousContext) {
   EXPECT_EQ(back.data.ComputeHash(), genesis.ComputeHash());
 }
 
+TEST(HeaderContextTest, MedianTimePastTracksExtendAndRewind) {
+  const std::vector<uint32_t> timestamps = {50, 10, 40, 20, 30, 90, 60, 80, 70, 0, 100, 5, 95, 15};
+  auto genesis = MakeHeader({}, timestamps[0]);
+  std::vector<HeaderContext> chain = {HeaderContext::Genesis(genesis)};
+  for (size_t i = 1; i < timestamps.size(); ++i)
+    chain.push_back(chain.back().Extend(MakeHeader(chain.back().hash, timestamps[i])));
+
+  for (int height = 0; height < std::ssize(chain); ++height) {
+    std::vector<uint32_t> window(timestamps.begin() + std::max(0, height - 10),
+                                 timestamps.begin() + height + 1);
+    std::sort(window.begin(), window.end());
+    EXPECT_EQ(chain[height].MedianTimePast(), window[window.size() / 2]) << height;
+  }
+
+  // Rewinding loses the oldest timestamp of the window, until the chain is extended again.
+  const HeaderContext back = chain[12].Rewind(chain[11].data);
+  EXPECT_FALSE(back.MedianTimePast().has_value());
+  EXPECT_EQ(back.Extend(chain[12].data).MedianTimePast(), chain[12].MedianTimePast());
+  EXPECT_EQ(chain[3].Rewind(chain[2].data).MedianTimePast(), chain[2].MedianTimePast());
+}
+
 }  // namespace
 }  // namespace hornet::model
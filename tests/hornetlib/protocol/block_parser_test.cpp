@@ -0,0 +1,151 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetlib/protocol/block_parser.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "hornetlib/crypto/hash.h"
+#include "hornetlib/encoding/writer.h"
+#include "hornetlib/protocol/block.h"
+#include "hornetlib/protocol/header.h"
+#include "hornetlib/protocol/parser.h"
+#include "hornetlib/protocol/transaction.h"
+#include "hornetlib/protocol/transaction_scanner.h"
+
+#include <gtest/gtest.h>
+
+namespace hornet::protocol {
+namespace {
+
+// Returns a serialized block of legacy and segwit transactions with assorted script sizes.
+std::vector<uint8_t> MakeSerializedBlock(int tx_count) {
+  Block block;
+  for (int i = 0; i < tx_count; ++i) {
+    Transaction tx;
+    tx.SetVersion(2);
+    tx.ResizeInputs(1 + i % 3);
+    tx.Input(0).previous_output = {Hash{uint8_t(i)}, uint32_t(i)};
+    tx.ResizeOutputs(1);
+    tx.Output(0).value = i;
+    tx.SetPkScript(0, std::vector<uint8_t>(i * 7 % 300, uint8_t(i)));
+    if (i % 2) {
+      tx.ResizeWitnesses(tx.Inputs().size());
+      tx.ResizeComponents(0, 2);
+      tx.SetWitnessScript(0, 1, std::vector<uint8_t>(i % 100, 0x5A));
+    }
+    block.AddTransaction(tx);
+  }
+  encoding::Writer writer;
+  block.Serialize(writer);
+  return writer.Buffer();
+}
+
+Header MakeHeader(std::span<const uint8_t> payload) {
+  Header header{.magic = Magic::Main, .command = "block", .bytes = uint32_t(payload.size())};
+  const auto hash = crypto::DoubleSha256(payload);
+  std::copy_n(hash.begin(), header.checksum.size(), header.checksum.begin());
+  return header;
+}
+
+// Feeds the payload to the parser in chunks of the given size, as a connection buffer would.
+Block ParseInChunks(const Header& header, std::span<const uint8_t> payload, size_t chunk) {
+  BlockParser parser{header};
+  std::vector<uint8_t> buffer;
+  for (size_t pos = 0; pos < payload.size(); pos += chunk) {
+    const auto arrived = payload.subspan(pos, std::min(chunk, payload.size() - pos));
+    buffer.insert(buffer.end(), arrived.begin(), arrived.end());
+    buffer.erase(buffer.begin(), buffer.begin() + parser.Parse(buffer));
+  }
+  EXPECT_TRUE(parser.IsComplete());
+  EXPECT_TRUE(buffer.empty());
+  return parser.Finish();
+}
+
+TEST(TransactionScannerTest, FindsEndOfTransaction) {
+  const auto payload = MakeSerializedBlock(2);
+  const auto tx = std::span{payload}.subspan(81);
+  const auto size = TransactionScanner{tx}.Scan();
+  ASSERT_TRUE(size.has_value());
+  for (int length = 0; length < *size; ++length)
+    EXPECT_FALSE(TransactionScanner{tx.first(length)}.Scan().has_value()) << length;
+  EXPECT_EQ(TransactionScanner{tx.first(*size)}.Scan(), size);
+}
+
+TEST(TransactionScannerTest, CountsElements) {
+  constexpr int kTxCount = 20;
+  const auto payload = MakeSerializedBlock(kTxCount);
+  TransactionScanner scanner{std::span{payload}.subspan(81)};
+  for (int i = 0; i < kTxCount; ++i) ASSERT_TRUE(scanner.Scan().has_value()) << i;
+  EXPECT_FALSE(scanner.Scan().has_value());
+
+  TransactionCounts expected;
+  for (int i = 0; i < kTxCount; ++i) {
+    expected.inputs += 1 + i % 3;
+    expected.outputs += 1;
+    expected.script_bytes += i * 7 % 300;
+    if (i % 2) {
+      expected.witnesses += 1 + i % 3;
+      expected.components += 2;
+      expected.script_bytes += i % 100;
+    }
+  }
+  const auto& counts = scanner.Counts();
+  EXPECT_EQ(counts.inputs, expected.inputs);
+  EXPECT_EQ(counts.outputs, expected.outputs);
+  EXPECT_EQ(counts.witnesses, expected.witnesses);
+  EXPECT_EQ(counts.components, expected.components);
+  EXPECT_EQ(counts.script_bytes, expected.script_bytes);
+}
+
+TEST(BlockParserTest, ParsesBlockArrivingInChunks) {
+  const auto payload = MakeSerializedBlock(50);
+  const auto header = MakeHeader(payload);
+  for (size_t chunk : {1, 7, 100, 4096, 1 << 20}) {
+    const Block block = ParseInChunks(header, payload, chunk);
+    EXPECT_EQ(block.GetTransactionCount(), 50);
+    encoding::Writer writer;
+    block.Serialize(writer);
+    EXPECT_EQ(writer.Buffer(), payload) << chunk;
+  }
+}
+
+TEST(BlockParserTest, MatchesDeserialize) {
+  const auto payload = MakeSerializedBlock(20);
+  const Block parsed = ParseInChunks(MakeHeader(payload), payload, 333);
+  Block deserialized;
+  encoding::Reader reader{payload};
+  deserialized.Deserialize(reader);
+  EXPECT_EQ(parsed.GetWeightUnits(), deserialized.GetWeightUnits());
+  EXPECT_EQ(parsed.GetStrippedSize(), deserialized.GetStrippedSize());
+}
+
+TEST(BlockParserTest, PresizesFromProjectedCounts) {
+  constexpr int kTxCount = 1000;
+  const auto payload = MakeSerializedBlock(kTxCount);
+  const Block block = ParseInChunks(MakeHeader(payload), payload, 1000);
+  EXPECT_EQ(block.GetTransactionCount(), kTxCount);
+  // Growing one transaction at a time would reallocate each array about log2(kTxCount) times.
+  EXPECT_LE(block.GetReallocations(), 8);
+  EXPECT_LT(block.GetReallocatedBytes(), block.SizeBytes());
+}
+
+TEST(BlockParserTest, RejectsChecksumMismatch) {
+  auto payload = MakeSerializedBlock(10);
+  const auto header = MakeHeader(payload);
+  payload[200] ^= 1;  // Corrupts a script byte.
+  EXPECT_THROW(ParseInChunks(header, payload, 64), Parser::Error);
+}
+
+TEST(BlockParserTest, RejectsTruncatedTransaction) {
+  auto payload = MakeSerializedBlock(10);
+  payload.resize(payload.size() - 1);
+  BlockParser parser{MakeHeader(payload)};
+  EXPECT_THROW(parser.Parse(payload), std::out_of_range);
+}
+
+}  // namespace
+}  // namespace hornet::protocol
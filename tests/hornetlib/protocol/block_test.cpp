@@ -5,6 +5,9 @@
 #include "hornetlib/protocol/block.h"
 
 #include <array>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "hornetlib/encoding/reader.h"
 #include "hornetlib/encoding/writer.h"
@@ -65,4 +68,114 @@ TEST(BlockTest, TestGetWeightUnits) {
   EXPECT_EQ(deserialized.GetWeightUnits(), expected_weight);
 }
 
+TEST(BlockTest, ComputeHashesMatchesLazyHashes) {
+  // Enough transactions for several kernel widths, alternating legacy and segwit.
+  Block block;
+  for (int i = 0; i < 301; ++i) {
+    Transaction tx;
+    tx.SetVersion(2);
+    tx.ResizeInputs(1);
+    tx.Input(0).previous_output = {Hash{uint8_t(i)}, uint32_t(i)};
+    tx.ResizeOutputs(1);
+    tx.Output(0).value = i;
+    tx.SetPkScript(0, std::vector<uint8_t>(i % 40, uint8_t(i)));
+    if (i % 2) {
+      tx.ResizeWitnesses(1);
+      tx.ResizeComponents(0, 1);
+      tx.SetWitnessScript(0, 0, std::vector<uint8_t>(i % 100, 0x5A));
+    }
+    block.AddTransaction(tx);
+  }
+
+  // Deserializing a copy of the block leaves its hashes uncomputed.
+  encoding::Writer writer;
+  block.Serialize(writer);
+  Block computed;
+  encoding::Reader reader(writer.Buffer());
+  computed.Deserialize(reader);
+  computed.ComputeHashes();
+
+  ASSERT_EQ(computed.GetTransactionCount(), block.GetTransactionCount());
+  for (int i = 0; i < block.GetTransactionCount(); ++i) {
+    const auto tx = std::as_const(block).Transaction(i);
+    EXPECT_EQ(std::as_const(computed).Transaction(i).GetHash(), tx.GetHash()) << i;
+    EXPECT_EQ(std::as_const(computed).Transaction(i).GetWitnessHash(), tx.GetWitnessHash()) << i;
+  }
+  // Modifying a transaction discards its cached hashes.
+  computed.Transaction(0).SetLockTime(1);
+  EXPECT_NE(std::as_const(computed).Transaction(0).GetHash(), std::as_const(block).Transaction(0).GetHash());
+}
+
+TEST(BlockTest, DeserializeSharedBorrowsScripts) {
+  Block block;
+  for (int i = 0; i < 10; ++i) {
+    Transaction tx;
+    tx.SetVersion(2);
+    tx.ResizeInputs(1);
+    tx.SetSignatureScript(0, std::vector<uint8_t>(i + 1, uint8_t(i)));
+    tx.ResizeOutputs(1);
+    tx.SetPkScript(0, std::vector<uint8_t>(2 * i + 1, uint8_t(i)));
+    tx.ResizeWitnesses(1);
+    tx.ResizeComponents(0, 1);
+    tx.SetWitnessScript(0, 0, std::vector<uint8_t>(i + 3, 0x5A));
+    block.AddTransaction(tx);
+  }
+  encoding::Writer writer;
+  block.Serialize(writer);
+  const auto payload = std::make_shared<const std::vector<uint8_t>>(writer.Buffer());
+
+  Block shared;
+  shared.Deserialize(payload);
+  const auto in_payload = [&](std::span<const uint8_t> script) {
+    return script.data() >= payload->data() && script.data() + script.size() <= payload->data() + payload->size();
+  };
+  for (int i = 0; i < block.GetTransactionCount(); ++i) {
+    const auto tx = std::as_const(shared).Transaction(i);
+    EXPECT_TRUE(in_payload(tx.SignatureScript(0)));
+    EXPECT_TRUE(in_payload(tx.PkScript(0)));
+    EXPECT_TRUE(in_payload(tx.WitnessScript(0, 0)));
+    EXPECT_EQ(tx.GetWitnessHash(), std::as_const(block).Transaction(i).GetWitnessHash());
+  }
+  Block copied;
+  encoding::Reader reader{*payload};
+  copied.Deserialize(reader);
+  EXPECT_EQ(shared.GetWeightUnits(), copied.GetWeightUnits());
+  EXPECT_LT(shared.SizeBytes(), copied.SizeBytes() + std::ssize(*payload));
+
+  // Modifying the block copies its scripts, leaving the payload intact.
+  const std::vector<uint8_t> original = *payload;
+  shared.Transaction(3).SetPkScript(0, std::vector<uint8_t>(50, 0xEE));
+  EXPECT_EQ(*payload, original);
+  EXPECT_FALSE(in_payload(std::as_const(shared).Transaction(3).PkScript(0)));
+  EXPECT_EQ(std::as_const(shared).Transaction(4).PkScript(0).size(), 9u);
+}
+
+TEST(BlockTest, DeserializeAllocatesExactly) {
+  // Legacy and segwit transactions with varying input counts and script sizes.
+  Block block;
+  for (int i = 0; i < 50; ++i) {
+    Transaction tx;
+    tx.SetVersion(2);
+    tx.ResizeInputs(1 + i % 3);
+    tx.Input(0).previous_output = {Hash{uint8_t(i)}, uint32_t(i)};
+    tx.ResizeOutputs(1);
+    tx.Output(0).value = i;
+    tx.SetPkScript(0, std::vector<uint8_t>(i * 7 % 300, uint8_t(i)));
+    if (i % 2) {
+      tx.ResizeWitnesses(tx.Inputs().size());
+      tx.ResizeComponents(0, 2);
+      tx.SetWitnessScript(0, 1, std::vector<uint8_t>(i % 100, 0x5A));
+    }
+    block.AddTransaction(tx);
+  }
+  encoding::Writer writer;
+  block.Serialize(writer);
+
+  Block deserialized;
+  encoding::Reader reader{writer.Buffer()};
+  deserialized.Deserialize(reader);
+  EXPECT_EQ(deserialized.GetTransactionCount(), 50);
+  EXPECT_EQ(deserialized.UnusedBytes(), 0);
+}
+
 }  // namespacae hornet::protocol
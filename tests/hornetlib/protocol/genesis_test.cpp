@@ -112,5 +112,13 @@ TEST(GenesisTest, ConstructFromFields) {
   EXPECT_EQ(compare, binary);
 }
 
+TEST(GenesisTest, ParsesGenesisHashFromHex) {
+  EXPECT_EQ(Hash::FromHex("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f"), kGenesisHash);
+  EXPECT_EQ(Hash::FromHex("000000000019D6689C085AE165831E934FF763AE46A2A6C172B3F1B60A8CE26F"), kGenesisHash);
+  EXPECT_FALSE(Hash::FromHex("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26"));
+  EXPECT_FALSE(Hash::FromHex("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26g"));
+  EXPECT_FALSE(Hash::FromHex("-00000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f"));
+}
+
 }  // namespace
 }  // namespace hornet::protocol
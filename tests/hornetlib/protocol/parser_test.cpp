@@ -69,5 +69,17 @@ TEST(ParserTest, FailsOnChecksumMismatch) {
   EXPECT_THROW(parser.Parse(writer.Buffer()), Parser::Error);
 }
 
+TEST(ParserTest, UnframeDefersChecksum) {
+  auto buffer = FrameMessage(Magic::Main, DummyMessage{});
+  buffer.back() ^= 1;  // Corrupts the payload.
+
+  Parser parser(Magic::Main);
+  const auto parsed = parser.Unframe(buffer);
+  EXPECT_EQ(parsed.header.command, "ping");
+  EXPECT_EQ(parsed.payload.size(), 5);
+  EXPECT_THROW(Parser::VerifyChecksum(parsed), Parser::Error);
+  EXPECT_THROW(parser.Parse(buffer), Parser::Error);
+}
+
 }  // namespace
 }  // namespace hornet::protocol
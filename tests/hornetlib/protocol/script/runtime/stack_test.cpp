@@ -0,0 +1,80 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetlib/protocol/script/runtime/stack.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace hornet::protocol::script::runtime {
+namespace {
+
+std::vector<uint8_t> Item(int i) {
+  return std::vector<uint8_t>(1 + i % 70, uint8_t(i));
+}
+
+std::vector<uint8_t> ToVector(lang::Bytes bytes) {
+  return {bytes.begin(), bytes.end()};
+}
+
+void ExpectItems(const Stack& stack, int count) {
+  ASSERT_EQ(stack.Size(), count);
+  for (int i = 0; i < count; ++i) EXPECT_EQ(ToVector(stack.At(count - 1 - i)), Item(i));
+}
+
+TEST(ScriptStackStorageTest, GrowsFromInlineStorage) {
+  Stack stack;
+  for (int i = 0; i < 10; ++i) stack.Push(Item(i));
+  EXPECT_FALSE(stack.IsBuffered());
+  ExpectItems(stack, 10);
+
+  // Duplicating the top item across the transition to a buffer.
+  while (!stack.IsBuffered()) stack.Push(stack.Top());
+  EXPECT_EQ(ToVector(stack.Top()), Item(9));
+  stack.Pop(stack.Size() - 10);
+  for (int i = 10; i < 100; ++i) stack.Push(Item(i));
+  ExpectItems(stack, 100);
+
+  stack.Pop(90);
+  ExpectItems(stack, 10);
+  stack.Clear();
+  EXPECT_TRUE(stack.Empty());
+  EXPECT_FALSE(stack.IsBuffered());
+}
+
+TEST(ScriptStackStorageTest, CopiesAndMoves) {
+  for (const int count : {5, 200}) {
+    Stack stack;
+    for (int i = 0; i < count; ++i) stack.Push(Item(i));
+    Stack copy = stack;
+    ExpectItems(copy, count);
+    Stack moved = std::move(stack);
+    ExpectItems(moved, count);
+    copy.Clear();
+    copy = moved;
+    ExpectItems(copy, count);
+  }
+}
+
+TEST(ScriptStackStorageTest, ReusesArenaBuffers) {
+  const auto fill = [](Stack& stack) {
+    for (int i = 0; i < Stack::kMaxItems; ++i) stack.Push(uint8_t(i));
+  };
+  const uint8_t* first = nullptr;
+  {
+    Stack stack;
+    fill(stack);
+    first = stack.At(0).data();
+  }
+  Stack stack;
+  fill(stack);
+  EXPECT_EQ(stack.At(0).data(), first);
+  EXPECT_THROW(stack.Push(uint8_t{0}), Exception);
+}
+
+}  // namespace
+}  // namespace hornet::protocol::script::runtime
@@ -0,0 +1,176 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetlib/protocol/script/sighash.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hornetlib/encoding/reader.h"
+#include "hornetlib/protocol/transaction.h"
+#include "hornetlib/util/hex.h"
+
+namespace hornet::protocol::script {
+namespace {
+
+std::vector<uint8_t> Repeat(std::initializer_list<uint8_t> prefix, uint8_t byte, int count) {
+  std::vector<uint8_t> bytes{prefix};
+  bytes.insert(bytes.end(), count, byte);
+  return bytes;
+}
+
+// Adds an empty witness to every input, so that the transaction serializes as segwit.
+void AddWitnesses(Transaction& tx) {
+  tx.ResizeWitnesses(tx.InputCount());
+  for (int i = 0; i < tx.InputCount(); ++i) {
+    tx.ResizeComponents(i, 1);
+    tx.SetWitnessScript(i, 0, std::vector<uint8_t>{0x01});
+  }
+}
+
+// The native P2WPKH example from BIP143.
+TEST(SighashTest, SegwitV0MatchesBip143Example) {
+  const auto bytes =
+      "0100000002fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f0000000000eeffffff"
+      "ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a0100000000ffffffff02202cb206"
+      "000000001976a9148280b37df378db99f66f85c95a783a76ac7a6d5988ac9093510d000000001976a9143bde42db"
+      "ee7e4dbe6a21b2d50ce2f0167faa815988ac11000000"_bytes;
+  encoding::Reader reader{bytes};
+  Transaction tx;
+  tx.Deserialize(reader);
+  AddWitnesses(tx);
+
+  const PrecomputedTransactionData precomputed{tx, {}};
+  ASSERT_TRUE(precomputed.segwit_ready);
+  EXPECT_FALSE(precomputed.taproot_ready);
+  EXPECT_EQ(precomputed.hash_prevouts, "96b827c8483d4e9b96712b6713a7b68d6e8003a781feba36c31143470b4efd37"_bytes);
+  EXPECT_EQ(precomputed.hash_sequence, "52b0a642eea2fb7ae638c36f6252b6750293dbe574a806984b8e4d8548339a3b"_bytes);
+  EXPECT_EQ(precomputed.hash_outputs, "863ef3e1a92afbfdb97f31ad0fc7683ee943e9abcf2501590ff8f6551f47e5e5"_bytes);
+
+  const auto script_code = "76a9141d0f172a0ecb48aee1be1f2687d2963ae33f71a188ac"_bytes;
+  EXPECT_EQ(SegwitV0Sighash(tx, precomputed, 1, script_code, 600'000'000, sighash::kAll),
+            "c37af31116d1b27caf68aae9e3ac82f1477929014d5b917657d0eb49478cb670"_bytes);
+}
+
+// Expected values are from an independent implementation of the legacy signature hash.
+TEST(SighashTest, LegacyMatchesReference) {
+  Transaction tx;
+  tx.SetVersion(1);
+  tx.ResizeInputs(3);
+  for (int i = 0; i < 3; ++i) {
+    tx.Input(i).previous_output.hash.fill(0x31 + i);
+    tx.Input(i).previous_output.index = i;
+    tx.Input(i).sequence = i == 2 ? 0xfffffffe : 0xffffffff;
+  }
+  tx.ResizeOutputs(1);
+  tx.Output(0).value = 55'000;
+  tx.SetPkScript(0, Repeat({0x00, 0x14}, 0x44, 20));
+  tx.SetLockTime(0);
+
+  // OP_CODESEPARATORs are removed from the script code.
+  const auto separated = "ab51ab52"_bytes;
+  EXPECT_EQ(LegacySighash(tx, 0, separated, sighash::kNone),
+            "b12770b3c026b2a4f738d8ce00b624b572169c6702f7040487bc3deb4949540f"_bytes);
+  auto p2pkh = Repeat({0x76, 0xa9, 0x14}, 0x55, 20);
+  p2pkh.insert(p2pkh.end(), {0x88, 0xac});
+  EXPECT_EQ(LegacySighash(tx, 0, p2pkh, sighash::kSingle | sighash::kAnyoneCanPay),
+            "115ff4cf091a36593289433aa37cdbcf2b544400e714f5ae65ab4c273f3f8f1f"_bytes);
+  // SIGHASH_SINGLE without a corresponding output signs the number one.
+  crypto::bytes32_t one{};
+  one[0] = 1;
+  EXPECT_EQ(LegacySighash(tx, 2, separated, sighash::kSingle), one);
+}
+
+class TaprootSighashTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    tx_.SetVersion(2);
+    tx_.ResizeInputs(2);
+    std::fill(tx_.Input(0).previous_output.hash.begin(), tx_.Input(0).previous_output.hash.end(), 0x11);
+    tx_.Input(0).previous_output.index = 0;
+    tx_.Input(0).sequence = 0xfffffffd;
+    std::fill(tx_.Input(1).previous_output.hash.begin(), tx_.Input(1).previous_output.hash.end(), 0x22);
+    tx_.Input(1).previous_output.index = 1;
+    tx_.Input(1).sequence = 0xffffffff;
+    tx_.ResizeOutputs(2);
+    tx_.Output(0).value = 1000;
+    tx_.SetPkScript(0, Repeat({0x51, 0x20}, 0xCC, 32));
+    tx_.Output(1).value = 2000;
+    tx_.SetPkScript(1, Repeat({0x00, 0x14}, 0xDD, 20));
+    tx_.SetLockTime(500'000);
+    AddWitnesses(tx_);
+    spent_ = {{5000, taproot_script_}, {7000, segwit_script_}};
+  }
+
+  Transaction tx_;
+  const std::vector<uint8_t> taproot_script_ = Repeat({0x51, 0x20}, 0xAA, 32);
+  const std::vector<uint8_t> segwit_script_ = Repeat({0x00, 0x14}, 0xBB, 20);
+  std::vector<SpentOutput> spent_;
+};
+
+// Expected values are from an independent implementation of the BIP341 signature message.
+TEST_F(TaprootSighashTest, MatchesReference) {
+  const PrecomputedTransactionData precomputed{tx_, spent_};
+  ASSERT_TRUE(precomputed.taproot_ready);
+
+  EXPECT_EQ(TaprootSighash(tx_, precomputed, 0, spent_[0], sighash::kDefault),
+            "38dfa592f02d3269153058ca396bff192e1d7ffe68e4e1d6001f5c4e182828f4"_bytes);
+  EXPECT_EQ(TaprootSighash(tx_, precomputed, 1, spent_[1], sighash::kAnyoneCanPay | sighash::kSingle),
+            "2491b9b9170b29aeeeca8cce972c0a630e8c084ffaccc88400ea4756336a81ba"_bytes);
+
+  const auto annex = "50010203"_bytes;
+  TapscriptExtension extension;
+  extension.tapleaf_hash.fill(0xEE);
+  EXPECT_EQ(TaprootSighash(tx_, precomputed, 0, spent_[0], sighash::kAll, annex, &extension),
+            "e78f45afd7b82a033adfaa4a467c53d41a3f5c459217cc3f8c0a9aacaddd2f33"_bytes);
+
+  // The same precomputed data serves the transaction's segwit v0 input.
+  const auto script_code = Repeat({0x76, 0xa9, 0x14}, 0xBB, 20);
+  auto p2pkh = script_code;
+  p2pkh.insert(p2pkh.end(), {0x88, 0xac});
+  EXPECT_EQ(SegwitV0Sighash(tx_, precomputed, 1, p2pkh, 7000, sighash::kAll),
+            "d6998faf96369ef1e2fd4670560e5b7df7dd130c55e985ab8fa4e6b958323552"_bytes);
+}
+
+TEST_F(TaprootSighashTest, RejectsInvalidHashTypes) {
+  const PrecomputedTransactionData precomputed{tx_, spent_};
+  EXPECT_FALSE(TaprootSighash(tx_, precomputed, 0, spent_[0], 0x04));
+  EXPECT_FALSE(TaprootSighash(tx_, precomputed, 0, spent_[0], 0x80));
+  EXPECT_FALSE(TaprootSighash(tx_, precomputed, 0, spent_[0], 0x84));
+
+  // SIGHASH_SINGLE needs an output at the input's index.
+  tx_.ResizeOutputs(1);
+  EXPECT_FALSE(TaprootSighash(tx_, precomputed, 1, spent_[1], sighash::kSingle));
+  EXPECT_TRUE(TaprootSighash(tx_, precomputed, 0, spent_[0], sighash::kSingle));
+}
+
+TEST_F(TaprootSighashTest, ComputesOnlyWhatIsNeeded) {
+  // Without a Taproot spent output, only the segwit v0 fields are computed.
+  spent_[0].pk_script = segwit_script_;
+  const PrecomputedTransactionData segwit{tx_, spent_};
+  EXPECT_TRUE(segwit.segwit_ready);
+  EXPECT_FALSE(segwit.taproot_ready);
+
+  // Without witnesses, nothing is computed.
+  tx_.ResizeWitnesses(0);
+  const PrecomputedTransactionData none{tx_, spent_};
+  EXPECT_FALSE(none.segwit_ready);
+}
+
+TEST_F(TaprootSighashTest, LazyDataMatchesEager) {
+  const PrecomputedTransactionData eager{tx_, spent_};
+  const LazyPrecomputedTransactionData lazy{tx_, spent_};
+  const PrecomputedTransactionData& data = lazy.Get();
+  EXPECT_EQ(&lazy.Get(), &data);  // Built once.
+  EXPECT_TRUE(data.taproot_ready);
+  EXPECT_EQ(data.sha_scriptpubkeys, eager.sha_scriptpubkeys);
+  EXPECT_EQ(data.hash_outputs, eager.hash_outputs);
+}
+
+}  // namespace
+}  // namespace hornet::protocol::script
@@ -0,0 +1,211 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetlib/protocol/script/templates.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hornetlib/crypto/hash.h"
+#include "hornetlib/protocol/script/verify.h"
+#include "hornetlib/protocol/script/writer.h"
+#include "hornetlib/protocol/transaction.h"
+
+namespace hornet::protocol::script {
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+// A deterministic stand-in for a signature: a hash of everything the signature check depends on.
+Bytes SignEcdsa(runtime::Version version, lang::Bytes public_key, lang::Bytes script_code) {
+  Bytes message = {uint8_t(version)};
+  message.insert(message.end(), public_key.begin(), public_key.end());
+  message.insert(message.end(), script_code.begin(), script_code.end());
+  const auto hash = crypto::Sha256(message);
+  Bytes signature{hash.begin(), hash.end()};
+  signature.push_back(sighash::kAll);
+  return signature;
+}
+
+Bytes SignSchnorr(lang::Bytes public_key, std::optional<lang::Bytes> annex) {
+  Bytes message{public_key.begin(), public_key.end()};
+  if (annex) message.insert(message.end(), annex->begin(), annex->end());
+  const auto hash = crypto::Sha256(message);
+  Bytes signature{hash.begin(), hash.end()};
+  signature.insert(signature.end(), hash.begin(), hash.end());
+  return signature;
+}
+
+// Accepts exactly the signatures made by the functions above.
+class FakeChecker : public runtime::SignatureChecker {
+ public:
+  bool CheckEcdsa(const runtime::Environment& env, lang::Bytes signature, lang::Bytes public_key,
+                  lang::Bytes script_code) const override {
+    return std::ranges::equal(signature, SignEcdsa(env.version, public_key, script_code));
+  }
+  bool CheckSchnorr(const runtime::Environment&, lang::Bytes signature, lang::Bytes public_key,
+                    std::optional<lang::Bytes> annex) const override {
+    return std::ranges::equal(signature, SignSchnorr(public_key, annex));
+  }
+};
+
+struct Spend {
+  std::string name;
+  Bytes sig_script;
+  Bytes pubkey_script;
+  std::vector<Bytes> witness;
+};
+
+Bytes Concat(std::initializer_list<uint8_t> prefix, lang::Bytes data, std::initializer_list<uint8_t> suffix = {}) {
+  Bytes bytes{prefix};
+  bytes.insert(bytes.end(), data.begin(), data.end());
+  bytes.insert(bytes.end(), suffix);
+  return bytes;
+}
+
+Bytes Push(std::initializer_list<lang::Bytes> items) {
+  Writer writer;
+  for (const lang::Bytes item : items) writer.PushData(item);
+  return writer.Release();
+}
+
+Bytes PayToPubKeyHash(lang::Bytes hash) {
+  return Concat({0x76, 0xa9, 0x14}, hash, {0x88, 0xac});
+}
+
+// Builds standard spends together with variations of each that are invalid or non-standard.
+std::vector<Spend> MakeSpends() {
+  const Bytes key(33, 0x02), other_key(33, 0x03);
+  const auto hash = crypto::Hash160(key);
+  const Bytes zero_hash(20, 0x00);
+  std::vector<Spend> spends;
+
+  // P2PKH.
+  const Bytes p2pkh = PayToPubKeyHash(hash);
+  Bytes sig = SignEcdsa(runtime::Version::Legacy, key, p2pkh);
+  Bytes bad_sig = sig;
+  bad_sig[0] ^= 1;
+  spends.push_back({"p2pkh", Push({sig, key}), p2pkh, {}});
+  spends.push_back({"p2pkh bad sig", Push({bad_sig, key}), p2pkh, {}});
+  spends.push_back({"p2pkh wrong key", Push({sig, other_key}), p2pkh, {}});
+  spends.push_back({"p2pkh empty sig", Push({{}, key}), p2pkh, {}});
+  spends.push_back({"p2pkh extra push", Push({sig, sig, key}), p2pkh, {}});
+  spends.push_back({"p2pkh one push", Push({key}), p2pkh, {}});
+  spends.push_back({"p2pkh witness", Push({sig, key}), p2pkh, {key}});
+  Bytes truncated = Push({sig, key});
+  truncated.pop_back();
+  spends.push_back({"p2pkh truncated", truncated, p2pkh, {}});
+
+  // P2WPKH.
+  const Bytes p2wpkh = Concat({0x00, 0x14}, hash);
+  sig = SignEcdsa(runtime::Version::SegwitV0, key, PayToPubKeyHash(hash));
+  bad_sig = sig;
+  bad_sig.back() ^= 1;
+  spends.push_back({"p2wpkh", {}, p2wpkh, {sig, key}});
+  spends.push_back({"p2wpkh bad sig", {}, p2wpkh, {bad_sig, key}});
+  spends.push_back({"p2wpkh wrong key", {}, p2wpkh, {sig, other_key}});
+  spends.push_back({"p2wpkh one item", {}, p2wpkh, {key}});
+  spends.push_back({"p2wpkh three items", {}, p2wpkh, {sig, sig, key}});
+  spends.push_back({"p2wpkh sig script", Push({key}), p2wpkh, {sig, key}});
+  spends.push_back({"p2wpkh oversized item", {}, p2wpkh, {Bytes(521, 0x30), key}});
+  spends.push_back({"p2wpkh zero program", {}, Concat({0x00, 0x14}, zero_hash), {sig, key}});
+
+  // P2SH-P2WPKH.
+  const Bytes redeem = p2wpkh;
+  const Bytes p2sh = Concat({0xa9, 0x14}, crypto::Hash160(redeem), {0x87});
+  spends.push_back({"p2sh-p2wpkh", Push({redeem}), p2sh, {sig, key}});
+  spends.push_back({"p2sh-p2wpkh bad sig", Push({redeem}), p2sh, {bad_sig, key}});
+  spends.push_back({"p2sh-p2wpkh wrong key", Push({redeem}), p2sh, {sig, other_key}});
+  spends.push_back({"p2sh-p2wpkh wrong redeem", Push({redeem}), Concat({0xa9, 0x14}, hash, {0x87}), {sig, key}});
+  spends.push_back({"p2sh-p2wpkh extra push", Push({key, redeem}), p2sh, {sig, key}});
+  spends.push_back({"p2sh-p2wpkh no witness", Push({redeem}), p2sh, {}});
+  const Bytes zero_redeem = Concat({0x00, 0x14}, zero_hash);
+  spends.push_back({"p2sh-p2wpkh zero program", Push({zero_redeem}),
+                    Concat({0xa9, 0x14}, crypto::Hash160(zero_redeem), {0x87}), {sig, key}});
+
+  // P2TR key path.
+  const Bytes x_only(32, 0x09);
+  const Bytes p2tr = Concat({0x51, 0x20}, x_only);
+  const Bytes annex = {0x50, 0x01, 0x02};
+  const Bytes schnorr = SignSchnorr(x_only, std::nullopt);
+  const Bytes schnorr_annex = SignSchnorr(x_only, annex);
+  Bytes bad_schnorr = schnorr;
+  bad_schnorr[5] ^= 1;
+  spends.push_back({"p2tr", {}, p2tr, {schnorr}});
+  spends.push_back({"p2tr annex", {}, p2tr, {schnorr_annex, annex}});
+  spends.push_back({"p2tr annex unsigned", {}, p2tr, {schnorr, annex}});
+  spends.push_back({"p2tr bad sig", {}, p2tr, {bad_schnorr}});
+  spends.push_back({"p2tr empty witness", {}, p2tr, {}});
+  spends.push_back({"p2tr sig script", Push({key}), p2tr, {schnorr}});
+  spends.push_back({"p2tr zero program", {}, Concat({0x51, 0x20}, Bytes(32, 0x00)), {schnorr}});
+  return spends;
+}
+
+// Sets up a one-input transaction carrying the spend's signature script and witness.
+void SetInput(Transaction& tx, const Spend& spend) {
+  tx.ResizeInputs(1);
+  tx.SetSignatureScript(0, spend.sig_script);
+  tx.ResizeWitnesses(1);
+  tx.ResizeComponents(0, std::ssize(spend.witness));
+  for (int i = 0; i < std::ssize(spend.witness); ++i) tx.SetWitnessScript(0, i, spend.witness[i]);
+}
+
+TEST(ScriptTemplatesTest, ClassifiesStandardSpends) {
+  constexpr uint32_t kAllFlags = kVerifyP2SH | kVerifyWitness | kVerifyTaproot;
+  const std::vector<std::pair<std::string, Template>> expected = {
+      {"p2pkh", Template::PayToPubKeyHash},
+      {"p2pkh extra push", Template::NonStandard},
+      {"p2pkh empty sig", Template::NonStandard},
+      {"p2pkh witness", Template::NonStandard},
+      {"p2wpkh", Template::PayToWitnessPubKeyHash},
+      {"p2wpkh sig script", Template::NonStandard},
+      {"p2sh-p2wpkh", Template::PayToScriptHashWitnessPubKeyHash},
+      {"p2sh-p2wpkh extra push", Template::NonStandard},
+      {"p2tr", Template::PayToTaprootKeyPath},
+      {"p2tr annex", Template::PayToTaprootKeyPath},
+      {"p2tr empty witness", Template::NonStandard},
+  };
+  const auto spends = MakeSpends();
+  for (const auto& [name, type] : expected) {
+    const auto it = std::ranges::find(spends, name, &Spend::name);
+    ASSERT_NE(it, spends.end()) << name;
+    Transaction tx;
+    SetInput(tx, *it);
+    EXPECT_EQ(Classify(it->sig_script, it->pubkey_script, {tx, 0}, kAllFlags), type) << name;
+  }
+}
+
+// The fast paths must reproduce the interpreter's outcome, including the error, for every spend
+// under every combination of soft forks.
+TEST(ScriptTemplatesTest, MatchesInterpreter) {
+  const FakeChecker checker;
+  runtime::Environment env;
+  env.checker = &checker;
+  int fast_paths = 0, successes = 0;
+  for (const Spend& spend : MakeSpends()) {
+    Transaction tx;
+    SetInput(tx, spend);
+    const WitnessView witness{tx, 0};
+    for (const uint32_t flags : std::initializer_list<uint32_t>{
+             kVerifyNone, kVerifyP2SH, kVerifyP2SH | kVerifyWitness, kVerifyP2SH | kVerifyWitness | kVerifyTaproot}) {
+      const auto interpreted = VerifyScript(spend.sig_script, spend.pubkey_script, witness, flags, env);
+      const auto routed = VerifyInput(spend.sig_script, spend.pubkey_script, witness, flags, env);
+      EXPECT_EQ(routed, interpreted) << spend.name << " with flags " << flags;
+      fast_paths += Classify(spend.sig_script, spend.pubkey_script, witness, flags) != Template::NonStandard;
+      successes += !interpreted.has_value();
+    }
+  }
+  // Guards against a vacuous comparison.
+  EXPECT_GT(fast_paths, 30);
+  EXPECT_GT(successes, 10);
+}
+
+}  // namespace
+}  // namespace hornet::protocol::script
@@ -0,0 +1,232 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetlib/protocol/script/verify.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hornetlib/crypto/hash.h"
+#include "hornetlib/crypto/secp256k1/signature_cache.h"
+#include "hornetlib/protocol/script/checker.h"
+#include "hornetlib/protocol/script/processor.h"
+#include "hornetlib/protocol/script/sighash.h"
+#include "hornetlib/protocol/script/templates.h"
+#include "hornetlib/protocol/script/writer.h"
+#include "hornetlib/protocol/transaction.h"
+#include "hornetlib/util/hex.h"
+
+namespace hornet::protocol::script {
+namespace {
+
+using lang::Op;
+
+constexpr uint32_t kAllFlags = kVerifyP2SH | kVerifyWitness | kVerifyTaproot;
+
+std::vector<uint8_t> PayToPubKeyHash(std::span<const uint8_t> public_key) {
+  const auto hash = crypto::Hash160(public_key);
+  Writer writer;
+  writer.Then(Op::Duplicate).Then(Op::Hash160).PushData(hash).Then(Op::EqualVerify).Then(Op::CheckSig);
+  return writer.Release();
+}
+
+// A transaction spending P2PKH, P2WPKH and P2TR key-path outputs, with signatures made by an
+// independent implementation of ECDSA, BIP340 and the signature hashes.
+class VerifyTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    tx_.SetVersion(1);
+    tx_.ResizeInputs(3);
+    for (int i = 0; i < 3; ++i) {
+      tx_.Input(i).previous_output.hash.fill(0x31 + i);
+      tx_.Input(i).previous_output.index = i;
+      tx_.Input(i).sequence = i == 2 ? 0xfffffffe : 0xffffffff;
+    }
+    tx_.ResizeOutputs(1);
+    tx_.Output(0).value = 55'000;
+    std::vector<uint8_t> output_script = {0x00, 0x14};
+    output_script.insert(output_script.end(), 20, 0x44);
+    tx_.SetPkScript(0, output_script);
+    tx_.SetLockTime(0);
+
+    Writer sig_script;
+    sig_script.PushData(kSignature0).PushData(kPublicKeyA);
+    tx_.SetSignatureScript(0, sig_script);
+    tx_.ResizeWitnesses(3);
+    tx_.ResizeComponents(1, 2);
+    tx_.SetWitnessScript(1, 0, kSignature1);
+    tx_.SetWitnessScript(1, 1, kPublicKeyB);
+    tx_.ResizeComponents(2, 1);
+    tx_.SetWitnessScript(2, 0, kSignature2);
+
+    scripts_[0] = PayToPubKeyHash(kPublicKeyA);
+    const auto hash_b = crypto::Hash160(kPublicKeyB);
+    scripts_[1] = {0x00, 0x14};
+    scripts_[1].insert(scripts_[1].end(), hash_b.begin(), hash_b.end());
+    scripts_[2] = {0x51, 0x20};
+    scripts_[2].insert(scripts_[2].end(), kPublicKeyC.begin(), kPublicKeyC.end());
+    spent_ = {{10'000, scripts_[0]}, {20'000, scripts_[1]}, {30'000, scripts_[2]}};
+  }
+
+  std::optional<lang::Error> Verify(int input, bool fast, uint32_t flags = kAllFlags) {
+    const LazyPrecomputedTransactionData precomputed{tx_, spent_};
+    const TransactionSignatureChecker checker{tx_, input, spent_[input], precomputed};
+    runtime::Environment env;
+    env.checker = &checker;
+    env.signature_cache = cache_;
+    const WitnessView witness{tx_, input};
+    return fast ? VerifyInput(tx_.SignatureScript(input), spent_[input].pk_script, witness, flags, env)
+                : VerifyScript(tx_.SignatureScript(input), spent_[input].pk_script, witness, flags, env);
+  }
+
+  static constexpr auto kPublicKeyA = "027592aab5d43618dda13fba71e3993cd7517a712d3da49664c06ee1bd3d1f70af"_bytes;
+  static constexpr auto kPublicKeyB = "02e5740e63bad28081ed7cf654dd6c19029ca03382fc05ab5f5dda81f2c55b845b"_bytes;
+  static constexpr auto kPublicKeyC = "ec6d499aefd540e90357f1004a136049d1f7df5ad99c44c46e3ed4169e40acb6"_bytes;
+  static constexpr auto kSignature0 =
+      "304402203ef30130654689a64c864d6dd38760481c55fc525e2c6c7084e2d2d3d4d51be902200b5a76d70d70296d3973a20eb8373e"
+      "dc141eaa43d4fb0cc88f5c1656f4cbac4f01"_bytes;
+  static constexpr auto kSignature1 =
+      "304402206a6e1dc6f203f7fdd97965892301e5fb995a37318c410543835f0edcd3456c490220244aa495a8eca74e0a67ed582157ff"
+      "69fc919fd74e631e2f3ce63ced7945684101"_bytes;
+  static constexpr auto kSignature2 =
+      "8e7df8c0de88903e71224c973a8ca65a0923f872841f2dccbcd69e64b1dce1ebd2272c4d499b06678b7c2ba1154c30c0fccdae010c"
+      "08b4d208f9123290e9c628"_bytes;
+
+  Transaction tx_;
+  std::array<std::vector<uint8_t>, 3> scripts_;
+  std::vector<SpentOutput> spent_;
+  crypto::secp256k1::SignatureCache* cache_ = nullptr;
+};
+
+TEST_F(VerifyTest, AcceptsValidSignatures) {
+  const WitnessView witness1{tx_, 1}, witness2{tx_, 2};
+  EXPECT_EQ(Classify(tx_.SignatureScript(0), scripts_[0], {tx_, 0}, kAllFlags), Template::PayToPubKeyHash);
+  EXPECT_EQ(Classify({}, scripts_[1], witness1, kAllFlags), Template::PayToWitnessPubKeyHash);
+  EXPECT_EQ(Classify({}, scripts_[2], witness2, kAllFlags), Template::PayToTaprootKeyPath);
+  for (int input = 0; input < 3; ++input) {
+    EXPECT_EQ(Verify(input, false), std::nullopt) << "input " << input;
+    EXPECT_EQ(Verify(input, true), std::nullopt) << "input " << input;
+  }
+}
+
+TEST_F(VerifyTest, RejectsInvalidSignatures) {
+  auto signature0 = std::vector<uint8_t>(kSignature0.begin(), kSignature0.end());
+  signature0[10] ^= 1;
+  Writer sig_script;
+  sig_script.PushData(signature0).PushData(kPublicKeyA);
+  tx_.SetSignatureScript(0, sig_script);
+  auto signature1 = std::vector<uint8_t>(kSignature1.begin(), kSignature1.end());
+  signature1.back() = sighash::kNone;  // Valid encoding, but a different signature hash.
+  tx_.SetWitnessScript(1, 0, signature1);
+  auto signature2 = std::vector<uint8_t>(kSignature2.begin(), kSignature2.end());
+  signature2.push_back(sighash::kAll);  // Valid encoding, but a different signature hash.
+  tx_.SetWitnessScript(2, 0, signature2);
+
+  for (const bool fast : {false, true}) {
+    EXPECT_EQ(Verify(0, fast), lang::Error::EvalFalse);
+    EXPECT_EQ(Verify(1, fast), lang::Error::EvalFalse);
+    EXPECT_EQ(Verify(2, fast), lang::Error::SchnorrSig);
+  }
+}
+
+TEST_F(VerifyTest, FailedCheckSigPushesEmptyVector) {
+  auto signature0 = std::vector<uint8_t>(kSignature0.begin(), kSignature0.end());
+  signature0[10] ^= 1;
+  Writer sig_script;
+  sig_script.PushData(signature0).PushData(kPublicKeyA);
+  tx_.SetSignatureScript(0, sig_script);
+  // The result of the failed OP_CHECKSIG must compare equal to the empty vector, not to {0x00}.
+  Writer pk_script;
+  pk_script.Then(Op::CheckSig).Then(Op::PushEmpty).Then(Op::Equal);
+  const auto script = pk_script.Release();
+  spent_[0].pk_script = script;
+  EXPECT_EQ(Verify(0, false), std::nullopt);
+}
+
+TEST_F(VerifyTest, RequiresStrictDerOnlyUnderBip66) {
+  // The same signature with its sequence length in long form: laxly parseable, but not strict DER.
+  std::vector<uint8_t> signature0 = {0x30, 0x81};
+  signature0.insert(signature0.end(), kSignature0.begin() + 1, kSignature0.end());
+  Writer sig_script;
+  sig_script.PushData(signature0).PushData(kPublicKeyA);
+  tx_.SetSignatureScript(0, sig_script);
+  for (const bool fast : {false, true}) {
+    EXPECT_EQ(Verify(0, fast), std::nullopt);
+    EXPECT_EQ(Verify(0, fast, kAllFlags | kVerifyDerSig), lang::Error::SigDer);
+  }
+}
+
+TEST_F(VerifyTest, AcceptsLongLaxDerSignatures) {
+  // The same signature with its sequence length padded to a four-byte long form, making it 75 bytes.
+  std::vector<uint8_t> signature0 = {0x30, 0x84, 0x00, 0x00, 0x00};
+  signature0.insert(signature0.end(), kSignature0.begin() + 1, kSignature0.end());
+  ASSERT_GE(signature0.size(), 73);
+  Writer sig_script;
+  sig_script.PushData(signature0).PushData(kPublicKeyA);
+  tx_.SetSignatureScript(0, sig_script);
+  crypto::secp256k1::SignatureCache cache{1 << 12};
+  cache_ = &cache;
+  for (const bool fast : {false, true}) {
+    EXPECT_EQ(Verify(0, fast), std::nullopt);  // The second pass hits the cache.
+    EXPECT_EQ(Verify(0, fast, kAllFlags | kVerifyDerSig), lang::Error::SigDer);
+  }
+  EXPECT_EQ(cache.GetStats().hits, 1);
+}
+
+TEST(ScriptVerifyTest, ExecutesHashAndVerifyOpcodes) {
+  const auto data = "0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"_bytes;
+  Writer match;
+  match.PushData(data).Then(Op::Hash160).PushData(crypto::Hash160(data)).Then(Op::EqualVerify);
+  match.PushInt(1).Then(Op::Verify).PushInt(7);
+  Processor processor{match};
+  EXPECT_EQ(processor.Run(), true);
+  EXPECT_EQ(processor.TryPeekInt(), 7);
+
+  Writer mismatch;
+  mismatch.PushData(data).Then(Op::Hash160).PushData(data).Then(Op::EqualVerify);
+  EXPECT_EQ(Processor{mismatch}.Run(), lang::Error::EqualVerify);
+
+  Writer verify_false;
+  verify_false.PushInt(0).Then(Op::Verify);
+  EXPECT_EQ(Processor{verify_false}.Run(), lang::Error::Verify);
+}
+
+TEST(ScriptVerifyTest, ParsesWitnessPrograms) {
+  std::vector<uint8_t> script = {0x00, 0x14};
+  script.resize(22, 0xAB);
+  auto program = ParseWitnessProgram(script);
+  ASSERT_TRUE(program);
+  EXPECT_EQ(program->version, 0);
+  EXPECT_EQ(program->program.size(), 20u);
+
+  script = {0x60, 0x02, 0x01, 0x02};
+  program = ParseWitnessProgram(script);
+  ASSERT_TRUE(program);
+  EXPECT_EQ(program->version, 16);
+
+  EXPECT_FALSE(ParseWitnessProgram(std::vector<uint8_t>{0x00, 0x01, 0xAB}));        // Too short.
+  EXPECT_FALSE(ParseWitnessProgram(std::vector<uint8_t>{0x4f, 0x02, 0x01, 0x02}));  // Not a version.
+  EXPECT_FALSE(ParseWitnessProgram(std::vector<uint8_t>{0x51, 0x03, 0x01, 0x02}));  // Bad push size.
+}
+
+TEST(ScriptVerifyTest, FindAndDeleteMatchesAtInstructionBoundaries) {
+  const auto signature = "300602010102010101"_bytes;
+  Writer script;
+  script.PushData(signature).Then(Op::CheckSig).PushData(signature).PushData(signature).Then(Op::Verify);
+  Writer expected;
+  expected.Then(Op::CheckSig).Then(Op::Verify);
+  EXPECT_EQ(detail::FindAndDelete(script, signature), expected.Release());
+
+  // The pattern inside a larger push is not at an instruction boundary.
+  Writer outer;
+  outer.PushData(Writer{}.PushData(signature).Release());
+  const std::vector<uint8_t> unchanged = outer.Release();
+  EXPECT_EQ(detail::FindAndDelete(unchanged, signature), unchanged);
+}
+
+}  // namespace
+}  // namespace hornet::protocol::script
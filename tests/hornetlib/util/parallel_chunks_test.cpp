@@ -0,0 +1,63 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetlib/util/parallel_chunks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace hornet::util {
+namespace {
+
+// More chunks than hardware threads, so that the pool is exercised on any machine.
+constexpr int kChunks = 8;
+
+TEST(ParallelChunksTest, CoversEachItemOnce) {
+  std::vector<std::atomic<int>> visits(10'000);
+  ParallelChunks(std::ssize(visits), 100, [&](int, int begin, int end) {
+    for (int i = begin; i < end; ++i) ++visits[i];
+  }, kChunks);
+  EXPECT_TRUE(std::ranges::all_of(visits, [](const auto& v) { return v == 1; }));
+}
+
+TEST(ParallelChunksTest, NestedCallsComplete) {
+  // Every pool thread may be waiting on an inner call, which its caller then runs itself.
+  std::atomic<int> total = 0;
+  ParallelChunks(4 * kChunks, 1, [&](int, int, int) {
+    ParallelChunks(64, 1, [&](int, int begin, int end) { total += end - begin; }, kChunks);
+  }, 4 * kChunks);
+  EXPECT_EQ(total, 4 * kChunks * 64);
+}
+
+TEST(ParallelChunksTest, RethrowsExceptions) {
+  std::atomic<int> completed = 0;
+  EXPECT_THROW(ParallelChunks(1'000, 10, [&](int chunk, int, int) {
+    if (chunk == 1) throw std::runtime_error("bad");
+    ++completed;
+  }, kChunks), std::runtime_error);
+  EXPECT_EQ(completed, kChunks - 1);
+}
+
+TEST(ParallelChunksTest, SortsAcrossChunks) {
+  std::vector<int> values(100'003);
+  std::mt19937 rng{7};
+  for (int& value : values) value = std::uniform_int_distribution<int>{}(rng);
+  std::vector<int> expected = values;
+  std::sort(expected.begin(), expected.end());
+  ParallelSort(values.begin(), values.end(), 1'000, kChunks);
+  EXPECT_EQ(values, expected);
+}
+
+TEST(ParallelChunksTest, SumsInParallel) {
+  const std::vector<int> values = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  EXPECT_EQ(ParallelSum<int>(values, 100, [](int value) { return value * value; }), 485);
+}
+
+}  // namespace
+}  // namespace hornet::util
@@ -0,0 +1,40 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetlib/util/worker_pool.h"
+
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace hornet::util {
+namespace {
+
+TEST(WorkerPoolTest, ReturnsResultsThroughFutures) {
+  WorkerPool pool{3};
+  EXPECT_EQ(pool.ThreadCount(), 3);
+  std::vector<std::future<int>> futures;
+  for (int i = 0; i < 100; ++i) futures.push_back(pool.Submit([i] { return i * i; }));
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(futures[i].get(), i * i);
+}
+
+TEST(WorkerPoolTest, PropagatesExceptions) {
+  WorkerPool pool{1};
+  auto future = pool.Submit([]() -> int { throw std::runtime_error("bad"); });
+  EXPECT_THROW(future.get(), std::runtime_error);
+  EXPECT_EQ(pool.Submit([] { return 7; }).get(), 7);
+}
+
+TEST(WorkerPoolTest, AcceptsMoveOnlyJobs) {
+  WorkerPool pool{2};
+  auto value = std::make_unique<int>(42);
+  auto future = pool.Submit([value = std::move(value)] { return *value; });
+  EXPECT_EQ(future.get(), 42);
+}
+
+}  // namespace
+}  // namespace hornet::util
@@ -0,0 +1,101 @@
+// Copyright 2025 Toby Sharp
+//
+// This file is part of the Hornet Node project. All rights reserved.
+// For licensing or usage inquiries, contact: ask@hornetnode.com.
+#include "hornetnodelib/sync/assume_valid.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "hornetlib/data/header_timechain.h"
+#include "hornetlib/model/header_context.h"
+#include "hornetlib/protocol/block_header.h"
+#include "hornetlib/protocol/constants.h"
+
+namespace hornet::node::sync {
+namespace {
+
+using model::HeaderContext;
+
+HeaderContext MakeChild(const HeaderContext& parent, uint32_t nonce,
+                        uint32_t bits = protocol::kMaxCompactTarget) {
+  protocol::BlockHeader header{};
+  header.SetVersion(1);
+  header.SetPreviousBlockHash(parent.hash);
+  header.SetCompactTarget(bits);
+  header.SetNonce(nonce);
+  return parent.Extend(header);
+}
+
+// A header chain in which every block has the minimum work.
+class AssumeValidTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    protocol::BlockHeader genesis{};
+    genesis.SetVersion(1);
+    genesis.SetCompactTarget(protocol::kMaxCompactTarget);
+    chain_.push_back(HeaderContext::Genesis(genesis));
+    headers_.Add(chain_.back());
+    Extend(10);
+  }
+
+  void Extend(int count) {
+    for (int i = 0; i < count; ++i) {
+      chain_.push_back(MakeChild(chain_.back(), uint32_t(chain_.size())));
+      headers_.Add(chain_.back());
+    }
+  }
+
+  bool Covers(AssumeValid& assume_valid, int height) {
+    return assume_valid.Covers(headers_, height, chain_[height].hash);
+  }
+
+  data::HeaderTimechain headers_;
+  std::vector<HeaderContext> chain_;
+};
+
+TEST_F(AssumeValidTest, CoversBuriedAncestors) {
+  // The tip at height 10 has four blocks' worth of work above the assumed-valid block at height 6.
+  AssumeValid assume_valid{chain_[6].hash, 4};
+  for (int height = 0; height <= 6; ++height) EXPECT_TRUE(Covers(assume_valid, height)) << height;
+  EXPECT_FALSE(Covers(assume_valid, 7));
+  EXPECT_FALSE(assume_valid.Covers(headers_, 3, chain_[4].hash));
+}
+
+TEST_F(AssumeValidTest, RequiresBurial) {
+  AssumeValid assume_valid{chain_[6].hash, 5};
+  EXPECT_FALSE(Covers(assume_valid, 3));
+  Extend(1);
+  EXPECT_TRUE(Covers(assume_valid, 3));
+}
+
+TEST_F(AssumeValidTest, FindsBlockOnceHeadersArrive) {
+  const auto parent = chain_.back();
+  const auto future = MakeChild(parent, 1000);
+  AssumeValid assume_valid{future.hash, 2};
+  EXPECT_FALSE(Covers(assume_valid, 3));
+
+  chain_.push_back(future);
+  headers_.Add(future);
+  Extend(2);
+  EXPECT_TRUE(Covers(assume_valid, 3));
+  EXPECT_TRUE(Covers(assume_valid, 11));
+  EXPECT_FALSE(Covers(assume_valid, 12));
+}
+
+TEST_F(AssumeValidTest, RejectsBlockOutsideBestChain) {
+  AssumeValid assume_valid{chain_[6].hash, 2};
+  EXPECT_TRUE(Covers(assume_valid, 3));
+
+  // A heavier branch from height 4 reorganizes the assumed-valid block out of the best chain.
+  const auto fork = MakeChild(chain_[4], 2000, 0x1c00ffff);
+  headers_.Add(headers_.Search(chain_[4].hash), fork);
+  headers_.Add(MakeChild(fork, 2001));
+  EXPECT_EQ(headers_.GetChainHash(5), fork.hash);
+  EXPECT_FALSE(Covers(assume_valid, 3));
+}
+
+}  // namespace
+}  // namespace hornet::node::sync
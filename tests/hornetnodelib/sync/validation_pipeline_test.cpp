@@ -59,7 +59,7 @@ struct Completions {
   }
 };
 
-consensus::Result ValidateInOrder(const std::filesystem::path& path) {
+consensus::Result ValidateInOrder(const std::filesystem::path& path, bool assumed_valid = false) {
   // Load the block data.
   const test::Blockchain data{path};
 
@@ -72,7 +72,7 @@ consensus::Result ValidateInOrder(const std::filesystem::path& path) {
 
   // Submit all validations in order and wait for drain.
   for (int height = 1; height < data.Length(); ++height)
-    pipeline.Submit(data[height], height);
+    pipeline.Submit(data[height], height, assumed_valid);
   EXPECT_TRUE(pipeline.Wait(5s));
 
   // Check that every block completed.
@@ -202,5 +202,67 @@ TEST(ValidationPipelineTest, ProcessMainnet50Blocks) {
   EXPECT_TRUE(ValidateShuffle(path));
 }
 
+TEST(ValidationPipelineTest, ResumeAfterEraseSince) {
+  const auto path = test::GetDataPath("ValidationPipelineTest_ProcessBlocks.bin");
+  if (!std::filesystem::exists(path)) GTEST_SKIP() << "Requires the ProcessBlocks test vector.";
+  const test::Blockchain data{path};
+  const auto timechain = BuildHeaderChain(data);
+  const test::TempFolder dir;
+  data::utxo::Database db(dir.Path());
+  const int resume = data.Length() / 2;
+
+  // Validates the whole chain, then rewinds the database as though the block at resume had failed.
+  {
+    Completions callback;
+    ValidationPipeline pipeline(*timechain, db, std::ref(callback));
+    for (int height = 1; height < data.Length(); ++height) pipeline.Submit(data[height], height);
+    EXPECT_TRUE(pipeline.Wait(5s));
+    EXPECT_TRUE(callback.rv);
+  }
+  db.EraseSince(resume);
+
+  // A fresh pipeline starting at the rewound height retires the remaining blocks.
+  Completions callback;
+  ValidationPipeline pipeline(*timechain, db, std::ref(callback), 8, resume);
+  for (int height = resume; height < data.Length(); ++height) pipeline.Submit(data[height], height);
+  EXPECT_TRUE(pipeline.Wait(5s));
+  EXPECT_EQ(callback.completions, data.Length() - resume);
+  EXPECT_TRUE(callback.rv);
+}
+
+TEST(ValidationPipelineTest, IgnoresDuplicateHeight) {
+  const auto path = test::GetDataPath("ValidationPipelineTest_ProcessBlocks.bin");
+  if (!std::filesystem::exists(path)) GTEST_SKIP() << "Requires the ProcessBlocks test vector.";
+  const test::Blockchain data{path};
+  const auto timechain = BuildHeaderChain(data);
+  const test::TempFolder dir;
+  data::utxo::Database db(dir.Path());
+  Completions callback;
+  ValidationPipeline pipeline(*timechain, db, std::ref(callback));
+
+  // The second block at height 2 is rejected while the first is still waiting for height 1.
+  EXPECT_TRUE(pipeline.Submit(data[2], 2));
+  EXPECT_FALSE(pipeline.Submit(data[2], 2));
+  for (int height = 1; height < data.Length(); ++height)
+    if (height != 2) EXPECT_TRUE(pipeline.Submit(data[height], height));
+  EXPECT_TRUE(pipeline.Wait(5s));
+  EXPECT_EQ(callback.completions, data.Length() - 1);
+  EXPECT_TRUE(callback.rv);
+}
+
+// Blocks assumed valid skip spend validation, but must still be structurally valid and spend
+// unspent outputs.
+TEST(ValidationPipelineTest, ProcessAssumedValid) {
+  const auto blocks = test::GetDataPath("ValidationPipelineTest_ProcessBlocks.bin");
+  const auto bad_merkle_root = test::GetDataPath("ValidationPipelineTest_ProcessInvalidMerkleRoot.bin");
+  const auto bad_utxo = test::GetDataPath("ValidationPipelineTest_ProcessInvalidUTXO.bin");
+  for (const auto& path : {blocks, bad_merkle_root, bad_utxo})
+    if (!std::filesystem::exists(path)) GTEST_SKIP() << "Requires the test vector " << path << ".";
+
+  EXPECT_TRUE(ValidateInOrder(blocks, true));
+  EXPECT_EQ(ValidateInOrder(bad_merkle_root, true), consensus::Error::Structure_BadMerkleRoot);
+  EXPECT_EQ(ValidateInOrder(bad_utxo, true), consensus::Error::Transaction_NotUnspent);
+}
+
 }  // namespace
 }  // namespace hornet::node::sync
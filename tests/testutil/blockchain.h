@@ -41,8 +41,10 @@ class Blockchain {
   const Spend& Spent(int index) const { return spent_[index]; }
   auto& Rng() const { return rng_; }
 
+  // Samples a block spending random unspent outputs. Each non-coinbase output pays to one of
+  // `scripts` distinct pubkey scripts.
   protocol::Block Sample(int max_transactions = 1'000, int max_fan_in = 2,
-                         int max_fan_out = 4) const;
+                         int max_fan_out = 4, int scripts = 1) const;
 
   static Blockchain Generate(int length, int transactions_per_block = 1'000, int max_fan_in = 2,
                              int max_fan_out = 4);
@@ -112,7 +114,8 @@ inline void Blockchain::Append(std::shared_ptr<protocol::Block> block) {
 // Add a simulated block to the chain.
 inline protocol::Block Blockchain::Sample(int max_transactions /* = 1000 */,
                                           int max_fan_in /* = 2 */,
-                                          int max_fan_out /* = 4 */) const {
+                                          int max_fan_out /* = 4 */,
+                                          int scripts /* = 1 */) const {
   constexpr int64_t kBlockReward = 50ll * 100'000'000;
   constexpr std::array<uint8_t, 24> pk_script = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
                                                  0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10,
@@ -142,6 +145,7 @@ inline protocol::Block Blockchain::Sample(int max_transactions /* = 1000 */,
 
   std::uniform_int_distribution<int> in_dist(1, std::max(1, max_fan_in));
   std::uniform_int_distribution<int> out_dist(1, std::max(1, max_fan_out));
+  std::uniform_int_distribution<int> script_dist(0, std::max(1, scripts) - 1);
 
   int total_spends = 0;
   for (int ti = 1; ti < max_transactions; ++ti) {
@@ -176,7 +180,9 @@ inline protocol::Block Blockchain::Sample(int max_transactions /* = 1000 */,
     for (int i = 0; i < tx.OutputCount(); ++i) {
       int64_t amount = total / (tx.OutputCount() - i);
       tx.Output(i).value = amount;
-      tx.SetPkScript(i, pk_script);
+      auto script = pk_script;
+      if (scripts > 1) script.back() += script_dist(rng_);
+      tx.SetPkScript(i, script);
       total -= amount;
     }
 